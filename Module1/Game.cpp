@@ -26,6 +26,7 @@
 #include "BatchRegistry.hpp" // Since we use the concrete type
 #include "MetaSerialize.hpp"
 #include <filesystem>
+#include <numeric>
 // <-
 
 namespace {
@@ -78,7 +79,7 @@ namespace eeng::dev
                     br.load_or_create_index(batches_root / "index.json");
 
                     // Wait for scan to finish
-                    scan_fut.get();
+                    ctx->thread_pool->get(scan_fut);
                     EENG_LOG(ctx.get(), "[startup] Scan done.");
 #else
                     constexpr int num_tasks = 3;
@@ -587,17 +588,13 @@ bool Game::init()
 
         // 1) Prepare N tasks and queue them
         const int numTasks = 5;
-        std::vector<std::future<int>> futures;
-        futures.reserve(numTasks);
-        for (int i = 0; i < numTasks; ++i) {
-            futures.emplace_back(
-                pool.queue_task([i] {
-                    // simulate variable work time
-                    std::this_thread::sleep_for(std::chrono::seconds(i + 1));
-                    return i * i;
-                    })
-            );
-        }
+        std::vector<int> task_ids(numTasks);
+        std::iota(task_ids.begin(), task_ids.end(), 0);
+        std::vector<std::future<int>> futures = pool.queue_bulk(task_ids, [](int i) {
+            // simulate variable work time
+            std::this_thread::sleep_for(std::chrono::seconds(i + 1));
+            return i * i;
+            });
 
         // Track which results we've already processed
         std::vector<bool> done(numTasks, false);
@@ -3,9 +3,11 @@
 
 #include "BatchRegistry.hpp"
 #include "meta/EntityMetaHelpers.hpp"
+#include "ecs/HeaderComponent.hpp"
 #include "MainThreadQueue.hpp"
 #include "EventQueue.h"
 #include "ThreadPool.hpp"
+#include "JsonStream.hpp"
 #include <fstream>
 #include <algorithm>
 
@@ -18,10 +20,12 @@ namespace eeng::detail
         std::vector<Guid> loaded_now{}; // for rollback on failure
     };
 
-    static ClosureBuildResult build_asset_closure_recursive(
-        const std::vector<Guid>& roots,
-        const std::vector<Guid>& already_in_closure,
-        const BatchId& batch_id,
+    // Loads each frontier with co_load_and_bind, then continues on `strand`
+    static CoTask<ClosureBuildResult> co_build_asset_closure(
+        std::vector<Guid> roots,
+        std::vector<Guid> already_in_closure,
+        BatchId batch_id,
+        IExecutor& strand,
         EngineContext& ctx)
     {
         ClosureBuildResult out{};
@@ -67,7 +71,8 @@ namespace eeng::detail
             if (!to_load.empty())
             {
                 std::deque<Guid> dq(to_load.begin(), to_load.end());
-                auto r = rm.load_and_bind_async(dq, batch_id, ctx).get();
+                auto r = co_await rm.co_load_and_bind(std::move(dq), batch_id, ctx);
+                co_await strand.schedule();
                 out.tr.success = out.tr.success && r.success;
 
                 if (!r.success)
@@ -108,7 +113,7 @@ namespace eeng::detail
 
         std::sort(out.closure.begin(), out.closure.end());
         out.closure.erase(std::unique(out.closure.begin(), out.closure.end()), out.closure.end());
-        return out;
+        co_return out;
     }
 }
 
@@ -160,7 +165,11 @@ namespace eeng::detail
 
 namespace
 {
-    void bind_refs_for_entities_on_main(
+    // Entities spawned per main-thread task when loading a batch
+    constexpr size_t spawn_chunk_size = 64;
+
+    // Main thread only
+    void bind_refs_for_entities(
         const std::vector<eeng::ecs::EntityRef>& entities,
         eeng::EngineContext& ctx)
     {
@@ -170,15 +179,22 @@ namespace
         if (!reg_sp)
             return;
 
+        for (const auto& er : entities)
+        {
+            if (!er.is_bound())
+                continue;
+            eeng::meta::bind_asset_refs_for_entity(er.entity, ctx);
+            eeng::meta::bind_entity_refs_for_entity(er.entity, ctx);
+        }
+    }
+
+    void bind_refs_for_entities_on_main(
+        const std::vector<eeng::ecs::EntityRef>& entities,
+        eeng::EngineContext& ctx)
+    {
         ctx.main_thread_queue->push_and_wait([&]()
             {
-                for (const auto& er : entities)
-                {
-                    if (!er.is_bound())
-                        continue;
-                    eeng::meta::bind_asset_refs_for_entity(er.entity, ctx);
-                    eeng::meta::bind_entity_refs_for_entity(er.entity, ctx);
-                }
+                bind_refs_for_entities(entities, ctx);
             });
     }
 
@@ -227,22 +243,82 @@ namespace
         enqueue_batch_event(ctx, event);
     }
 
-    bool rebind_assets_in_closure(
-        const std::vector<eeng::Guid>& closure,
-        const eeng::BatchId& batch_id,
+    CoTask<bool> co_rebind_assets_in_closure(
+        std::vector<eeng::Guid> closure,
+        eeng::BatchId batch_id,
         eeng::EngineContext& ctx)
     {
         if (closure.empty())
-            return true;
+            co_return true;
 
         std::deque<eeng::Guid> dq(closure.begin(), closure.end());
-        auto tr = ctx.resource_manager->load_and_bind_async(
+        auto tr = co_await ctx.resource_manager->co_load_and_bind(
             std::move(dq),
             batch_id,
             ctx
-        ).get();
+        );
+
+        co_return tr.success;
+    }
+
+    // Main thread only
+    nlohmann::json serialize_live_entities(
+        const std::vector<eeng::ecs::EntityRef>& live,
+        eeng::EngineContext& ctx)
+    {
+        nlohmann::json arr = nlohmann::json::array();
+
+        auto registry_sptr = ctx.entity_manager->registry_wptr().lock();
+        if (!registry_sptr) return nlohmann::json::array();
+
+        for (const auto& er : live)
+        {
+            if (!er.is_bound()) continue;
+
+            // existing meta serializer:
+            //   nlohmann::json ejson = eeng::meta::serialize_entity(er, ctx.entity_manager->registry_ptr());
+            // If only reference, adjust serialize_entity’s signature or wrap it.
+
+
+            nlohmann::json ejson = eeng::meta::serialize_entity(
+                er,
+                registry_sptr,  // <- change to your actual API
+                eeng::meta::SerializationPurpose::file
+            );
+            arr.push_back(std::move(ejson));
+        }
+
+        return arr;
+    }
+
+    bool write_batch_file(
+        const std::filesystem::path& batch_path,
+        const eeng::BatchInfo& snapshot,
+        nlohmann::json entities_json)
+    {
+        // Build final batch JSON
+        nlohmann::json j;
+        j["header"] = nlohmann::json{
+            { "id",   snapshot.id.to_string() },
+            { "name", snapshot.name }
+        };
+
+        nlohmann::json closure = nlohmann::json::array();
+        for (const auto& g : snapshot.asset_closure_hdr)
+            closure.push_back(g.to_string());
+        j["header"]["asset_closure"] = std::move(closure);
+
+        j["entities"] = std::move(entities_json);
 
-        return tr.success;
+        // Write file
+        std::ofstream f(batch_path);
+        if (!f.is_open())
+        {
+            // TODO: log error
+            return false;
+        }
+        f << j.dump(2);
+        return true;
     }
 }
 
@@ -297,28 +373,33 @@ namespace eeng
             return;
         }
 
-        nlohmann::json j; f >> j;
-        std::lock_guard lk(mtx_);
-        batches_.clear();
-        for (auto& b : j["batches"])
-        {
-            BatchInfo bi;
-            bi.id = Guid::from_string(b["id"].get<std::string>());
-            bi.name = b.value("name", bi.id.to_string());
-            bi.filename = b["filename"].get<std::string>();
-
-            if (b.contains("asset_closure_hdr"))
+        // Streamed one batch entry at a time
+        std::vector<BatchInfo> loaded;
+        for_each_json_member(f, { "batches" }, {},
+            [&](const std::string&, nlohmann::json&& b)
             {
-                for (auto& gstr : b["asset_closure_hdr"])
+                BatchInfo bi;
+                bi.id = Guid::from_string(b["id"].get<std::string>());
+                bi.name = b.value("name", bi.id.to_string());
+                bi.filename = b["filename"].get<std::string>();
+
+                if (b.contains("asset_closure_hdr"))
                 {
-                    bi.asset_closure_hdr.push_back(
-                        Guid::from_string(gstr.get<std::string>())
-                    );
+                    for (auto& gstr : b["asset_closure_hdr"])
+                    {
+                        bi.asset_closure_hdr.push_back(
+                            Guid::from_string(gstr.get<std::string>())
+                        );
+                    }
                 }
-            }
 
+                loaded.push_back(std::move(bi));
+            });
+
+        std::lock_guard lk(mtx_);
+        batches_.clear();
+        for (auto& bi : loaded)
             batches_.emplace(bi.id, std::move(bi));
-        }
         index_path_ = index_path;
     }
 
@@ -393,213 +474,62 @@ namespace eeng
     std::shared_future<TaskResult>
         BatchRegistry::queue_save_batch(const BatchId& id, EngineContext& ctx)
     {
-        return strand(ctx).submit([this, id, &ctx]() -> TaskResult {
-            TaskResult tr{};
-            tr.success = this->save_batch(id, ctx);
-            auto event = make_batch_event(BatchTaskType::Save, tr.success, id);
-            {
-                std::lock_guard lk(mtx_);
-                auto it = batches_.find(id);
-                if (it != batches_.end())
-                    fill_batch_event_from_info(event, it->second);
-            }
-            enqueue_batch_event(ctx, event);
-            return tr;
-            });
+        return spawn(co_save_batch(id, ctx));
     }
 
-    // TODO -> update index file as well?
-    bool BatchRegistry::save_batch(const eeng::BatchId& id, EngineContext& ctx)
+    std::optional<BatchInfo> BatchRegistry::snapshot_loaded(const BatchId& id) const
     {
-        // 1) Snapshot BatchInfo (and enforce "Loaded" state)
-        BatchInfo snapshot;
+        std::lock_guard lk(mtx_);
+        auto it = batches_.find(id);
+        if (it == batches_.end())
         {
-            std::lock_guard lk(mtx_);
-            auto it = batches_.find(id);
-            if (it == batches_.end())
-            {
-                // unknown batch – assert/log?
-                return false;
-            }
-
-            if (it->second.state != BatchInfo::State::Loaded)
-            {
-                // Batch is not loaded: for now, just refuse to save
-                return false;
-            }
-
-            snapshot = it->second; // shallow copy (id, name, filename, asset_closure_hdr, live)
+            // unknown batch – assert/log?
+            return std::nullopt;
         }
 
-        // 2) Main-thread: build entities JSON (later – can be empty for now)
-        nlohmann::json entities_json = nlohmann::json::array();
+        if (it->second.state != BatchInfo::State::Loaded)
+        {
+            // Batch is not loaded: for now, just refuse to save
+            return std::nullopt;
+        }
 
-        // Prel. entity data; can skip for now
-        entities_json = ctx.main_thread_queue->push_and_wait([&]() {
-            nlohmann::json arr = nlohmann::json::array();
+        return it->second; // shallow copy (id, name, filename, asset_closure_hdr, live)
+    }
 
-            auto registry_sptr = ctx.entity_manager->registry_wptr().lock();
-            if (!registry_sptr) return nlohmann::json::array();
+    // TODO -> update index file as well?
+    bool BatchRegistry::save_batch(const eeng::BatchId& id, EngineContext& ctx)
+    {
+        // 1) Snapshot BatchInfo (and enforce "Loaded" state)
+        const std::optional<BatchInfo> snapshot = snapshot_loaded(id);
+        if (!snapshot)
+            return false;
 
-            for (const auto& er : snapshot.live)
+        // 2) Main-thread: build entities JSON
+        nlohmann::json entities_json = ctx.main_thread_queue->push_and_wait([&]()
             {
-                if (!er.is_bound()) continue;
-
-                // existing meta serializer:
-                //   nlohmann::json ejson = eeng::meta::serialize_entity(er, ctx.entity_manager->registry_ptr());
-                // If only reference, adjust serialize_entity’s signature or wrap it.
-
-
-                nlohmann::json ejson = eeng::meta::serialize_entity(
-                    er,
-                    registry_sptr,  // <- change to your actual API
-                    eeng::meta::SerializationPurpose::file
-                );
-                arr.push_back(std::move(ejson));
-            }
-
-            return arr;
+                return serialize_live_entities(snapshot->live, ctx);
             });
 
-        // 3) Build final batch JSON
-        nlohmann::json j;
-        j["header"] = nlohmann::json{
-            { "id",   snapshot.id.to_string() },
-            { "name", snapshot.name }
-        };
-
-        nlohmann::json closure = nlohmann::json::array();
-        for (const auto& g : snapshot.asset_closure_hdr)
-            closure.push_back(g.to_string());
-        j["header"]["asset_closure"] = std::move(closure);
-
-        j["entities"] = std::move(entities_json);
-
-        // 4) Write file
-        auto batch_path = index_path_.parent_path() / snapshot.filename;
-        std::ofstream f(batch_path);
-        if (!f.is_open())
-        {
-            // TODO: log error
-            return false;
-        }
-        f << j.dump(2);
-        return true;
+        // 3) Build final batch JSON and write file
+        return write_batch_file(index_path_.parent_path() / snapshot->filename, *snapshot, std::move(entities_json));
     }
 
     std::shared_future<TaskResult>
         BatchRegistry::queue_load_all_async(EngineContext& ctx)
     {
-        // 1) Snapshot ids under lock
-        std::vector<BatchId> ids;
-        {
-            std::lock_guard lk(mtx_);
-            ids.reserve(batches_.size());
-            for (auto& [id, _] : batches_)
-                ids.push_back(id);
-        }
-
-        // 2) Kick a worker that will do the waiting
-        auto fut = ctx.thread_pool->queue_task([this, ids = std::move(ids), &ctx]() mutable -> TaskResult
-            {
-                TaskResult merged{};
-                merged.success = true;
-
-                // Optional: collect futures first, then wait in a second loop
-                std::vector<std::shared_future<TaskResult>> batch_futs;
-                batch_futs.reserve(ids.size());
-
-                for (const auto& id : ids)
-                {
-                    batch_futs.emplace_back(queue_load(id, ctx));  // schedules on strand
-                }
-
-                for (auto& f : batch_futs)
-                {
-                    TaskResult r = f.get();             // wait for each batch to finish
-                    merged.success &= r.success;
-                    // Can merge sub-results here as well
-                }
-
-                enqueue_batch_event(ctx, BatchTaskType::LoadAll, merged.success, BatchId{}, ids.size());
-
-                return merged;
-            });
-
-        // Wrap in shared_future so caller can copy it around
-        return fut.share();
+        return spawn(co_load_all(ctx));
     }
 
     std::shared_future<TaskResult>
         BatchRegistry::queue_unload_all_async(EngineContext& ctx)
     {
-        // Snapshot ids of batches that are not Unloaded
-        std::vector<BatchId> ids;
-        {
-            std::lock_guard lk(mtx_);
-            for (auto& [id, b] : batches_)
-            {
-                if (b.state != BatchInfo::State::Unloaded)
-                    ids.push_back(id);
-            }
-        }
-
-        auto fut = ctx.thread_pool->queue_task(
-            [this, ids = std::move(ids), &ctx]() mutable -> TaskResult
-            {
-                TaskResult merged{};
-                merged.success = true;
-
-                std::vector<std::shared_future<TaskResult>> futs;
-                futs.reserve(ids.size());
-
-                for (const auto& id : ids)
-                    futs.emplace_back(queue_unload(id, ctx));
-
-                for (auto& f : futs)
-                {
-                    TaskResult r = f.get();
-                    merged.success &= r.success;
-                }
-
-                enqueue_batch_event(ctx, BatchTaskType::UnloadAll, merged.success, BatchId{}, ids.size());
-
-                return merged;
-            });
-
-        return fut.share();
+        return spawn(co_unload_all(ctx));
     }
 
     std::shared_future<TaskResult>
         BatchRegistry::queue_save_all_async(EngineContext& ctx)
     {
-        // snapshot ids of Loaded batches
-        std::vector<BatchId> ids;
-        {
-            std::lock_guard lk(mtx_);
-            for (auto& [id, b] : batches_)
-                if (b.state == BatchInfo::State::Loaded)
-                    ids.push_back(id);
-        }
-
-        auto fut = ctx.thread_pool->queue_task([this, ids = std::move(ids), &ctx]() mutable -> TaskResult
-            {
-                TaskResult merged{};
-                merged.success = true;
-
-                for (const auto& id : ids)
-                {
-                    auto f = queue_save_batch(id, ctx);
-                    TaskResult r = f.get();
-                    merged.success &= r.success;
-                }
-
-                enqueue_batch_event(ctx, BatchTaskType::SaveAll, merged.success, BatchId{}, ids.size());
-
-                return merged;
-            });
-
-        return fut.share();
+        return spawn(co_save_all(ctx));
     }
 
     std::shared_future<ecs::EntityRef>
@@ -783,11 +713,11 @@ namespace eeng
                     if (!to_add.empty())
                     {
                         std::deque<Guid> dq(to_add.begin(), to_add.end());
-                        auto tr = ctx.resource_manager->load_and_bind_async(
+                        auto tr = ctx.thread_pool->get(ctx.resource_manager->load_and_bind_async(
                             std::move(dq),
                             B->id,
                             ctx
-                        ).get();
+                        ));
                         (void)tr; // TODO -> fold into TaskResult
                     }
                 }
@@ -923,11 +853,11 @@ namespace eeng
                     if (!to_add.empty())
                     {
                         std::deque<Guid> dq(to_add.begin(), to_add.end());
-                        auto tr = ctx.resource_manager->load_and_bind_async(
+                        auto tr = ctx.thread_pool->get(ctx.resource_manager->load_and_bind_async(
                             std::move(dq),
                             B->id,
                             ctx
-                        ).get();
+                        ));
                         (void)tr;
                     }
                 }
@@ -1026,88 +956,203 @@ namespace eeng
     // }
 
     // -------- Orchestration (serialized) --------
-
+    //
+    // Load, unload, save and closure rebuilds are coroutines that own ops_gate_
+    // from start to end. Their steps run on the strand, the main thread and,
+    // through the resource manager, the workers; waiting between steps holds
+    // no thread. The queue_ variants spawn them and return a future.
 
     std::shared_future<TaskResult> BatchRegistry::queue_load(
         const BatchId& id,
         EngineContext& ctx)
     {
-        return strand(ctx).submit([this, id, &ctx]() -> TaskResult {
-            // locked only to fetch mut ref
-            BatchInfo* B;
+        return spawn(co_load(id, ctx));
+    }
+
+    std::shared_future<TaskResult>
+        BatchRegistry::queue_unload(const BatchId& id, EngineContext& ctx)
+    {
+        return spawn(co_unload(id, ctx));
+    }
+
+    // -------- Coroutine variants --------
+
+    CoTask<TaskResult> BatchRegistry::co_load(BatchId id, EngineContext& ctx)
+    {
+        auto lock = co_await ops_gate_.lock(strand(ctx));
+
+        // locked only to fetch mut ref
+        BatchInfo* B;
+        {
+            std::lock_guard lk(mtx_);
+            B = &batches_.at(id);
+            B->state = BatchInfo::State::Queued;
+        }
+        auto res = co_await load_steps(*B, ctx);
+
+        // Batch state update on the strand
+        co_await strand(ctx).schedule();
+        BatchTaskCompletedEvent event{};
+        event.type = BatchTaskType::Load;
+        event.batch_id = id;
+        {
+            std::lock_guard lk(mtx_);
+            B->last_result = res;
+            // B->last_error_count = int(std::count_if(B->last_result.results.begin(),
+            //     B->last_result.results.end(),
+            //     [](auto& r) { return !r.success; }));
+            B->state = (res.success ? BatchInfo::State::Loaded : BatchInfo::State::Error);
+            fill_batch_event_from_info(event, *B);
+        }
+        event.success = res.success;
+        enqueue_batch_event(ctx, event);
+        co_return res;
+    }
+
+    CoTask<TaskResult> BatchRegistry::co_unload(BatchId id, EngineContext& ctx)
+    {
+        auto lock = co_await ops_gate_.lock(strand(ctx));
+
+        BatchInfo* B = nullptr;
+        BatchTaskCompletedEvent event{};
+        event.type = BatchTaskType::Unload;
+        event.batch_id = id;
+        {
+            std::lock_guard lk(mtx_);
+            auto it = batches_.find(id);
+            if (it == batches_.end())
             {
-                std::lock_guard lk(mtx_);
-                B = &batches_.at(id);
-                B->state = BatchInfo::State::Queued;
+                TaskResult tr{};
+                tr.success = false;
+                event.success = false;
+                enqueue_batch_event(ctx, event);
+                co_return tr; // unknown batch
             }
-            auto res = do_load(*B, ctx);
-            BatchTaskCompletedEvent event{};
-            event.type = BatchTaskType::Load;
-            event.batch_id = id;
+            B = &it->second;
+
+            if (B->state == BatchInfo::State::Unloaded)
             {
-                std::lock_guard lk(mtx_);
-                B->last_result = res;
-                // B->last_error_count = int(std::count_if(B->last_result.results.begin(),
-                //     B->last_result.results.end(),
-                //     [](auto& r) { return !r.success; }));
-                B->state = (res.success ? BatchInfo::State::Loaded : BatchInfo::State::Error);
+                TaskResult tr{};
+                tr.success = true; // nothing to do
                 fill_batch_event_from_info(event, *B);
+                event.success = true;
+                enqueue_batch_event(ctx, event);
+                co_return tr;
             }
-            event.success = res.success;
-            enqueue_batch_event(ctx, event);
-            return res;
-            });
+
+            B->state = BatchInfo::State::Queued;
+        }
+
+        auto res = co_await unload_steps(*B, ctx);
+
+        // Batch state update on the strand
+        co_await strand(ctx).schedule();
+        {
+            std::lock_guard lk(mtx_);
+            B->last_result = res;
+            B->state = (res.success ? BatchInfo::State::Unloaded
+                : BatchInfo::State::Error);
+            fill_batch_event_from_info(event, *B);
+        }
+
+        event.success = res.success;
+        enqueue_batch_event(ctx, event);
+        co_return res;
     }
 
-    std::shared_future<TaskResult>
-        BatchRegistry::queue_unload(const BatchId& id, EngineContext& ctx)
+    CoTask<TaskResult> BatchRegistry::co_save_batch(BatchId id, EngineContext& ctx)
+    {
+        auto lock = co_await ops_gate_.lock(strand(ctx), TaskPriority::Background);
+
+        TaskResult tr{};
+        tr.success = false;
+        if (const std::optional<BatchInfo> snapshot = snapshot_loaded(id))
+        {
+            co_await ctx.main_thread();
+            nlohmann::json entities_json = serialize_live_entities(snapshot->live, ctx);
+
+            co_await strand(ctx).schedule(TaskPriority::Background);
+            tr.success = write_batch_file(index_path_.parent_path() / snapshot->filename, *snapshot, std::move(entities_json));
+        }
+
+        auto event = make_batch_event(BatchTaskType::Save, tr.success, id);
+        {
+            std::lock_guard lk(mtx_);
+            auto it = batches_.find(id);
+            if (it != batches_.end())
+                fill_batch_event_from_info(event, it->second);
+        }
+        enqueue_batch_event(ctx, event);
+        co_return tr;
+    }
+
+    CoTask<TaskResult> BatchRegistry::co_load_all(EngineContext& ctx)
+    {
+        std::vector<BatchId> ids;
+        {
+            std::lock_guard lk(mtx_);
+            ids.reserve(batches_.size());
+            for (auto& [id, _] : batches_)
+                ids.push_back(id);
+        }
+
+        // Batch operations are exclusive anyway, so await them in turn
+        TaskResult merged{};
+        merged.success = true;
+        for (const auto& id : ids)
+        {
+            TaskResult r = co_await co_load(id, ctx);
+            merged.success &= r.success;
+        }
+
+        enqueue_batch_event(ctx, BatchTaskType::LoadAll, merged.success, BatchId{}, ids.size());
+        co_return merged;
+    }
+
+    CoTask<TaskResult> BatchRegistry::co_unload_all(EngineContext& ctx)
     {
-        return strand(ctx).submit([this, id, &ctx]() -> TaskResult
+        std::vector<BatchId> ids;
+        {
+            std::lock_guard lk(mtx_);
+            for (auto& [id, b] : batches_)
             {
-                BatchInfo* B = nullptr;
-                BatchTaskCompletedEvent event{};
-                event.type = BatchTaskType::Unload;
-                event.batch_id = id;
-                {
-                    std::lock_guard lk(mtx_);
-                    auto it = batches_.find(id);
-                    if (it == batches_.end())
-                    {
-                        TaskResult tr{};
-                        tr.success = false;
-                        event.success = false;
-                        enqueue_batch_event(ctx, event);
-                        return tr; // unknown batch
-                    }
-                    B = &it->second;
+                if (b.state != BatchInfo::State::Unloaded)
+                    ids.push_back(id);
+            }
+        }
 
-                    if (B->state == BatchInfo::State::Unloaded)
-                    {
-                        TaskResult tr{};
-                        tr.success = true; // nothing to do
-                        fill_batch_event_from_info(event, *B);
-                        event.success = true;
-                        enqueue_batch_event(ctx, event);
-                        return tr;
-                    }
+        TaskResult merged{};
+        merged.success = true;
+        for (const auto& id : ids)
+        {
+            TaskResult r = co_await co_unload(id, ctx);
+            merged.success &= r.success;
+        }
 
-                    B->state = BatchInfo::State::Queued;
-                }
+        enqueue_batch_event(ctx, BatchTaskType::UnloadAll, merged.success, BatchId{}, ids.size());
+        co_return merged;
+    }
 
-                auto res = do_unload(*B, ctx);
+    CoTask<TaskResult> BatchRegistry::co_save_all(EngineContext& ctx)
+    {
+        std::vector<BatchId> ids;
+        {
+            std::lock_guard lk(mtx_);
+            for (auto& [id, b] : batches_)
+                if (b.state == BatchInfo::State::Loaded)
+                    ids.push_back(id);
+        }
 
-                {
-                    std::lock_guard lk(mtx_);
-                    B->last_result = res;
-                    B->state = (res.success ? BatchInfo::State::Unloaded
-                        : BatchInfo::State::Error);
-                    fill_batch_event_from_info(event, *B);
-                }
+        TaskResult merged{};
+        merged.success = true;
+        for (const auto& id : ids)
+        {
+            TaskResult r = co_await co_save_batch(id, ctx);
+            merged.success &= r.success;
+        }
 
-                event.success = res.success;
-                enqueue_batch_event(ctx, event);
-                return res;
-            });
+        enqueue_batch_event(ctx, BatchTaskType::SaveAll, merged.success, BatchId{}, ids.size());
+        co_return merged;
     }
 
     std::vector<const BatchInfo*> BatchRegistry::list() const
@@ -1189,196 +1234,201 @@ namespace eeng
     std::shared_future<TaskResult>
         BatchRegistry::queue_rebuild_closure(const BatchId& id, EngineContext& ctx)
     {
-        return strand(ctx).submit([this, id, &ctx]() -> TaskResult
-            {
-                TaskResult result{};
-                result.success = true;
-                BatchTaskCompletedEvent event{};
-                event.type = BatchTaskType::RebuildClosure;
-                event.batch_id = id;
+        return spawn(co_rebuild_closure(id, ctx));
+    }
 
-                auto emit_and_return = [&]() -> TaskResult
-                    {
-                        event.success = result.success;
-                        enqueue_batch_event(ctx, event);
-                        return result;
-                    };
+    CoTask<TaskResult> BatchRegistry::co_rebuild_closure(BatchId id, EngineContext& ctx)
+    {
+        auto lock = co_await ops_gate_.lock(strand(ctx));
 
-                // 1) Snapshot batch data needed for this job
-                std::vector<ecs::EntityRef> live_snapshot;
-                std::vector<Guid> old_closure;
+        TaskResult result{};
+        result.success = true;
+        BatchTaskCompletedEvent event{};
+        event.type = BatchTaskType::RebuildClosure;
+        event.batch_id = id;
 
-                {
-                    std::lock_guard lk(mtx_);
-                    auto it = batches_.find(id);
-                    if (it == batches_.end())
-                    {
-                        result.success = false;
-                        return emit_and_return();
-                    }
+        auto emit_and_return = [&]() -> TaskResult
+            {
+                event.success = result.success;
+                enqueue_batch_event(ctx, event);
+                return result;
+            };
 
-                    if (it->second.state != BatchInfo::State::Loaded)
-                    {
-                        result.success = false;
-                        return emit_and_return();
-                    }
+        // 1) Snapshot batch data needed for this job
+        std::vector<ecs::EntityRef> live_snapshot;
+        std::vector<Guid> old_closure;
 
-                    live_snapshot = it->second.live;
-                    old_closure = it->second.asset_closure_hdr;
-                    event.batch_name = it->second.name;
-                    event.batch_count = 1;
-                }
-                event.live_entities = live_snapshot.size();
-                event.asset_closure_size = old_closure.size();
+        {
+            std::lock_guard lk(mtx_);
+            auto it = batches_.find(id);
+            if (it == batches_.end())
+            {
+                result.success = false;
+                co_return emit_and_return();
+            }
 
-                // 2) Grab registry once
-                auto registry_sp = ctx.entity_manager->registry_wptr().lock();
-                if (!registry_sp)
-                {
-                    result.success = false;
-                    return emit_and_return();
-                }
-                auto& reg = *registry_sp;
+            if (it->second.state != BatchInfo::State::Loaded)
+            {
+                result.success = false;
+                co_return emit_and_return();
+            }
 
-                auto erase_invalid_guids = [](std::vector<Guid>& v)
-                    {
-                        v.erase(
-                            std::remove_if(v.begin(), v.end(), [](const Guid& g) { return !g.valid(); }),
-                            v.end());
-                    };
+            live_snapshot = it->second.live;
+            old_closure = it->second.asset_closure_hdr;
+            event.batch_name = it->second.name;
+            event.batch_count = 1;
+        }
+        event.live_entities = live_snapshot.size();
+        event.asset_closure_size = old_closure.size();
 
-                auto sort_unique = [](std::vector<Guid>& v)
-                    {
-                        std::sort(v.begin(), v.end());
-                        v.erase(std::unique(v.begin(), v.end()), v.end());
-                    };
+        // 2) Grab registry once
+        auto registry_sp = ctx.entity_manager->registry_wptr().lock();
+        if (!registry_sp)
+        {
+            result.success = false;
+            co_return emit_and_return();
+        }
+        auto& reg = *registry_sp;
 
-                // 3) Main-thread: collect direct roots from live entities
-                std::vector<Guid> roots = ctx.main_thread_queue->push_and_wait([&]()
-                    {
-                        std::vector<Guid> guids;
+        auto erase_invalid_guids = [](std::vector<Guid>& v)
+            {
+                v.erase(
+                    std::remove_if(v.begin(), v.end(), [](const Guid& g) { return !g.valid(); }),
+                    v.end());
+            };
 
-                        for (const auto& er : live_snapshot)
-                        {
-                            if (!er.is_bound())
-                            {
-                                continue;
-                            }
+        auto sort_unique = [](std::vector<Guid>& v)
+            {
+                std::sort(v.begin(), v.end());
+                v.erase(std::unique(v.begin(), v.end()), v.end());
+            };
+
+        // 3) Main-thread: collect direct roots from live entities
+        co_await ctx.main_thread();
+        std::vector<Guid> roots;
+        for (const auto& er : live_snapshot)
+        {
+            if (!er.is_bound())
+            {
+                continue;
+            }
 
-                            auto per_entity = eeng::meta::collect_asset_guids_for_entity(er.entity, reg);
-                            guids.insert(guids.end(), per_entity.begin(), per_entity.end());
-                        }
+            auto per_entity = eeng::meta::collect_asset_guids_for_entity(er.entity, reg);
+            roots.insert(roots.end(), per_entity.begin(), per_entity.end());
+        }
+        co_await strand(ctx).schedule();
 
-                        // Null/invalid GUIDs can exist (unassigned refs). Keep them for now,
-                        // but they must be removed before commit/unload.
-                        sort_unique(guids);
-                        return guids;
-                    });
+        // Null/invalid GUIDs can exist (unassigned refs). Keep them for now,
+        // but they must be removed before commit/unload.
+        sort_unique(roots);
 
-                // 4) Build transitive closure (entity roots + asset->asset refs recursively)
-                //    Helper is expected to call rm.load_and_bind_async for newly discovered assets.
-                auto built = eeng::detail::build_asset_closure_recursive(roots, old_closure, id, ctx);
+        // 4) Build transitive closure (entity roots + asset->asset refs recursively).
+        //    Newly discovered assets are loaded and bound along the way.
+        auto built = co_await eeng::detail::co_build_asset_closure(roots, old_closure, id, strand(ctx), ctx);
 
-                result.success = result.success && built.tr.success;
-                if (!result.success)
-                {
-                    // Roll back assets that were newly bound during closure building.
-                    std::vector<Guid> rollback = std::move(built.loaded_now);
-                    erase_invalid_guids(rollback);
-                    sort_unique(rollback);
+        result.success = result.success && built.tr.success;
+        if (!result.success)
+        {
+            // Roll back assets that were newly bound during closure building.
+            std::vector<Guid> rollback = std::move(built.loaded_now);
+            erase_invalid_guids(rollback);
+            sort_unique(rollback);
 
-                    if (!rollback.empty())
-                    {
-                        std::deque<Guid> dq(rollback.begin(), rollback.end());
-                        ctx.resource_manager->unbind_and_unload_async(dq, id, ctx).get();
-                    }
+            if (!rollback.empty())
+            {
+                std::deque<Guid> dq(rollback.begin(), rollback.end());
+                co_await ctx.resource_manager->co_unbind_and_unload(std::move(dq), id, ctx);
+                co_await strand(ctx).schedule();
+            }
 
-                    return emit_and_return();
-                }
+            co_return emit_and_return();
+        }
 
-                // 5) Late cleanup: remove invalid GUIDs and dedup
-                std::vector<Guid> new_closure = std::move(built.closure);
+        // 5) Late cleanup: remove invalid GUIDs and dedup
+        std::vector<Guid> new_closure = std::move(built.closure);
 
-                erase_invalid_guids(old_closure);
-                sort_unique(old_closure);
+        erase_invalid_guids(old_closure);
+        sort_unique(old_closure);
 
-                erase_invalid_guids(new_closure);
-                sort_unique(new_closure);
+        erase_invalid_guids(new_closure);
+        sort_unique(new_closure);
 
-                // 6) Diff vs old header closure
-                std::vector<Guid> to_add;
-                std::vector<Guid> to_remove;
-                eeng::detail::diff_sets(old_closure, new_closure, to_add, to_remove);
+        // 6) Diff vs old header closure
+        std::vector<Guid> to_add;
+        std::vector<Guid> to_remove;
+        eeng::detail::diff_sets(old_closure, new_closure, to_add, to_remove);
 
-                event.has_closure_delta = true;
-                event.closure_roots = roots.size();
-                event.closure_old = old_closure.size();
-                event.closure_new = new_closure.size();
-                event.closure_added = to_add.size();
-                event.closure_removed = to_remove.size();
-                event.asset_closure_size = event.closure_new;
+        event.has_closure_delta = true;
+        event.closure_roots = roots.size();
+        event.closure_old = old_closure.size();
+        event.closure_new = new_closure.size();
+        event.closure_added = to_add.size();
+        event.closure_removed = to_remove.size();
+        event.asset_closure_size = event.closure_new;
 
-                // Debug logs (optional)
-                // for (auto& g : old_closure)  { EENG_LOG(&ctx, "[queue_rebuild_closure] old %s", g.to_string().c_str()); }
-                // for (auto& g : new_closure)  { EENG_LOG(&ctx, "[queue_rebuild_closure] new %s", g.to_string().c_str()); }
+        // Debug logs (optional)
+        // for (auto& g : old_closure)  { EENG_LOG(&ctx, "[queue_rebuild_closure] old %s", g.to_string().c_str()); }
+        // for (auto& g : new_closure)  { EENG_LOG(&ctx, "[queue_rebuild_closure] new %s", g.to_string().c_str()); }
 
-                // for (auto& g : to_add) { EENG_LOG(&ctx, "[queue_rebuild_closure] + %s", g.to_string().c_str()); }
-                // for (auto& g : to_remove) { EENG_LOG(&ctx, "[queue_rebuild_closure] - %s", g.to_string().c_str()); }
+        // for (auto& g : to_add) { EENG_LOG(&ctx, "[queue_rebuild_closure] + %s", g.to_string().c_str()); }
+        // for (auto& g : to_remove) { EENG_LOG(&ctx, "[queue_rebuild_closure] - %s", g.to_string().c_str()); }
 
-                // 7) Adjust RM leases
-                //
-                // Everything in to_add is already loaded/bound by build_asset_closure_recursive().
-                // Only unbind/unload removals here.
-                erase_invalid_guids(to_remove);
-                sort_unique(to_remove);
+        // 7) Adjust RM leases
+        //
+        // Everything in to_add is already loaded/bound by co_build_asset_closure().
+        // Only unbind/unload removals here.
+        erase_invalid_guids(to_remove);
+        sort_unique(to_remove);
 
-                if (!to_remove.empty())
-                {
-                    std::deque<Guid> dq(to_remove.begin(), to_remove.end());
-                    auto r = ctx.resource_manager->unbind_and_unload_async(dq, id, ctx).get();
-                    result.success = result.success && r.success;
-                }
+        if (!to_remove.empty())
+        {
+            std::deque<Guid> dq(to_remove.begin(), to_remove.end());
+            auto r = co_await ctx.resource_manager->co_unbind_and_unload(std::move(dq), id, ctx);
+            co_await strand(ctx).schedule();
+            result.success = result.success && r.success;
+        }
 
-                if (!result.success)
-                {
-                    // Do not commit if unload failed; keeping the old closure allows a later retry.
-                    return emit_and_return();
-                }
+        if (!result.success)
+        {
+            // Do not commit if unload failed; keeping the old closure allows a later retry.
+            co_return emit_and_return();
+        }
 
-                // 8) Rebind asset refs now that the full closure is loaded
-                const bool asset_rebind_ok = rebind_assets_in_closure(new_closure, id, ctx);
-                result.success = result.success && asset_rebind_ok;
+        // 8) Rebind asset refs now that the full closure is loaded
+        const bool asset_rebind_ok = co_await co_rebind_assets_in_closure(new_closure, id, ctx);
+        co_await strand(ctx).schedule();
+        result.success = result.success && asset_rebind_ok;
 
-                // 9) Commit new closure to BatchInfo
-                {
-                    std::lock_guard lk(mtx_);
-                    auto it = batches_.find(id);
-                    if (it == batches_.end())
-                    {
-                        result.success = false;
-                        return emit_and_return();
-                    }
+        // 9) Commit new closure to BatchInfo
+        {
+            std::lock_guard lk(mtx_);
+            auto it = batches_.find(id);
+            if (it == batches_.end())
+            {
+                result.success = false;
+                co_return emit_and_return();
+            }
 
-                    if (it->second.state != BatchInfo::State::Loaded)
-                    {
-                        result.success = false;
-                        return emit_and_return();
-                    }
+            if (it->second.state != BatchInfo::State::Loaded)
+            {
+                result.success = false;
+                co_return emit_and_return();
+            }
 
-                    it->second.asset_closure_hdr = std::move(new_closure);
-                }
+            it->second.asset_closure_hdr = std::move(new_closure);
+        }
 
-                // 10) MT: rebind refs inside entities now that assets are loaded/bound
-                bind_refs_for_entities_on_main(live_snapshot, ctx);
+        // 10) MT: rebind refs inside entities now that assets are loaded/bound
+        co_await ctx.main_thread();
+        bind_refs_for_entities(live_snapshot, ctx);
 
-                event.assets_rebound = asset_rebind_ok;
-                return emit_and_return();
-            });
+        event.assets_rebound = asset_rebind_ok;
+        co_return emit_and_return();
     }
 
-    // -------- Load / Unload implementations --------
+    // -------- Load / Unload steps --------
 
-    TaskResult BatchRegistry::do_load(BatchInfo& B, EngineContext& ctx)
+    CoTask<TaskResult> BatchRegistry::load_steps(BatchInfo& B, EngineContext& ctx)
     {
         // -- Mark batch as Loading
         B.state = BatchInfo::State::Loading;
@@ -1389,8 +1439,6 @@ namespace eeng
         auto batch_path = index_path_.parent_path() / B.filename;
         std::ifstream f(batch_path);
 
-        nlohmann::json batch_json;
-
         if (!f.is_open())
         {
             // No file yet → treat as brand new empty batch.
@@ -1398,69 +1446,85 @@ namespace eeng
             B.asset_closure_hdr.clear();
             B.live.clear();
             res.success = true;
-            return res;
+            co_return res;
         }
 
-        f >> batch_json;
-
-        // parse asset_closure from header if present
-        if (batch_json.contains("header") &&
-            batch_json["header"].contains("asset_closure"))
-        {
-            B.asset_closure_hdr.clear();
-            for (auto& gstr : batch_json["header"]["asset_closure"])
-                B.asset_closure_hdr.push_back(Guid::from_string(gstr.get<std::string>()));
-        }
-
-        // parse entities
+        // Streamed: the header, then one entity at a time, so the file is never
+        // held as a DOM next to the spawn descriptors made from it
         std::vector<eeng::meta::EntitySpawnDesc> entity_descs;
-        if (batch_json.contains("entities"))
-        {
-            for (auto& ent_json : batch_json["entities"])
-                entity_descs.push_back(eeng::meta::create_entity_spawn_desc(ent_json));
-        }
+        for_each_json_member(f, { "entities" },
+            [&](const std::string& key, nlohmann::json&& header)
+            {
+                // parse asset_closure from header if present
+                if (key == "header" && header.contains("asset_closure"))
+                {
+                    B.asset_closure_hdr.clear();
+                    for (auto& gstr : header["asset_closure"])
+                        B.asset_closure_hdr.push_back(Guid::from_string(gstr.get<std::string>()));
+                }
+            },
+            [&](const std::string&, nlohmann::json&& ent_json)
+            {
+                entity_descs.push_back(eeng::meta::create_entity_spawn_desc(std::move(ent_json)));
+            });
+        f.close();
 
         // 1) Load assets
         if (!B.asset_closure_hdr.empty())
         {
-            res = ctx.resource_manager->load_and_bind_async(
+            res = co_await ctx.resource_manager->co_load_and_bind(
                 std::deque<Guid>(B.asset_closure_hdr.begin(), B.asset_closure_hdr.end()),
                 B.id,
                 ctx
-            ).get();
+            );
             if (!res.success)
-                return res; // TODO -> assets failed -> go on and spawn entities anyway?
+                co_return res; // TODO -> assets failed -> go on and spawn entities anyway?
         }
 
         // 2) spawn entities on main (if any)
-        ctx.main_thread_queue->push_and_wait([&]()
+        //    Spawning is split into chunks, each its own main-thread task, so
+        //    the per-frame task budget can spread a large batch over several
+        //    frames. Until the final step registers them, spawned entities
+        //    carry PendingSpawnTag so systems in the frames in between skip them.
+        co_await ctx.main_thread();
+        B.live.clear();
+
+        std::vector<ecs::Entity> new_entities;
+        new_entities.reserve(entity_descs.size());
+        for (size_t first = 0; first < entity_descs.size(); first += spawn_chunk_size)
+        {
+            if (first > 0)
+                co_await ctx.main_thread_queue->yield();
+
+            const size_t last = std::min(first + spawn_chunk_size, entity_descs.size());
+            for (size_t i = first; i < last; ++i)
             {
-                B.live.clear();
-                std::vector<ecs::Entity> new_entities;
-                new_entities.reserve(entity_descs.size());
+                auto er = eeng::meta::spawn_entity_from_desc(
+                    entity_descs[i],
+                    ctx,
+                    eeng::meta::SerializationPurpose::file);
+                // ctx.entity_manager->register_entity_live_parent(er.get_entity());
+                ctx.entity_manager->registry().emplace<ecs::PendingSpawnTag>(er.entity);
+                B.live.push_back(er);
+                new_entities.push_back(er.entity);
+            }
+        }
 
-                for (const auto& desc : entity_descs)
-                {
-                    auto er = eeng::meta::spawn_entity_from_desc(
-                        desc,
-                        ctx,
-                        eeng::meta::SerializationPurpose::file);
-                    // ctx.entity_manager->register_entity_live_parent(er.get_entity());
-                    B.live.push_back(er);
-                    new_entities.push_back(er.entity);
-                }
-                ctx.entity_manager->register_entities_from_deserialization(new_entities);
-            });
+        ctx.entity_manager->register_entities_from_deserialization(new_entities);
+
+        auto& registry = ctx.entity_manager->registry();
+        for (const auto& entity : new_entities)
+            registry.remove<ecs::PendingSpawnTag>(entity);
 
         // ABORT IF ASSET LOAD FAILED ???
 
         // 3) Bind AssetRef<> + EntityRef<> inside components
-        bind_refs_for_entities_on_main(B.live, ctx);
+        bind_refs_for_entities(B.live, ctx);
 
-        return res;
+        co_return res;
     }
 
-    TaskResult BatchRegistry::do_unload(BatchInfo& B, EngineContext& ctx)
+    CoTask<TaskResult> BatchRegistry::unload_steps(BatchInfo& B, EngineContext& ctx)
     {
         B.state = BatchInfo::State::Unloading;
 
@@ -1468,36 +1532,30 @@ namespace eeng
         res.success = true;
 
         // 1) Main-thread: despawn / queue-destroy entities
-        ctx.main_thread_queue->push_and_wait([&]()
+        co_await ctx.main_thread();
+        for (auto& er : B.live)
+        {
+            if (er.is_bound())
             {
-                for (auto& er : B.live)
-                {
-                    if (er.is_bound())
-                    {
-                        ctx.entity_manager->queue_entity_for_destruction(er.entity);
-                        er.unbind();
-                    }
-                }
-            });
+                ctx.entity_manager->queue_entity_for_destruction(er.entity);
+                er.unbind();
+            }
+        }
 
         B.live.clear();
 
-        // 3) RM: unbind/unload assets for this batch (if any)
+        // 2) RM: unbind/unload assets for this batch (if any)
         if (!B.asset_closure_hdr.empty())
         {
-            res = ctx.resource_manager->unbind_and_unload_async(
+            res = co_await ctx.resource_manager->co_unbind_and_unload(
                 std::deque<Guid>(B.asset_closure_hdr.begin(), B.asset_closure_hdr.end()),
                 B.id,
                 ctx
-            ).get();
-            if (!res.success)
-            {
-                // If unload failed, keep GPU resources intact to avoid dropping shared assets.
-                return res;
-            }
+            );
+            // If unload failed, GPU resources are kept intact to avoid dropping shared assets.
         }
 
-        return res;
+        co_return res;
     }
 
     SerialExecutor& BatchRegistry::strand(EngineContext& ctx)
@@ -6,6 +6,8 @@
 //#include "ResourceManager.hpp"
 #include "engineapi/IResourceManager.hpp"
 #include "SerialExecutor.hpp"
+#include "CoTask.hpp"
+#include "AsyncMutex.hpp"
 #include "MetaSerialize.hpp"
 #include "EngineContext.hpp"
 #include <filesystem>
@@ -113,8 +115,8 @@ namespace eeng {
         /**
          * @brief Enqueue loading of all batches listed in the batch index.
          *
-         * Schedules each batch load as an individual task via queue_load(), and waits
-         * for all loads to complete inside a worker thread (not the strand).
+         * Loads the batches one after another via co_load(). Waiting between steps
+         * holds no thread.
          *
          * @note The returned future becomes ready only when *all* batches have fully
          *       completed their load sequence (asset load/bind + entity instantiation).
@@ -129,8 +131,8 @@ namespace eeng {
         /**
          * @brief Enqueue saving of all currently loaded batches.
          *
-         * Schedules a per-batch save operation (via queue_save_batch()), waits for each
-         * to finish inside a worker thread, and aggregates the results.
+         * Saves the batches one after another via co_save_batch() and aggregates
+         * the results.
          *
          * @note Only batches in the Loaded state are saved; unloaded batches are skipped.
          *
@@ -151,6 +153,18 @@ namespace eeng {
         /// Detach an entity from a batch (thread safe). Does NOT destroy the entity.
         std::shared_future<bool> queue_detach_entity(const BatchId& id, ecs::EntityRef entity_ref, EngineContext& ctx);
 
+        // Coroutine variants of queue_load/queue_unload/queue_save_batch and the
+        // _all operations, which the queue_ calls spawn. Batch state changes run
+        // on the strand, entity work on the main thread and asset loads through
+        // the resource manager; no thread is held while waiting in between.
+        // Operations stay exclusive through ops_gate_.
+        CoTask<TaskResult> co_load(BatchId id, EngineContext& ctx);
+        CoTask<TaskResult> co_unload(BatchId id, EngineContext& ctx);
+        CoTask<TaskResult> co_save_batch(BatchId id, EngineContext& ctx);
+        CoTask<TaskResult> co_load_all(EngineContext& ctx);
+        CoTask<TaskResult> co_unload_all(EngineContext& ctx);
+        CoTask<TaskResult> co_save_all(EngineContext& ctx);
+
         /// Spawn entity from description and add to batch (thread safe).
         std::shared_future<ecs::EntityRef> queue_spawn_entity(const BatchId& id, meta::EntitySpawnDesc desc, EngineContext& ctx);
 
@@ -188,9 +202,10 @@ namespace eeng {
 
         /// Recompute the asset closure for a loaded batch from its live entities,
         /// and adjust RM leases accordingly (load/bind new GUIDs, unbind/unload
-        /// GUIDs that are no longer referenced). Runs on the BatchRegistry strand.
+        /// GUIDs that are no longer referenced). Spawns co_rebuild_closure().
         std::shared_future<TaskResult>
             queue_rebuild_closure(const BatchId& id, EngineContext& ctx);
+        CoTask<TaskResult> co_rebuild_closure(BatchId id, EngineContext& ctx);
 
         /// Mark a loaded batch as needing asset-closure rebuild (coalesced).
         void mark_closure_dirty(const BatchId& id);
@@ -205,9 +220,13 @@ namespace eeng {
 
     private:
 
-        // Steps (run by strand)
-        TaskResult do_load(BatchInfo& B, EngineContext& ctx);
-        TaskResult do_unload(BatchInfo& B, EngineContext& ctx);
+        // Steps of co_load/co_unload. Start on the strand, end on the main thread
+        // or wherever the resource manager resumes.
+        CoTask<TaskResult> load_steps(BatchInfo& B, EngineContext& ctx);
+        CoTask<TaskResult> unload_steps(BatchInfo& B, EngineContext& ctx);
+
+        // Copy of a batch if it is Loaded
+        std::optional<BatchInfo> snapshot_loaded(const BatchId& id) const;
 
         // Helpers (main-thread work)
 #if 0
@@ -224,6 +243,10 @@ namespace eeng {
         mutable std::mutex              strand_mutex_;
         SerialExecutor& strand(EngineContext& ctx);   // helper
 
+        // Held by load/unload/save/rebuild from start to end, also while
+        // suspended off the strand
+        AsyncMutex                      ops_gate_;
+
         // registry storage
         mutable std::mutex                           mtx_;
         std::unordered_map<eeng::BatchId, BatchInfo> batches_;
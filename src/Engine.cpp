@@ -18,6 +18,9 @@
 
 #include "ImGuiBackendSDL.hpp"
 #include "EventQueue.h"
+#include "FrameArena.hpp"
+#include "ResourceManager.hpp"
+#include "meta/MetaAux.h"
 
 #define SDL_MAIN_HANDLED
 #include <SDL.h>
@@ -108,11 +111,17 @@ namespace eeng
         ctx->event_queue->register_callback([&](const SetMinFrameTimeEvent& event) { this->on_set_min_frametime(event); });
         ctx->event_queue->register_callback([&](const ResourceTaskCompletedEvent& event) { this->on_resource_task_completed(event); });
         ctx->event_queue->register_callback([&](const BatchTaskCompletedEvent& event) { this->on_batch_task_completed(event); });
+        ctx->event_queue->register_callback([&](const MemoryBudgetExceededEvent& event) { this->on_memory_budget_exceeded(event); });
+
+        // Storage budgets are exceeded on loader threads: forward to the event queue
+        static_cast<ResourceManager&>(*ctx->resource_manager).storage().set_memory_budget_listener(
+            [event_queue = ctx->event_queue.get()](const MemoryBudgetExceededEvent& event) { event_queue->enqueue_event(event); });
 
         // Engine config
         ctx->engine_config->set_flag(EngineFlag::VSync, true);
         ctx->engine_config->set_flag(EngineFlag::WireframeRendering, false);
         ctx->engine_config->set_value(EngineValue::MinFrameTime, 1000.0f / 60.0f);
+        ctx->engine_config->set_value(EngineValue::MainThreadQueueBudget, 4.0f);
 
         // Gui flags
         ctx->gui_manager->set_flag(eeng::GuiFlags::ShowEngineInfo, true);
@@ -177,12 +186,18 @@ namespace eeng
 
             // --- Main thread tasks ---
             // entt::storage mutations etc
-            ctx->main_thread_queue->execute_all();
+            // Time-boxed, so a burst of queued work is spread over several frames
+            const float mtq_budget_ms = ctx->engine_config->get_value(EngineValue::MainThreadQueueBudget);
+            if (mtq_budget_ms > 0.0f)
+                ctx->main_thread_queue->execute_for(
+                    std::chrono::microseconds(static_cast<int64_t>(mtq_budget_ms * 1000.0f)));
+            else
+                ctx->main_thread_queue->execute_all();
 
             ctx->entity_manager->destroy_pending_entities();
 
             // --- Event dispatch ---
-            ctx->event_queue->dispatch_all_events();
+            ctx->event_queue->dispatch_all_events(ctx->frame_arena->resource());
 
             // --- Event dispatch / Command execution / Entity destruction ---
 #if 1
@@ -233,6 +248,9 @@ namespace eeng
 
             SDL_GL_SwapWindow(window_);
 
+            // Reclaim transient memory from the frame before this one
+            ctx->frame_arena->end_frame();
+
             // Add a delay if frame time was shorter than the target frame time
             const Uint32 elapsed_ms = SDL_GetTicks() - time_ms;
             if (elapsed_ms < min_frametime_ms)
@@ -421,6 +439,13 @@ namespace eeng
         min_frametime_ms = e.dt;
     }
 
+    void Engine::on_memory_budget_exceeded(const MemoryBudgetExceededEvent& e)
+    {
+        const auto type_name = meta::get_meta_type_id_string(entt::resolve(e.type_id));
+        EENG_LOG_WARN(ctx, "Memory budget exceeded for %s: %.1f KB of %.1f KB",
+            type_name.c_str(), e.total_bytes / 1024.0, e.budget_bytes / 1024.0);
+    }
+
     void Engine::on_resource_task_completed(const ResourceTaskCompletedEvent& e)
     {
         // Handle resource task completion
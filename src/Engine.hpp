@@ -15,6 +15,8 @@ typedef void* SDL_GLContext;    // Forward declaration
 
 namespace eeng
 {
+    struct MemoryBudgetExceededEvent;
+
     /**
      * @brief Main engine class handling SDL, OpenGL, ImGui initialization and the main loop.
      */
@@ -101,6 +103,7 @@ namespace eeng
         void on_set_min_frametime(const SetMinFrameTimeEvent& e);
         void on_resource_task_completed(const ResourceTaskCompletedEvent& e);
         void on_batch_task_completed(const BatchTaskCompletedEvent& e);
+        void on_memory_budget_exceeded(const MemoryBudgetExceededEvent& e);
 
     };
 
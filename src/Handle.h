@@ -3,15 +3,19 @@
 
 #ifndef Handle_h
 #define Handle_h
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <limits>
 #include "hash_combine.h"
 
 
 namespace eeng
 {
-    using handle_idx_type = size_t;
-    using handle_ver_type = uint16_t;
+    // Slot index and generation, 32 bits each: a handle packs into 8 bytes
+    using handle_idx_type = uint32_t;
+    using handle_ver_type = uint32_t;
     constexpr handle_idx_type  handle_idx_null = std::numeric_limits<handle_idx_type>::max();
     constexpr handle_ver_type  handle_ver_null = std::numeric_limits<handle_ver_type>::max();
 
@@ -28,8 +32,19 @@ namespace eeng
         handle_ver_type ver;
 
         Handle() : idx(handle_idx_null), ver(handle_ver_null) {}
-        Handle(handle_idx_type ofs) : idx(ofs), ver(handle_ver_null) {}
-        Handle(handle_idx_type ofs, handle_ver_type ver) : idx(ofs), ver(ver) {}
+        Handle(size_t ofs) : idx(narrow(ofs)), ver(handle_ver_null) {}
+        Handle(size_t ofs, handle_ver_type ver) : idx(narrow(ofs)), ver(ver) {}
+
+        /// Index and generation as one 64-bit value
+        uint64_t packed() const
+        {
+            return uint64_t(ver) << 32 | idx;
+        }
+
+        static Handle from_packed(uint64_t bits)
+        {
+            return Handle{ handle_idx_type(bits), handle_ver_type(bits >> 32) };
+        }
 
         void reset()
         {
@@ -57,7 +72,17 @@ namespace eeng
         {
             return idx != handle_idx_null;
         }
+
+    private:
+        // Slot indices are computed in size_t by the pools
+        static handle_idx_type narrow(size_t ofs)
+        {
+            assert(ofs <= handle_idx_null && "Slot index does not fit a handle");
+            return static_cast<handle_idx_type>(ofs);
+        }
     };
+
+    static_assert(sizeof(Handle<int>) == 8, "Handle must pack into 64 bits");
 }
 
 namespace std {
@@ -66,7 +91,7 @@ namespace std {
     {
         size_t operator()(const eeng::Handle<T>& h) const noexcept
         {
-            return hash_combine(h.idx, h.ver);
+            return std::hash<uint64_t>{}(h.packed());
         }
     };
 }
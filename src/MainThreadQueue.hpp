@@ -1,24 +1,97 @@
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#pragma once
+#include "UniqueTask.hpp"
+#include "NodePool.hpp"
+#include "ExecutorStats.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <future>
 #include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
+class MainThreadQueue;
+
+/// Awaitable that continues the awaiting coroutine on the main thread, as a
+/// queued task. Does not suspend if already on the main thread, unless
+/// `requeue` is set (see MainThreadQueue::yield()).
+struct MainThreadAwaiter
+{
+    MainThreadQueue& queue;
+    bool requeue = false;
+
+    bool await_ready() const noexcept;
+    void await_suspend(std::coroutine_handle<> awaiting);
+    void await_resume() const noexcept {}
+};
+
+/// Queue of tasks to be run on the main thread.
+///
+/// Any thread may push; only the main thread (the one that created the queue)
+/// executes. The queue is an intrusive lock-free MPSC list (Vyukov). Nodes
+/// come from a NodePool and hold the task as a UniqueTask, so pushing a
+/// small callable normally does not allocate.
+///
+/// execute_all() runs everything queued at the time of the call, while
+/// execute_for() stops when a time budget is spent and leaves the remaining
+/// tasks, in order, for the next call.
+///
+/// Coroutines can hop to the main thread with `co_await queue.schedule()`.
+/// Latency and run-time histograms are available through instrumentation().
 class MainThreadQueue
 {
 public:
+    struct Stats
+    {
+        uint64_t queued = 0;    // Tasks pushed, in total
+        uint64_t executed = 0;  // Tasks run, in total
+        uint64_t deferred = 0;  // Sum over execute_for() calls of tasks left for a later call
+    };
+
     explicit MainThreadQueue()
-        : owner_(std::this_thread::get_id()) {
+        : owner_(std::this_thread::get_id())
+        , instrumentation_("main_thread")
+        , head_(&stub_)
+        , tail_(&stub_)
+    {
+    }
+
+    MainThreadQueue(const MainThreadQueue&) = delete;
+    MainThreadQueue& operator=(const MainThreadQueue&) = delete;
+
+    ~MainThreadQueue()
+    {
+        while (Node* node = pop())
+        {
+            node->task.reset();
+            node_pool_.release(node);
+        }
     }
 
     // Enqueue a task (non-blocking). Callable must be noexcept or handle its own exceptions.
-    void push(std::function<void()> fn)
+    void push(UniqueTask fn)
     {
+        Node* node = node_pool_.acquire();
+        node->task = std::move(fn);
+        node->enqueued_ns = instrumentation_.now_if_enabled();
+        node->next.store(nullptr, std::memory_order_relaxed);
+        const uint64_t enqueued_ns = node->enqueued_ns; // The node may run as soon as it is linked
+        link(node);
+
+        queued_.fetch_add(1, std::memory_order_release);
+        queued_.notify_one();
+
+        if (enqueued_ns)
         {
-            std::lock_guard<std::mutex> lk(mtx_);
-            q_.push(std::move(fn));
+            const size_t depth = size();
+            instrumentation_.record(ExecutorMetric::QueueDepth, depth);
+            instrumentation_.trace_counter("main_queue_depth", enqueued_ns, depth);
         }
-        cv_.notify_one();
     }
 
     // Enqueue and wait until the task has executed on the main thread.
@@ -27,23 +100,23 @@ public:
     {
         using R = std::invoke_result_t<F&>;
 
-        if (std::this_thread::get_id() == owner_) {
+        if (is_main_thread()) {
             // Already on main thread: run inline
             if constexpr (std::is_void_v<R>) { fn(); return; }
             else { return fn(); }
         }
 
         // otherwise enqueue + wait (Fix 1 or Fix 2 here)
-        auto prom = std::make_shared<std::promise<R>>();
-        auto fut = prom->get_future();
+        std::promise<R> prom;
+        auto fut = prom.get_future();
 
-        push([prom, f = std::forward<F>(fn)]() mutable {
+        push([prom = std::move(prom), f = std::forward<F>(fn)]() mutable {
             try {
-                if constexpr (std::is_void_v<R>) { f(); prom->set_value(); }
-                else { prom->set_value(f()); }
+                if constexpr (std::is_void_v<R>) { f(); prom.set_value(); }
+                else { prom.set_value(f()); }
             }
             catch (...) {
-                prom->set_exception(std::current_exception());
+                prom.set_exception(std::current_exception());
             }
             });
 
@@ -51,42 +124,191 @@ public:
         else { return fut.get(); }
     }
 
-    // Called by the main thread, once per frame or more often.
-    void execute_all()
+    /// @brief Run every task queued before the call. Main thread only.
+    /// Tasks pushed while executing (e.g. by the tasks themselves) wait for the next call.
+    /// @return Number of tasks run
+    size_t execute_all()
     {
-        assert(std::this_thread::get_id() == owner_);
+        return execute_until(std::chrono::steady_clock::time_point::max());
+    }
 
-        std::queue<std::function<void()>> local;
-        {
-            std::lock_guard<std::mutex> lk(mtx_);
-            local.swap(q_);
-        }
+    /// @brief Like execute_all(), but stop once `budget` has elapsed. Main thread only.
+    /// At least one task is run if any is queued. Tasks not reached stay queued,
+    /// in order, and are counted in Stats::deferred.
+    /// @return Number of tasks run
+    size_t execute_for(std::chrono::microseconds budget)
+    {
+        return execute_until(std::chrono::steady_clock::now() + budget);
+    }
 
-        while (!local.empty())
+    // Optional: blocking wait
+    void wait_for_work()
+    {
+        uint64_t queued = queued_.load(std::memory_order_acquire);
+        while (queued == executed_.load(std::memory_order_relaxed))
         {
-            auto fn = std::move(local.front());
-            local.pop();
-            try { fn(); }
-            catch (...) { /* log and continue */ }
+            queued_.wait(queued, std::memory_order_acquire);
+            queued = queued_.load(std::memory_order_acquire);
         }
     }
 
-    // Optional: blocking wait
-    void wait_for_work()
+    /// Approximate number of queued tasks
+    size_t size() const
     {
-        std::unique_lock<std::mutex> lk(mtx_);
-        cv_.wait(lk, [&] { return !q_.empty(); });
+        const uint64_t queued = queued_.load(std::memory_order_acquire);
+        const uint64_t executed = executed_.load(std::memory_order_acquire);
+        return queued > executed ? static_cast<size_t>(queued - executed) : 0;
     }
 
     bool empty() const
     {
-        std::lock_guard<std::mutex> lk(mtx_);
-        return q_.empty();
+        return size() == 0;
+    }
+
+    Stats stats() const
+    {
+        return {
+            queued_.load(std::memory_order_relaxed),
+            executed_.load(std::memory_order_relaxed),
+            deferred_.load(std::memory_order_relaxed) };
+    }
+
+    /// Queue latency, run time and depth histograms. Off by default.
+    ExecutorStats& instrumentation() { return instrumentation_; }
+    const ExecutorStats& instrumentation() const { return instrumentation_; }
+
+    bool is_main_thread() const
+    {
+        return std::this_thread::get_id() == owner_;
+    }
+
+    /// co_await to continue the current coroutine on the main thread
+    MainThreadAwaiter schedule()
+    {
+        return { *this };
+    }
+
+    /// Like schedule(), but also requeues when already on the main thread, so
+    /// long main-thread work can be split over the per-frame task budget
+    MainThreadAwaiter yield()
+    {
+        return { *this, true };
     }
 
 private:
-    std::thread::id         owner_;
-    mutable std::mutex      mtx_;
-    std::condition_variable  cv_;
-    std::queue<std::function<void()>> q_;
+    struct Node
+    {
+        std::atomic<Node*> next{ nullptr };
+        UniqueTask task;
+        uint64_t enqueued_ns = 0; // Set when instrumentation is enabled
+        uint32_t pool_index = 0;
+        std::atomic<uint32_t> pool_next{ 0 };
+    };
+
+    // --- MPSC list -----------------------------------------------------------
+
+    void link(Node* node)
+    {
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer only. May return nullptr while a producer is mid-push.
+    Node* pop()
+    {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &stub_)
+        {
+            if (!next) return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            tail_ = next;
+            return tail;
+        }
+        if (tail != head_.load(std::memory_order_acquire))
+            return nullptr;
+
+        // Last node: put the stub behind it so it can be detached
+        stub_.next.store(nullptr, std::memory_order_relaxed);
+        link(&stub_);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            tail_ = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    size_t execute_until(std::chrono::steady_clock::time_point deadline)
+    {
+        assert(is_main_thread());
+
+        const uint64_t target = queued_.load(std::memory_order_acquire);
+        uint64_t executed = executed_.load(std::memory_order_relaxed);
+        size_t count = 0;
+
+        while (executed < target)
+        {
+            Node* node = pop();
+            if (!node) break;
+
+            const uint64_t started_ns = node->enqueued_ns ? ExecutorStats::now() : 0;
+            if (started_ns)
+                instrumentation_.record(ExecutorMetric::QueueLatency, started_ns - node->enqueued_ns);
+
+            try { node->task(); }
+            catch (...) { /* log and continue */ }
+            node->task.reset();
+            node_pool_.release(node);
+
+            if (started_ns)
+            {
+                const uint64_t finished_ns = ExecutorStats::now();
+                instrumentation_.record(ExecutorMetric::RunTime, finished_ns - started_ns);
+                instrumentation_.trace_span("main_task", started_ns, finished_ns);
+            }
+
+            executed_.store(++executed, std::memory_order_release);
+            ++count;
+
+            if (executed < target && std::chrono::steady_clock::now() >= deadline)
+            {
+                deferred_.fetch_add(target - executed, std::memory_order_relaxed);
+                break;
+            }
+        }
+        return count;
+    }
+
+    std::thread::id owner_;
+    ExecutorStats instrumentation_;
+
+    // Producers
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<uint64_t> queued_{ 0 };
+
+    // Consumer
+    alignas(64) Node* tail_;
+    Node stub_;
+    std::atomic<uint64_t> executed_{ 0 };
+    std::atomic<uint64_t> deferred_{ 0 };
+
+    NodePool<Node> node_pool_;
 };
+
+inline bool MainThreadAwaiter::await_ready() const noexcept
+{
+    return !requeue && queue.is_main_thread();
+}
+
+inline void MainThreadAwaiter::await_suspend(std::coroutine_handle<> awaiting)
+{
+    queue.push([awaiting]() { awaiting.resume(); });
+}
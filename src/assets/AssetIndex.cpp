@@ -7,7 +7,10 @@
 #include "ThreadPool.hpp"
 #include "MetaSerialize.hpp"
 #include "builders/ContentTreeBuilder.hpp"
+#include <chrono>
+#include <format>
 #include <fstream>
+#include <optional>
 
 namespace eeng
 {
@@ -23,11 +26,7 @@ namespace eeng
         data->entries = std::move(entries);
 
         // 2) Build aux maps
-        for (const auto& entry : data->entries) {
-            data->by_guid[entry.meta.guid] = &entry;
-            data->by_type[entry.meta.type_id].push_back(&entry);
-            data->by_parent[entry.meta.guid_parent].push_back(&entry);
-        }
+        data->build_maps();
 
         // 3) Build tree views
         auto views = std::make_shared<AssetTreeViews>();
@@ -92,7 +91,8 @@ namespace eeng
     //std::shared_ptr<const std::vector<AssetEntry>> AssetIndex::get_entries_view() const
     AssetIndexDataPtr AssetIndex::get_index_data() const
     {
-        // Atomic access: no need for mutex
+        // Copy the pointer under the lock; the data it points to is immutable
+        std::lock_guard lk(entries_mutex_);
         return index_data_;
     }
 
@@ -101,34 +101,128 @@ namespace eeng
     //     return scanning_flag_.load(std::memory_order_acquire);
     // }
 
+    std::filesystem::path AssetIndex::default_scan_cache_path(const std::filesystem::path& root)
+    {
+        // Named after the root, with a hash of its absolute path to tell apart equally named roots
+        const auto absolute = std::filesystem::absolute(root).lexically_normal();
+        const auto key = absolute.generic_string();
+        auto name = absolute.filename().string();
+        if (name.empty()) name = absolute.parent_path().filename().string(); // Trailing separator
+        return std::filesystem::temp_directory_path() / "eeng_asset_scan_cache" /
+            std::format("{}-{:08x}.json", name, entt::hashed_string::value(key.c_str(), key.size()));
+    }
+
+    void AssetIndex::set_scan_cache_path(const std::filesystem::path& path)
+    {
+        std::lock_guard lk(scan_mutex_);
+        scan_cache_path_ = path;
+        scan_cache_root_.reset(); // Reload from the new file on the next scan
+    }
+
+    AssetIndex::ScanStats AssetIndex::last_scan_stats() const
+    {
+        std::lock_guard lk(entries_mutex_);
+        return last_scan_stats_;
+    }
+
+    namespace
+    {
+        constexpr int scan_cache_version = 1;
+
+        std::optional<AssetMetaData> read_meta_file(
+            const std::filesystem::path& meta_path,
+            EngineContext& ctx)
+        {
+            std::ifstream in(meta_path);
+            if (!in) return std::nullopt;
+
+            nlohmann::json json;
+            in >> json;
+
+            entt::meta_any any = AssetMetaData{};
+            meta::deserialize_any(json, any, ecs::Entity{}, ctx, meta::SerializationPurpose::file);
+            return any.cast<AssetMetaData>();
+        }
+    }
+
     std::vector<AssetEntry> AssetIndex::scan_meta_files(
         const std::filesystem::path& root,
         EngineContext& ctx)
     {
-        std::vector<AssetEntry> assets;
+        const auto t0 = std::chrono::steady_clock::now();
+        std::lock_guard scan_lock(scan_mutex_);
+
+        const auto cache_file = scan_cache_path_.empty() ? default_scan_cache_path(root) : scan_cache_path_;
+        if (scan_cache_root_ != root)
+        {
+            scan_cache_.clear();
+            scan_cache_root_ = root;
+            load_scan_cache(cache_file, ctx);
+        }
+
+        // 1) Walk the tree: meta files with their size and write time
+        struct MetaFile
+        {
+            std::filesystem::path path;
+            std::string key;    // Path relative to root, the cache key
+            int64_t write_time;
+            uintmax_t size;
+        };
+        std::vector<MetaFile> files;
 
         for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
         {
             if (!entry.is_regular_file()) continue;
 
             const auto& meta_path = entry.path();
-            std::string filename = meta_path.filename().string();
 
             // Ensure the file ends with ".meta.json"
-            if (!filename.ends_with(".meta.json"))
+            if (!meta_path.filename().string().ends_with(".meta.json"))
                 continue;
 
-            // Open and parse the meta file
-            std::ifstream in(meta_path);
-            if (!in) continue;
+            files.push_back(MetaFile{
+                meta_path,
+                meta_path.lexically_relative(root).generic_string(),
+                static_cast<int64_t>(entry.last_write_time().time_since_epoch().count()),
+                entry.file_size()
+                });
+        }
 
-            nlohmann::json json;
-            in >> json;
+        // 2) Take unchanged files from the cache, parse the others in parallel
+        std::vector<std::optional<AssetMetaData>> metas(files.size());
+        std::vector<size_t> changed;
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            auto it = scan_cache_.find(files[i].key);
+            if (it != scan_cache_.end() &&
+                it->second.write_time == files[i].write_time &&
+                it->second.size == files[i].size)
+                metas[i] = it->second.meta;
+            else
+                changed.push_back(i);
+        }
 
-            // Deserialize into AssetMetaData
-            entt::meta_any any = AssetMetaData{};
-            meta::deserialize_any(json, any, ecs::Entity{}, ctx, meta::SerializationPurpose::file);
-            AssetMetaData meta = any.cast<AssetMetaData>();
+        auto parse = [&](size_t c)
+            {
+                const size_t i = changed[c];
+                metas[i] = read_meta_file(files[i].path, ctx);
+            };
+        if (ctx.thread_pool && changed.size() > 1)
+            ctx.thread_pool->parallel_for(size_t{ 0 }, changed.size(), 1, parse);
+        else
+            for (size_t c = 0; c < changed.size(); ++c) parse(c);
+
+        // 3) Entries, and the cache for the next scan
+        std::vector<AssetEntry> assets;
+        std::unordered_map<std::string, ScanCacheEntry> cache;
+        assets.reserve(files.size());
+        cache.reserve(files.size());
+        for (size_t i = 0; i < files.size(); ++i)
+        {
+            if (!metas[i]) continue; // Could not be opened
+
+            const auto& meta_path = files[i].path;
+            const std::string filename = meta_path.filename().string();
 
             // Derive the resource .json file path from the meta path
             std::string base_name = filename.substr(0, filename.size() - std::string(".meta.json").size());
@@ -137,14 +231,92 @@ namespace eeng
             // Compute path relative to the root (for GUI display etc.)
             std::filesystem::path relative_path = std::filesystem::relative(asset_path, root);
 
+            cache.emplace(files[i].key, ScanCacheEntry{ files[i].write_time, files[i].size, *metas[i] });
             assets.emplace_back(AssetEntry{
-                std::move(meta),
+                std::move(*metas[i]),
                 std::move(relative_path),
                 std::move(asset_path)
                 });
         }
 
+        const bool cache_changed = !changed.empty() || cache.size() != scan_cache_.size();
+        scan_cache_ = std::move(cache);
+        if (cache_changed)
+            save_scan_cache(cache_file, ctx);
+
+        {
+            std::lock_guard lk(entries_mutex_);
+            last_scan_stats_ = ScanStats{
+                files.size(),
+                changed.size(),
+                files.size() - changed.size(),
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() };
+        }
+
         return assets;
     }
 
+    void AssetIndex::load_scan_cache(const std::filesystem::path& file, EngineContext& ctx)
+    {
+        std::ifstream in(file);
+        if (!in) return; // No cache yet
+
+        try
+        {
+            nlohmann::json json;
+            in >> json;
+            if (json.value("version", 0) != scan_cache_version)
+                return;
+
+            for (const auto& [key, entry] : json.at("entries").items())
+            {
+                entt::meta_any any = AssetMetaData{};
+                meta::deserialize_any(entry.at("meta"), any, ecs::Entity{}, ctx, meta::SerializationPurpose::file);
+                scan_cache_.emplace(key, ScanCacheEntry{
+                    entry.at("write_time").get<int64_t>(),
+                    entry.at("size").get<uintmax_t>(),
+                    any.cast<AssetMetaData>() });
+            }
+        }
+        catch (const std::exception& e)
+        {
+            // A damaged cache only costs a full parse
+            scan_cache_.clear();
+            EENG_LOG_WARN(&ctx, "Ignoring asset scan cache %s: %s", file.string().c_str(), e.what());
+        }
+    }
+
+    void AssetIndex::save_scan_cache(const std::filesystem::path& file, EngineContext& ctx) const
+    {
+        nlohmann::json entries = nlohmann::json::object();
+        for (const auto& [key, entry] : scan_cache_)
+        {
+            entries[key] = {
+                { "write_time", entry.write_time },
+                { "size", entry.size },
+                { "meta", meta::serialize_any(entt::forward_as_meta(entry.meta), meta::SerializationPurpose::file) }
+            };
+        }
+        const nlohmann::json json = { { "version", scan_cache_version }, { "entries", std::move(entries) } };
+
+        // Write a temporary file and rename it, so an interrupted write never leaves a torn cache
+        auto tmp_file = file;
+        tmp_file += ".tmp";
+        std::error_code ec;
+        if (file.has_parent_path())
+            std::filesystem::create_directories(file.parent_path(), ec);
+        {
+            std::ofstream out(tmp_file);
+            if (!out)
+            {
+                EENG_LOG_WARN(&ctx, "Failed to write asset scan cache %s", tmp_file.string().c_str());
+                return;
+            }
+            out << json.dump();
+        }
+        std::filesystem::rename(tmp_file, file, ec);
+        if (ec)
+            EENG_LOG_WARN(&ctx, "Failed to write asset scan cache %s: %s", file.string().c_str(), ec.message().c_str());
+    }
+
 } // namespace eeng
@@ -9,6 +9,7 @@
 #include "AssetEntry.hpp"
 #include "AssetIndexData.hpp"
 #include "MetaSerialize.hpp"
+#include "MetaLiterals.h"
 #include "EngineContext.hpp"
 
 #include <nlohmann/json.hpp> // <nlohmann/json_fwd.hpp>
@@ -18,6 +19,8 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <optional>
+#include <unordered_map>
 #include "LogMacros.h"
 
 namespace eeng
@@ -27,10 +30,33 @@ namespace eeng
     class AssetIndex
     {
     public:
+        /// @brief Outcome of the last scan_assets()
+        struct ScanStats
+        {
+            size_t meta_files = 0;      // .meta.json files found
+            size_t parsed = 0;          // New or changed since the previous scan, parsed
+            size_t cached = 0;          // Unchanged, taken from the scan cache
+            double milliseconds = 0.0;
+        };
+
+        /// @brief Scan cache file used for root unless set_scan_cache_path() says
+        /// otherwise: one file per root in <temp>/eeng_asset_scan_cache, outside
+        /// the content tree so it is never picked up by version control
+        static std::filesystem::path default_scan_cache_path(const std::filesystem::path& root);
+
         AssetIndex() = default;
         ~AssetIndex() = default;
 
+        /// @brief Scan root for .meta.json files and build index data.
+        /// Meta files are parsed in parallel on ctx.thread_pool. Files whose
+        /// size and write time match the scan cache are not parsed again; the
+        /// cache is persisted, so this also holds for the first scan of a session.
         AssetIndexDataPtr scan_assets(const std::filesystem::path& root, EngineContext& ctx);
+
+        /// @brief Persist the scan cache to this file instead of default_scan_cache_path(root)
+        void set_scan_cache_path(const std::filesystem::path& path);
+
+        ScanStats last_scan_stats() const;
         // void start_async_scan(const std::filesystem::path& root, EngineContext& ctx);
 
         void publish(AssetIndexDataPtr data);
@@ -41,11 +67,18 @@ namespace eeng
 
         // bool is_scanning() const; // remove
 
+        /// @brief Path of the cooked (binary) file next to an asset's .json
+        static std::filesystem::path cooked_path(const std::filesystem::path& asset_path)
+        {
+            return std::filesystem::path{ asset_path }.replace_extension(".cooked");
+        }
+
         /// @brief Serializes an asset to disk.
         template<typename T>
         void serialize_to_file(const T& asset, const AssetMetaData& meta,
             const std::filesystem::path& asset_path,
-            const std::filesystem::path& meta_path)
+            const std::filesystem::path& meta_path,
+            EngineContext& ctx)
         {
             // Serialize data first
             nlohmann::json j_asset = meta::serialize_any(
@@ -63,6 +96,23 @@ namespace eeng
                 out_asset << j_asset.dump(4);
             }
 
+            // Cooked binary for types that have one, after the JSON is closed so
+            // the header records its final size and write time. Optional: if
+            // cooking fails, loads fall back to the JSON
+            if (entt::meta_func cook = entt::resolve<T>().func(literals::cook_hs); cook)
+            {
+                entt::meta_any any = entt::forward_as_meta(asset);
+                const auto cooked = cooked_path(asset_path);
+                try
+                {
+                    cook.invoke({}, entt::forward_as_meta(any), entt::forward_as_meta(cooked), entt::forward_as_meta(asset_path));
+                }
+                catch (const std::exception& e)
+                {
+                    EENG_LOG_WARN(&ctx, "Failed to cook %s: %s", cooked.string().c_str(), e.what());
+                }
+            }
+
             // Then write meta last (signals scan readiness)
             {
                 std::ofstream out_meta(meta_path);
@@ -77,18 +127,36 @@ namespace eeng
             const Guid& guid,
             EngineContext& ctx) const
         {
-            // std::lock_guard lock{ entries_mutex_ }; // Protect access to entries_
-            
-            auto entries = index_data_->entries; // atomic snapshot
-            auto it = std::find_if(entries.begin(), entries.end(), [&](const AssetEntry& entry)
-                {
-                    return entry.meta.guid == guid;
-                });
-
-            if (it == entries.end())
+            // Snapshot of the index: keeps the entry alive if a rescan publishes meanwhile
+            const AssetIndexDataPtr index_data = get_index_data();
+            const AssetEntry* entry = index_data ? index_data->find(guid) : nullptr;
+            if (!entry)
                 throw std::runtime_error("No asset entry found for GUID " + guid.to_string());
 
-            const auto& path = it->absolute_path;
+            const auto& path = entry->absolute_path;
+
+            // Prefer a cooked binary. The hook rejects one whose recorded source
+            // size or write time differs from the JSON (edited, replaced or restored)
+            if (entt::meta_func load_cooked = entt::resolve<T>().func(literals::load_cooked_hs); load_cooked)
+            {
+                const auto cooked = cooked_path(path);
+                std::error_code ec;
+                if (std::filesystem::exists(cooked, ec))
+                {
+                    try
+                    {
+                        entt::meta_any t = T{};
+                        load_cooked.invoke({}, entt::forward_as_meta(cooked), entt::forward_as_meta(path), entt::forward_as_meta(t));
+                        return t.cast<T>();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        // Stale, outdated or damaged: fall back to the JSON
+                        EENG_LOG_WARN(&ctx, "Ignoring cooked file %s: %s", cooked.string().c_str(), e.what());
+                    }
+                }
+            }
+
             //
             // TODO: Check what file is: json, png ...
             //
@@ -96,12 +164,10 @@ namespace eeng
             if (!file)
                 throw std::runtime_error("Failed to open asset file: " + path.string());
 
-            nlohmann::json j;
-            file >> j;
-
+            // Streamed from the file, without a DOM of the whole asset
             entt::meta_any t = T{};
             // entt::meta_any any = entt::resolve<T>().construct(); // meta based
-            meta::deserialize_any(j, t, ecs::Entity{}, ctx, meta::SerializationPurpose::file);
+            meta::deserialize_any(file, t, ecs::Entity{}, ctx, meta::SerializationPurpose::file);
             return t.cast<T>();
             //T result;
             // meta::deserialize_any(j, entt::forward_as_meta(result), Entity{}, ctx, meta::SerializationPurpose::file);
@@ -117,8 +183,24 @@ namespace eeng
 
         // std::atomic<bool> scanning_flag_{ false }; // remove
 
+        // Parsed meta files by path relative to the scanned root
+        struct ScanCacheEntry
+        {
+            int64_t write_time = 0;     // file_time_type ticks
+            uintmax_t size = 0;
+            AssetMetaData meta;
+        };
+        std::unordered_map<std::string, ScanCacheEntry> scan_cache_;
+        std::optional<std::filesystem::path> scan_cache_root_;  // Root the cache belongs to
+        std::filesystem::path scan_cache_path_;
+        std::mutex scan_mutex_;     // One scan at a time, guards the scan cache
+        ScanStats last_scan_stats_; // Guarded by entries_mutex_
+
         std::vector<AssetEntry> scan_meta_files(
             const std::filesystem::path& root,
             EngineContext& ctx);
+
+        void load_scan_cache(const std::filesystem::path& file, EngineContext& ctx);
+        void save_scan_cache(const std::filesystem::path& file, EngineContext& ctx) const;
     };
     } // namespace eeng
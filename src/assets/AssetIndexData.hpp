@@ -4,6 +4,7 @@
 #pragma once
 
 #include "AssetEntry.hpp"
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
@@ -11,6 +12,8 @@ namespace eeng
 {
     struct AssetTreeViews;
     
+    /// Immutable once published: readers share it through AssetIndexDataPtr
+    /// and look entries up without copying them.
     struct AssetIndexData
     {
         std::vector<AssetEntry> entries;
@@ -20,7 +23,28 @@ namespace eeng
         std::unordered_map<Guid, std::vector<const AssetEntry*>> by_parent;
 
         std::shared_ptr<AssetTreeViews> trees;
+
+        /// @brief Build the lookup maps from entries, which must not change afterwards
+        void build_maps()
+        {
+            by_guid.clear();
+            by_type.clear();
+            by_parent.clear();
+            by_guid.reserve(entries.size());
+            for (const auto& entry : entries) {
+                by_guid[entry.meta.guid] = &entry;
+                by_type[entry.meta.type_id].push_back(&entry);
+                by_parent[entry.meta.guid_parent].push_back(&entry);
+            }
+        }
+
+        /// @brief Entry of an asset, or nullptr. O(1).
+        const AssetEntry* find(const Guid& guid) const
+        {
+            auto it = by_guid.find(guid);
+            return it == by_guid.end() ? nullptr : it->second;
+        }
     };
 
     using AssetIndexDataPtr = std::shared_ptr<const AssetIndexData>;
-}
\ No newline at end of file
+}
@@ -56,124 +56,170 @@ namespace eeng
         return AssetStatus{};
     }
 
+    // The _async variants run the coroutines below and hand out a future. Each
+    // operation owns gate_ from start to end, so operations stay exclusive even
+    // while one is suspended, as they were when a strand task blocked throughout.
+
     std::shared_future<TaskResult>
         ResourceManager::scan_assets_async(const std::filesystem::path& root, EngineContext& ctx)
     {
-        auto& s = strand(ctx);
-        auto* ctx_ptr = &ctx;            // avoid capturing a ref that could dangle
+        return spawn(co_scan_assets(root, ctx));
+    }
 
-        // capture root by value so it’s safe after return
-        return s.submit([this, root, ctx_ptr]() mutable -> TaskResult
-            {
-                TaskResult res;
-                res.type = TaskResult::TaskType::Scan;
+    std::shared_future<TaskResult>
+        ResourceManager::load_and_bind_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx)
+    {
+        return spawn(co_load_and_bind(std::move(guids), batch, ctx));
+    }
 
-                try
-                {
-                    auto data = asset_index_->scan_assets(root, *ctx_ptr); // blocking scan (no RM locks)
-                    const auto count = data ? data->entries.size() : 0;
+    std::shared_future<TaskResult>
+        ResourceManager::unbind_and_unload_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx)
+    {
+        return spawn(co_unbind_and_unload(std::move(guids), batch, ctx));
+    }
 
-                    {
-                        std::unique_lock lk(scan_mutex_);                 // 
-                        asset_index_->publish(std::move(data));           // atomic snapshot swap
-                    }
+    std::shared_future<TaskResult>
+        ResourceManager::reload_and_rebind_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx)
+    {
+        return spawn(co_reload_and_rebind(std::move(guids), batch, ctx));
+    }
 
-                    res.add_result(Guid{}, true, "Scan OK: " + std::to_string(count) + " assets");
-                }
-                catch (const std::exception& ex)
-                {
-                    res.add_result(Guid{}, false, ex.what());
-                }
-                // enqueue_event doesn't throw
-                (void)ctx_ptr->event_queue->enqueue_event(ResourceTaskCompletedEvent{ res });
-                return res;
-            });
+    CoTask<TaskResult> ResourceManager::co_scan_assets(std::filesystem::path root, EngineContext& ctx)
+    {
+        // Background lane, so a long scan doesn't hold up frame-critical work
+        auto lock = co_await gate_.lock(strand(ctx), TaskPriority::Background);
+        co_return scan_assets_step(root, ctx);
     }
 
-    std::shared_future<TaskResult>
-        ResourceManager::load_and_bind_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx)
+    CoTask<TaskResult> ResourceManager::co_load_and_bind(std::deque<Guid> guids, BatchId batch, EngineContext& ctx)
     {
-        auto& s = strand(ctx);
-        auto* ctx_ptr = &ctx; // avoid capturing a reference that might dangle
+        auto lock = co_await gate_.lock(strand(ctx));
 
-        return s.submit([this, guids = std::move(guids), batch, ctx_ptr]() mutable -> TaskResult
-            {
-                TaskResult res;
-                try
-                {
-                    res = this->load_and_bind_impl(std::move(guids), batch, *ctx_ptr);
-                }
-                catch (const std::exception& ex)
-                {
-                    res.type = TaskResult::TaskType::Load;
-                    res.add_result(Guid{}, false, ex.what());
-                }
-                catch (...)
-                {
-                    res.type = TaskResult::TaskType::Load;
-                    res.add_result(Guid{}, false, "unknown exception in load_and_bind_impl");
-                }
+        TaskResult res;
+        try
+        {
+            res = co_await load_and_bind_steps(std::move(guids), batch, ctx);
+        }
+        catch (const std::exception& ex)
+        {
+            res.type = TaskResult::TaskType::Load;
+            res.add_result(Guid{}, false, ex.what());
+        }
+        catch (...)
+        {
+            res.type = TaskResult::TaskType::Load;
+            res.add_result(Guid{}, false, "unknown exception in load_and_bind_steps");
+        }
 
-                (void)ctx_ptr->event_queue->enqueue_event(ResourceTaskCompletedEvent{ res });
-                return res;
-            });
+        (void)ctx.event_queue->enqueue_event(ResourceTaskCompletedEvent{ res });
+        co_return res;
     }
 
-    std::shared_future<TaskResult>
-        ResourceManager::unbind_and_unload_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx)
+    CoTask<TaskResult> ResourceManager::co_unbind_and_unload(std::deque<Guid> guids, BatchId batch, EngineContext& ctx)
     {
-        auto& s = strand(ctx);
-        auto* ctx_ptr = &ctx;
+        auto lock = co_await gate_.lock(strand(ctx));
 
-        return s.submit([this, guids = std::move(guids), batch, ctx_ptr]() mutable -> TaskResult
-            {
-                TaskResult res;
-                try
-                {
-                    res = this->unbind_and_unload_impl(std::move(guids), batch, *ctx_ptr);
-                }
-                catch (const std::exception& ex)
-                {
-                    res.type = TaskResult::TaskType::Unload;
-                    res.add_result(Guid{}, false, ex.what());
-                }
+        TaskResult res;
+        try
+        {
+            res = co_await unbind_and_unload_steps(std::move(guids), batch, ctx);
+        }
+        catch (const std::exception& ex)
+        {
+            res.type = TaskResult::TaskType::Unload;
+            res.add_result(Guid{}, false, ex.what());
+        }
 
-                (void)ctx_ptr->event_queue->enqueue_event(ResourceTaskCompletedEvent{ res });
-                return res;
-            });
+        (void)ctx.event_queue->enqueue_event(ResourceTaskCompletedEvent{ res });
+        co_return res;
     }
 
-    std::shared_future<TaskResult>
-        ResourceManager::reload_and_rebind_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx)
+    CoTask<TaskResult> ResourceManager::co_reload_and_rebind(std::deque<Guid> guids, BatchId batch, EngineContext& ctx)
     {
-        // tasks_in_flight_.fetch_add(1, std::memory_order_relaxed);
+        // One gated operation, so nothing runs between the unload and the load
+        auto lock = co_await gate_.lock(strand(ctx));
 
-        auto prom = std::make_shared<std::promise<TaskResult>>();
-        auto fut = prom->get_future().share();
+        TaskResult merged; merged.type = TaskResult::TaskType::Reload;
+        try {
+            TaskResult r1 = co_await unbind_and_unload_steps(guids, batch, ctx);
+            merged.results.insert(merged.results.end(), r1.results.begin(), r1.results.end());
 
-        strand(ctx).post([this, guids = std::move(guids), batch, &ctx, prom]() mutable {
-            TaskResult merged; merged.type = TaskResult::TaskType::Reload;
-            try {
-                // serialize inside the same strand task
-                TaskResult r1 = this->unbind_and_unload_impl(guids, batch, ctx);
-                merged.results.insert(merged.results.end(), r1.results.begin(), r1.results.end());
+            TaskResult r2 = co_await load_and_bind_steps(std::move(guids), batch, ctx);
+            merged.results.insert(merged.results.end(), r2.results.begin(), r2.results.end());
+        }
+        catch (const std::exception& ex) {
+            merged.add_result(Guid{}, false, ex.what());
+        }
+        (void)ctx.event_queue->enqueue_event(ResourceTaskCompletedEvent{ merged });
+        co_return merged;
+    }
 
-                TaskResult r2 = this->load_and_bind_impl(std::move(guids), batch, ctx);
-                merged.results.insert(merged.results.end(), r2.results.begin(), r2.results.end());
-            }
-            catch (const std::exception& ex) {
-                merged.add_result(Guid{}, false, ex.what());
+    TaskResult ResourceManager::scan_assets_step(const std::filesystem::path& root, EngineContext& ctx)
+    {
+        TaskResult res;
+        res.type = TaskResult::TaskType::Scan;
+
+        try
+        {
+            auto data = asset_index_->scan_assets(root, ctx); // blocking scan (no RM locks)
+            const auto count = data ? data->entries.size() : 0;
+
+            {
+                std::unique_lock lk(scan_mutex_);                 // 
+                asset_index_->publish(std::move(data));           // atomic snapshot swap
             }
-            (void)ctx.event_queue->enqueue_event(ResourceTaskCompletedEvent{ merged });
-            prom->set_value(std::move(merged));
-            });
 
-        return fut;
+            const auto stats = asset_index_->last_scan_stats();
+            res.add_result(Guid{}, true, "Scan OK: " + std::to_string(count) + " assets ("
+                + std::to_string(stats.parsed) + " parsed, " + std::to_string(stats.cached) + " cached)");
+        }
+        catch (const std::exception& ex)
+        {
+            res.add_result(Guid{}, false, ex.what());
+        }
+        // enqueue_event doesn't throw
+        (void)ctx.event_queue->enqueue_event(ResourceTaskCompletedEvent{ res });
+        return res;
+    }
+
+    OperationResult ResourceManager::load_one(const Guid& g, EngineContext& ctx)
+    {
+        using Op = OperationResult;
+
+        // auto& mx = mutex_for(g);
+        // std::lock_guard gguard(mx);
+
+        {   // status gate
+            std::lock_guard lk(status_mutex_);
+            auto& st = statuses_[g];
+            if (st.state == LoadState::Loading || st.state == LoadState::Loaded)
+                return Op{ g, true, "Load Ok" };
+            st.state = LoadState::Loading;
+            st.error_message.clear();
+        }
+        try {
+            this->load_asset(g, ctx);
+            { std::lock_guard lk(status_mutex_); statuses_[g].state = LoadState::Loaded; }
+            return Op{ g, true, "Load Ok" };
+        }
+        catch (const std::exception& ex) {
+            std::lock_guard lk(status_mutex_);
+            auto& st = statuses_[g];
+            st.state = LoadState::Failed;
+            st.error_message = ex.what();
+            return Op{ g, false, st.error_message };
+        }
+    }
+
+    CoTask<OperationResult> ResourceManager::co_load_one(Guid g, EngineContext& ctx)
+    {
+        co_await ctx.thread_pool->schedule();
+        co_return load_one(g, ctx);
     }
 
-    TaskResult ResourceManager::load_and_bind_impl(
+    CoTask<TaskResult> ResourceManager::load_and_bind_steps(
         std::deque<Guid> guids,
-        const BatchId& batch,
+        BatchId batch,
         EngineContext& ctx)
     {
         using Op = OperationResult;
@@ -186,50 +232,23 @@ namespace eeng
         // Acquire parent leases up-front so overlapping unloads can't drop them
         for (const Guid& g : guids) batch_acquire(batch, g);
 
-        // Parallel loads (status-gated)
-        std::vector<std::shared_future<Op>> loads;
+        // Parallel loads (status-gated). Awaiting them holds neither the strand
+        // nor a worker; the last load to finish resumes this coroutine.
+        std::vector<CoTask<Op>> loads;
         loads.reserve(guids.size());
-        for (const Guid& g : guids) {
-            loads.emplace_back(
-                ctx.thread_pool->queue_task([this, g, &ctx]() -> Op
-                    {
-                        // auto& mx = mutex_for(g);
-                        // std::lock_guard gguard(mx);
-
-                        {   // status gate
-                            std::lock_guard lk(status_mutex_);
-                            auto& st = statuses_[g];
-                            if (st.state == LoadState::Loading || st.state == LoadState::Loaded)
-                                return Op{ g, true, "Load Ok" };
-                            st.state = LoadState::Loading;
-                            st.error_message.clear();
-                        }
-                        try {
-                            this->load_asset(g, ctx);
-                            { std::lock_guard lk(status_mutex_); statuses_[g].state = LoadState::Loaded; }
-                            return Op{ g, true, "Load Ok" };
-                        }
-                        catch (const std::exception& ex) {
-                            std::lock_guard lk(status_mutex_);
-                            auto& st = statuses_[g];
-                            st.state = LoadState::Failed;
-                            st.error_message = ex.what();
-                            return Op{ g, false, st.error_message };
-                        }
-                    }).share()
-                        );
-        }
+        for (const Guid& g : guids)
+            loads.push_back(co_load_one(g, ctx));
+        const std::vector<Op> ops = co_await when_all(std::move(loads));
 
         // Collect load results
         std::unordered_set<Guid> failed; failed.reserve(guids.size());
-        for (auto& f : loads) {
-            Op op = f.get();
+        for (const Op& op : ops) {
             res.add_result(op.guid, op.success, op.message);
             if (!op.success) failed.insert(op.guid);
         }
 
-        // Bind phase (meta bind that takes batch)
-#if 1
+        // Bind phase (meta bind that takes batch), back on the strand
+        co_await strand(ctx).schedule();
         for (const Guid& g : guids)
         {
             // Skip bind if asset failed to load
@@ -270,59 +289,44 @@ namespace eeng
                 res.add_result(g, false, ex.what());
             }
         }
-#else
-        for (const Guid& g : guids) {
-            //if (failed.count(g)) { (void)batch_release(batch, g); continue; }
-            if (failed.count(g)) continue;
-
-            try {
-                // invoke_meta_function(g, batch, ctx, bind_asset_hs, "bind_asset_with_batch");
-                (void)invoke_meta_function(g, batch, ctx, literals::bind_asset_hs, "bind_asset");
-
-                res.add_result(g, true, "Bind Ok");
-            }
-            catch (const std::exception& ex) {
-                (void)batch_release(batch, g); // roll back parent lease if bind fails
-                res.add_result(g, false, ex.what());
-            }
-        }
-#endif
 
         // Optional asset hook after load/bind (main thread)
+        auto hook_guids = collect_hook_guids(guids, failed);
+        if (!hook_guids.empty())
         {
-            auto hook_guids = collect_hook_guids(guids, failed);
-            try_invoke_asset_hook_on_main(ctx, hook_guids, literals::on_create_hs, "on_create");
+            co_await ctx.main_thread();
+            invoke_asset_hook(ctx, hook_guids, literals::on_create_hs, "on_create");
         }
 
-        return res;
+        co_return res;
     }
 
-    TaskResult ResourceManager::unbind_and_unload_impl(
+    CoTask<TaskResult> ResourceManager::unbind_and_unload_steps(
         std::deque<Guid> guids,
-        const BatchId& batch,
+        BatchId batch,
         EngineContext& ctx)
     {
-        using Op = OperationResult;
         TaskResult res; res.type = TaskResult::TaskType::Unload;
-        size_t destroy_hook_count = 0;
 
         // Optional determinism:
         // std::sort(guids.begin(), guids.end());
         // guids.erase(std::unique(guids.begin(), guids.end()), guids.end());
 
+        // 1) Strand: drop leases, unbind and gate the assets to unload
+        std::vector<Guid> to_unload;
         for (const Guid& g : guids)
         {
             // auto& mx = mutex_for(g);
             // std::lock_guard gguard(mx);
 
-            // 1) Drop this batch’s lease for g. Only proceed if we’re the last holder.
+            // Drop this batch’s lease for g. Only proceed if we’re the last holder.
             const bool last = batch_release(batch, g);
             if (!last) {
                 res.add_result(g, true, "Lease remains (kept)");
                 continue;
             }
 
-            // 2) We are the last holder → unbind (idempotent; doesn’t touch leases in closure mode)
+            // We are the last holder → unbind (idempotent; doesn’t touch leases in closure mode)
             try {
                 (void)invoke_meta_function(g, batch, ctx, literals::unbind_asset_hs, "unbind_asset");
             }
@@ -332,7 +336,7 @@ namespace eeng
                 continue;
             }
 
-            // 3) Status gate + unload
+            // Status gate
             {
                 std::lock_guard lk(status_mutex_);
                 auto it = statuses_.find(g);
@@ -348,17 +352,35 @@ namespace eeng
                 st.state = LoadState::Unloading;
                 st.error_message.clear();
             }
+            to_unload.push_back(g);
+        }
+        if (to_unload.empty())
+            co_return res;
 
+        // 2) Main thread: optional asset hook before final unload, in one visit
+        std::vector<std::optional<std::string>> hook_errors(to_unload.size());
+        size_t destroy_hook_count = 0;
+        co_await ctx.main_thread();
+        for (size_t i = 0; i < to_unload.size(); ++i)
+        {
+            try {
+                if (try_invoke_meta_function(to_unload[i], ctx, literals::on_destroy_hs, "on_destroy").has_value())
+                    ++destroy_hook_count;
+            }
+            catch (const std::exception& ex) {
+                hook_errors[i] = ex.what();
+            }
+        }
+
+        // 3) Strand: unload
+        co_await strand(ctx).schedule();
+        for (size_t i = 0; i < to_unload.size(); ++i)
+        {
+            const Guid& g = to_unload[i];
             try
             {
-                // Optional asset hook before final unload (main thread)
-                bool invoked = false;
-                ctx.main_thread_queue->push_and_wait([&]()
-                    {
-                        invoked = try_invoke_meta_function(g, ctx, literals::on_destroy_hs, "on_destroy").has_value();
-                    });
-                if (invoked)
-                    ++destroy_hook_count;
+                if (hook_errors[i])
+                    throw std::runtime_error(*hook_errors[i]);
 
                 this->unload_asset(g, ctx);
 
@@ -381,15 +403,18 @@ namespace eeng
             EENG_LOG_INFO(&ctx, "Asset hook on_destroy complete: %zu invoked", destroy_hook_count);
         }
 
-        return res;
+        co_return res;
     }
 
     bool ResourceManager::is_busy() const {
+        // An operation suspended between steps leaves the strand idle but owns the gate
+        if (gate_.is_locked()) return true;
         std::scoped_lock lk(strand_mutex_);
         return rm_strand_ ? rm_strand_->is_busy() : false;
     }
 
     void ResourceManager::wait_until_idle() {
+        gate_.wait_idle();          // operations, including suspended ones
         std::unique_lock lk(strand_mutex_);
         if (!rm_strand_) return;
         auto* s = &*rm_strand_;
@@ -479,6 +504,22 @@ namespace eeng
         return *asset_index_;
     }
 
+    void ResourceManager::simulate_io_latency(const Guid& guid, EngineContext& ctx) const
+    {
+        if (!ctx.engine_config) return;
+        const auto& io = ctx.engine_config->io_latency();
+        if (!io.enabled()) return;
+
+        auto index_data = asset_index_->get_index_data();
+        const AssetEntry* entry = index_data ? index_data->find(guid) : nullptr;
+        if (!entry) return;
+
+        // Bandwidth-limited models scale with the size of the asset file
+        std::error_code ec;
+        const auto bytes = std::filesystem::file_size(entry->absolute_path, ec);
+        io.simulate(entry->meta.type_id, ec ? 0 : bytes);
+    }
+
     void ResourceManager::load_asset(const Guid& guid, EngineContext& ctx)
     {
         invoke_meta_function(guid, ctx, literals::load_asset_hs, "load_asset");
@@ -673,25 +714,19 @@ namespace eeng
         return result;
     }
 
-    void ResourceManager::try_invoke_asset_hook_on_main(
+    void ResourceManager::invoke_asset_hook(
         EngineContext& ctx,
         const std::vector<Guid>& guids,
         entt::hashed_string hook_id,
         std::string_view label
     )
     {
-        if (guids.empty())
-            return;
-
         size_t invoked_count = 0;
-        ctx.main_thread_queue->push_and_wait([&]()
-            {
-                for (const auto& g : guids)
-                {
-                    if (try_invoke_meta_function(g, ctx, hook_id, label).has_value())
-                        ++invoked_count;
-                }
-            });
+        for (const auto& g : guids)
+        {
+            if (try_invoke_meta_function(g, ctx, hook_id, label).has_value())
+                ++invoked_count;
+        }
 
         if (invoked_count > 0)
         {
@@ -4,6 +4,7 @@
 #pragma once
 #include "IResourceManager.hpp"
 #include "SerialExecutor.hpp"
+#include "AsyncMutex.hpp"
 #include "EngineContext.hpp"
 #include "Storage.hpp" // Can't pimpl-away since class is templated
 #include "AssetIndex.hpp"
@@ -39,6 +40,10 @@ namespace eeng
         mutable std::mutex              strand_mutex_;
         SerialExecutor& strand(EngineContext& ctx);   // helper
 
+        // Held by each operation from start to end, also while it is suspended
+        // off the strand (awaiting loads or the main thread)
+        AsyncMutex                      gate_;
+
         // Asset lease tracking
         struct AssetLease
         {
@@ -102,9 +107,24 @@ namespace eeng
         std::shared_future<TaskResult> unbind_and_unload_async(std::deque<Guid> branch_guids, const BatchId& batch, EngineContext& ctx) override;
         std::shared_future<TaskResult> reload_and_rebind_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx) override;
 
+        CoTask<TaskResult> co_scan_assets(std::filesystem::path root, EngineContext& ctx) override;
+        CoTask<TaskResult> co_load_and_bind(std::deque<Guid> branch_guids, BatchId batch, EngineContext& ctx) override;
+        CoTask<TaskResult> co_unbind_and_unload(std::deque<Guid> branch_guids, BatchId batch, EngineContext& ctx) override;
+        CoTask<TaskResult> co_reload_and_rebind(std::deque<Guid> guids, BatchId batch, EngineContext& ctx) override;
+
     private:
-        TaskResult load_and_bind_impl(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx);
-        TaskResult unbind_and_unload_impl(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx);
+        // Operation bodies, run while holding gate_. They start on the strand,
+        // await the parallel loads and hop to the main thread for asset hooks,
+        // and may throw.
+        CoTask<TaskResult> load_and_bind_steps(std::deque<Guid> guids, BatchId batch, EngineContext& ctx);
+        CoTask<TaskResult> unbind_and_unload_steps(std::deque<Guid> guids, BatchId batch, EngineContext& ctx);
+
+        // Load one asset on a worker (status-gated)
+        OperationResult load_one(const Guid& g, EngineContext& ctx);
+        CoTask<OperationResult> co_load_one(Guid g, EngineContext& ctx);
+
+        // Catches exceptions into the result and posts a ResourceTaskCompletedEvent
+        TaskResult scan_assets_step(const std::filesystem::path& root, EngineContext& ctx);
 
     public:
         // void retain_guid(const Guid& guid) override;
@@ -173,7 +193,8 @@ namespace eeng
             const T& t,
             const std::string& file_path,
             const AssetMetaData& meta,
-            const std::string& meta_file_path)
+            const std::string& meta_file_path,
+            EngineContext& ctx)
         {
             // EENG_LOG("[ResourceManager] Filing type: %s", typeid(T).name());
 
@@ -187,7 +208,7 @@ namespace eeng
                 });
 
             // Touches entt::meta
-            asset_index_->serialize_to_file<T>(t, _meta, file_path, meta_file_path);
+            asset_index_->serialize_to_file<T>(t, _meta, file_path, meta_file_path, ctx);
         }
 
         // TS?
@@ -210,7 +231,7 @@ namespace eeng
             if (storage_->handle_for_guid<T>(guid)) return;
 
             // Derserialize
-            /* add delay */ std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            simulate_io_latency(guid, ctx); // Off unless enabled in EngineConfig
             T asset = asset_index_->deserialize_from_file<T>(guid, ctx);
 
             // Add to storage (thread-safe)
@@ -233,7 +254,7 @@ namespace eeng
         /// @brief Re-serialize a loaded asset to disk using its existing GUID/path.
         /// @note Updates AssetMetaData::contained_assets based on current AssetRef links.
         template<typename T>
-        void save_loaded_asset(const Guid& guid)
+        void save_loaded_asset(const Guid& guid, EngineContext& ctx)
         {
             auto index = asset_index_->get_index_data();
             if (!index)
@@ -261,12 +282,15 @@ namespace eeng
                             meta.contained_assets.push_back(ref.guid);
                         });
 
-                    asset_index_->serialize_to_file<T>(asset, meta, asset_path, meta_path);
+                    asset_index_->serialize_to_file<T>(asset, meta, asset_path, meta_path, ctx);
                 });
         }
 
     private:
 
+        /// Sleeps according to ctx.engine_config->io_latency() for this asset's type and file size
+        void simulate_io_latency(const Guid& guid, EngineContext& ctx) const;
+
         void load_asset(const Guid& guid, EngineContext& ctx);
         void unload_asset(const Guid& guid, EngineContext& ctx);
 
@@ -455,7 +479,7 @@ namespace eeng
             bool valid = validate_asset(handle);
             if (!valid) return false;
 
-            storage_->modify(handle, [&](const T& asset)
+            storage_->read(handle, [&](const T& asset)
                 {
                     visit_asset_refs(asset, [&](const auto& asset_ref)
                         {
@@ -506,7 +530,8 @@ namespace eeng
             std::string_view function_label
         );
 
-        void try_invoke_asset_hook_on_main(
+        // Main thread only
+        void invoke_asset_hook(
             EngineContext& ctx,
             const std::vector<Guid>& guids,
             entt::hashed_string hook_id,
@@ -2,21 +2,32 @@
 // Licensed under the MIT License. See LICENSE file for details.
 
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <type_traits> // for std::is_copy_constructible etc.
 #include <typeindex>
 #include <memory>
 #include <string>
 #include <optional>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <tuple>
 
 #include "entt/entt.hpp"
 #include "MetaLiterals.h"
 #include "Handle.h"
 #include "Guid.h"
 #include "PoolAllocatorTFH.h"
+#include "FlatHashMap.h"
 
 namespace eeng
 {
@@ -77,61 +88,8 @@ namespace std {
 
 namespace eeng
 {
-    class VersionMap
-    {
-        std::vector<handle_ver_type> versions;
-
-    public:
-        VersionMap() = default;
-
-        // Assign version to handle (auto‐resizing internally)
-        template<typename T>
-        void assign_version(Handle<T>& handle)
-        {
-            assert(handle);
-            auto idx = handle.idx;
-            if (idx >= versions.size())
-                versions.resize(idx + 1, handle_ver_null);
-
-            auto& slot = versions[idx];
-            if (slot == handle_ver_null)
-                handle.ver = slot = 0;
-            else
-                handle.ver = slot;
-        }
-
-        // Validate that a handle’s version matches what we have
-        template<typename T>
-        bool validate(const Handle<T>& handle) const
-        {
-            if (handle.ver == handle_ver_null) return false;
-            auto idx = handle.idx;
-            if (idx >= versions.size()) return false;
-            return handle.ver == versions[idx];
-        }
-
-        // Bump the version (e.g. on removal)
-        template<typename T>
-        void remove(const Handle<T>& handle)
-        {
-            assert(handle);
-            auto idx = handle.idx;
-            assert(idx < versions.size());
-            ++versions[idx];
-        }
-
-        // Return a comma-separated list of all versions
-        std::string to_string() const
-        {
-            std::ostringstream oss;
-            for (auto v : versions)
-                oss << v << ", ";
-            std::string s = oss.str();
-            if (!s.empty())
-                s.resize(s.size() - 2);  // drop trailing ", "
-            return s;
-        }
-    };
+    /// Old -> new handle of every object moved by Storage::compact()
+    using HandleRemap = std::unordered_map<MetaHandle, MetaHandle>;
 
     class RefCountMap
     {
@@ -177,6 +135,16 @@ namespace eeng
             cnt = 0;
         }
 
+        // Move the counter of a relocated element (auto-resizing)
+        template<typename T>
+        void relocate(const Handle<T>& from, const Handle<T>& to)
+        {
+            assert(to);
+            size_t& cnt = ref_slot(from);
+            if (to.idx >= refs.size()) refs.resize(to.idx + 1, 0);
+            refs[to.idx] = std::exchange(cnt, 0);
+        }
+
         template<typename T>
         size_t count(const Handle<T>& handle) const
         {
@@ -202,8 +170,76 @@ namespace eeng
         using std::runtime_error::runtime_error;
     };
 
+    /// Memory held by the pool of one type
+    struct PoolMemoryUsage
+    {
+        entt::id_type type_id = 0;
+        size_t count = 0;           // Live objects
+        size_t inline_bytes = 0;    // Pool slots, live and free (capacity * sizeof(T))
+        size_t heap_bytes = 0;      // Owned by live objects, via the memory_usage meta hook
+        size_t peak_bytes = 0;      // Highest inline + heap so far
+        size_t budget_bytes = 0;    // 0 if no budget is set
+
+        size_t total_bytes() const { return inline_bytes + heap_bytes; }
+    };
+
+    /// Raised when the pool of a type grows past its memory budget.
+    /// Raised once per crossing: again only after usage drops below the budget.
+    struct MemoryBudgetExceededEvent
+    {
+        entt::id_type type_id = 0;
+        size_t total_bytes = 0;
+        size_t budget_bytes = 0;
+    };
+
     class Storage
     {
+        // Lock of one pool: shared for reads, exclusive for changes. Not
+        // recursive, also not for shared locking: a thread that takes it again
+        // while holding it is undefined behaviour, and deadlocks on
+        // writer-preferring implementations once a writer is queued in between.
+        // Debug builds assert on such re-entry.
+        class PoolMutex
+        {
+        public:
+            void lock() { enter(); m_mutex.lock(); }
+            bool try_lock() { enter(); if (m_mutex.try_lock()) return true; leave(); return false; }
+            void unlock() { m_mutex.unlock(); leave(); }
+
+            void lock_shared() { enter(); m_mutex.lock_shared(); }
+            bool try_lock_shared() { enter(); if (m_mutex.try_lock_shared()) return true; leave(); return false; }
+            void unlock_shared() { m_mutex.unlock_shared(); leave(); }
+
+        private:
+#ifndef NDEBUG
+            // Pool locks held by the calling thread
+            static std::vector<const PoolMutex*>& held() noexcept
+            {
+                thread_local std::vector<const PoolMutex*> locks;
+                return locks;
+            }
+
+            void enter() const
+            {
+                auto& locks = held();
+                assert(std::find(locks.begin(), locks.end(), this) == locks.end()
+                    && "Pool lock taken again by a thread that holds it");
+                locks.push_back(this);
+            }
+
+            void leave() const noexcept
+            {
+                auto& locks = held();
+                if (auto it = std::find(locks.begin(), locks.end(), this); it != locks.end())
+                    locks.erase(it);
+            }
+#else
+            void enter() const noexcept {}
+            void leave() const noexcept {}
+#endif
+            std::shared_mutex m_mutex;
+        };
+
         class IPool
         {
         public:
@@ -213,6 +249,7 @@ namespace eeng
 
             virtual entt::meta_any get_meta_ref(const MetaHandle& meta_handle) = 0;
             virtual entt::meta_any get_meta_ref(const MetaHandle& meta_handle) const = 0;
+            virtual entt::meta_any get_meta_ref_nolock(const MetaHandle& meta_handle) = 0;
 
             virtual std::optional<entt::meta_any> try_get_meta_ref(const MetaHandle& mh) noexcept = 0;
             virtual std::optional<entt::meta_any> try_get_meta_ref(const MetaHandle& mh) const noexcept = 0;
@@ -224,8 +261,15 @@ namespace eeng
             virtual size_t element_size() const noexcept = 0;
             virtual size_t count_free() const noexcept = 0;
             virtual size_t capacity() const noexcept = 0;
+            virtual PoolMemoryUsage memory_usage() const noexcept = 0;
+            // As memory_usage(), numbered: a higher number is a newer state of the pool
+            virtual PoolMemoryUsage memory_usage(uint64_t& sample) const noexcept = 0;
+            virtual void remeasure_nolock(const MetaHandle& mh) = 0;
+            virtual void refresh_memory_usage() = 0;
+            virtual PoolMutex& mutex() const noexcept = 0;
             virtual bool valid(const MetaHandle& mh) const noexcept = 0;
             virtual void clear() noexcept = 0;
+            virtual void compact(HandleRemap& remap) = 0;
 
             virtual std::optional<MetaHandle> handle_for_guid(const Guid& guid) const noexcept = 0;
             virtual std::optional<Guid> guid_for_handle(const MetaHandle& mh) const noexcept = 0;
@@ -240,16 +284,30 @@ namespace eeng
         {
             // using Handle = Handle<T>;
 
-            PoolAllocatorTFH<T> m_pool;
+            // Chunked growth: elements never move, so references returned by
+            // get_ref() stay valid while other elements are added. Handle
+            // generations live beside each chunk's slots: validating a handle
+            // is one load, lock-free, and safe while other elements are added
+            PoolAllocatorTFH<T> m_pool{ 0, PoolGrowth::Chunked };
+
+            // Old -> current handle of every object moved by compact(), so handles
+            // taken before a compaction keep resolving. Written only by compact().
+            FlatHashMap<Handle<T>, Handle<T>> m_forwards;
 
-            VersionMap m_versions;
             RefCountMap m_ref_counts;
 
-            std::unordered_map<Guid, Handle<T>> m_guid_to_handle;
-            std::unordered_map<Handle<T>, Guid> m_handle_to_guid;
+            FlatHashMap<Guid, Handle<T>> m_guid_to_handle;
+            std::vector<Guid> m_guids;  // By slot index, invalid for a free slot
+
+            // Heap bytes of each live object by slot, as last measured
+            std::vector<size_t> m_heap_bytes;
+            size_t m_heap_total = 0;
+            size_t m_peak_bytes = 0;
+            mutable std::atomic<uint64_t> m_usage_samples{ 0 };
 
-            // mutable std::mutex m_mutex;
-            mutable std::recursive_mutex m_mutex;
+            // Shared for lookups and reads, exclusive for changes.
+            // Not recursive, see PoolMutex.
+            mutable PoolMutex m_mutex;
 
         public:
 
@@ -286,11 +344,10 @@ namespace eeng
         private:
             Handle<T> typed_add_no_lock(const Guid& guid, T&& object)
             {
-                auto handle = m_pool.create(std::forward<T>(object));  // one move
-                m_versions.assign_version(handle);
+                auto handle = m_pool.create(std::forward<T>(object));  // one move, generation assigned
                 m_ref_counts.add_ref(handle);
-                m_guid_to_handle[guid] = handle;
-                m_handle_to_guid[handle] = guid;
+                bind_guid_no_lock(handle, guid);
+                track_heap_bytes_no_lock(handle.idx, measure_heap_bytes(m_pool.get(handle)));
                 return handle;
             }
 
@@ -300,56 +357,71 @@ namespace eeng
 
             T& get_ref(const Handle<T>& handle)
             {
-                std::lock_guard lock{ m_mutex };
-                if (!validate_handle_no_lock(handle)) throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
-                return m_pool.get(handle);
+                std::shared_lock lock{ m_mutex };
+                return get_ref_nolock(handle);
             }
 
             const T& get_ref(const Handle<T>& handle) const
             {
-                std::lock_guard lock{ m_mutex };
-                if (!validate_handle_no_lock(handle)) throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
-                return m_pool.get(handle);
+                std::shared_lock lock{ m_mutex };
+                return get_ref_nolock(handle);
             }
 
             /// @brief Unsafe, no‑lock reference access. Caller must ensure no concurrent
-            ///        add/release on the same slot.
+            ///        release of this object, and no concurrent compact() or clear().
+            ///        Concurrent adds are fine: validation reads only the slot's
+            ///        generation, and neither it nor the object moves as the pool grows.
             T& get_ref_nolock(const Handle<T>& handle)
             {
-                if (!validate_handle_no_lock(handle)) throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
+                const auto current = validate_handle_no_lock(handle);
+                if (!current) throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
                 // validate without locking
                 // MetaHandle mh{ handle };
                 // auto opt = validate_handle_no_lock(mh);
                 // if (!opt || *opt != handle) {
                 //     throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
                 // }
-                return m_pool.get(handle);
+                return m_pool.get(*current);
             }
 
             /// @brief Unsafe const reference access.
             const T& get_ref_nolock(const Handle<T>& handle) const
             {
-                if (!validate_handle_no_lock(handle)) throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
+                const auto current = validate_handle_no_lock(handle);
+                if (!current) throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
 
                 // MetaHandle mh{ handle };
                 // auto opt = validate_handle_no_lock(mh);
                 // if (!opt || *opt != handle) {
                 //     throw ValidationError{ "Invalid or not-ready Handle in get_ref_nolock" };
                 // }
-                return m_pool.get(handle);
+                return m_pool.get(*current);
+            }
+
+            /// @brief Unsafe const access that does not throw. nullptr if the handle is stale.
+            const T* try_get_nolock(const Handle<T>& handle) const noexcept
+            {
+                const auto current = validate_handle_no_lock(handle);
+                return current ? &m_pool.get(*current) : nullptr;
             }
 
             // --- Meta typed get & try_get ------------------------------------
 
             entt::meta_any get_meta_ref(const MetaHandle& meta_handle) override
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 return get_impl(*this, meta_handle);
             }
 
             entt::meta_any get_meta_ref(const MetaHandle& meta_handle) const override
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
+                return get_impl(*this, meta_handle);
+            }
+
+            /// @brief Unsafe, no-lock access. Caller holds mutex().
+            entt::meta_any get_meta_ref_nolock(const MetaHandle& meta_handle) override
+            {
                 return get_impl(*this, meta_handle);
             }
 
@@ -386,7 +458,7 @@ namespace eeng
                 PoolType& self,
                 const MetaHandle& meta_handle) noexcept
             {
-                std::lock_guard lock{ self.m_mutex };
+                std::shared_lock lock{ self.m_mutex };
                 if (auto opt = self.validate_handle_no_lock(meta_handle)) {
                     return entt::forward_as_meta(self.m_pool.get(*opt));
                 }
@@ -397,20 +469,19 @@ namespace eeng
             // -----------------------------------------------------------------
 
             /// @brief Remove this object immediately (statically typed).
-            void remove_now(const Handle<T>& h)
+            void remove_now(const Handle<T>& handle)
             {
                 std::lock_guard lock{ m_mutex };
-                if (!validate_handle_no_lock(h)) {
+                const auto h = validate_handle_no_lock(handle);
+                if (!h) {
                     throw ValidationError{ "Invalid or not‐ready Handle in remove_now_typed" };
                 }
-                // erase maps & version/refcount, destroy storage
-                auto gid = m_handle_to_guid.at(h);
-                m_handle_to_guid.erase(h);
-                m_guid_to_handle.erase(gid);
+                // erase maps & refcount, destroy storage (bumps the slot's generation)
+                unbind_guid_no_lock(*h);
 
-                m_versions.remove(h);
-                m_ref_counts.reset(h);
-                m_pool.destroy(h);
+                m_ref_counts.reset(*h);
+                track_heap_bytes_no_lock(h->idx, 0);
+                m_pool.destroy(*h);
             }
 
             void remove_now(const MetaHandle& mh) override
@@ -421,20 +492,19 @@ namespace eeng
                 if (!opt) throw ValidationError{ "Invalid or not‐ready MetaHandle" };
                 auto handle = *opt;
 
-                auto gid = m_handle_to_guid[handle];
-                m_handle_to_guid.erase(handle);
-                m_guid_to_handle.erase(gid);
+                unbind_guid_no_lock(handle);
 
-                m_versions.remove(handle);
                 m_ref_counts.reset(handle);
+                track_heap_bytes_no_lock(handle.idx, 0);
                 m_pool.destroy(handle);
             }
 
-            size_t retain(const Handle<T>& h)
+            size_t retain(const Handle<T>& handle)
             {
                 std::lock_guard lock{ m_mutex };
-                if (!validate_handle_no_lock(h)) throw ValidationError{ "Bad handle" };
-                return m_ref_counts.add_ref(h);
+                const auto h = validate_handle_no_lock(handle);
+                if (!h) throw ValidationError{ "Bad handle" };
+                return m_ref_counts.add_ref(*h);
             }
 
             size_t retain(const MetaHandle& mh) override
@@ -445,18 +515,17 @@ namespace eeng
                 return m_ref_counts.add_ref(*opt);
             }
 
-            size_t release_and_destroy(const Handle<T>& h)
+            size_t release_and_destroy(const Handle<T>& handle)
             {
                 std::lock_guard lock{ m_mutex };
-                if (!validate_handle_no_lock(h)) throw ValidationError{ "Bad handle" };
-                auto cnt = m_ref_counts.release(h);
+                const auto h = validate_handle_no_lock(handle);
+                if (!h) throw ValidationError{ "Bad handle" };
+                auto cnt = m_ref_counts.release(*h);
                 if (cnt == 0) {
-                    auto guid = m_handle_to_guid[h];
-                    m_guid_to_handle.erase(guid);
-                    m_handle_to_guid.erase(h);
-                    m_versions.remove(h);
-                    m_ref_counts.reset(h);
-                    m_pool.destroy(h);
+                    unbind_guid_no_lock(*h);
+                    m_ref_counts.reset(*h);
+                    track_heap_bytes_no_lock(h->idx, 0);
+                    m_pool.destroy(*h);
                 }
                 return cnt;
             }
@@ -475,11 +544,9 @@ namespace eeng
 
                 // if this was the last reference, tear everything down
                 if (cnt == 0) {
-                    auto gid = m_handle_to_guid[handle];
-                    m_handle_to_guid.erase(handle);
-                    m_guid_to_handle.erase(gid);
-                    m_versions.remove(handle);
+                    unbind_guid_no_lock(handle);
                     m_ref_counts.reset(handle);
+                    track_heap_bytes_no_lock(handle.idx, 0);
                     m_pool.destroy(handle);
                 }
 
@@ -493,29 +560,85 @@ namespace eeng
 
             size_t count_free() const noexcept override
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 return m_pool.count_free();
             }
 
             size_t capacity() const noexcept override
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 return m_pool.capacity();
             }
 
-            bool valid(const Handle<T>& h) const noexcept
+            // --- Memory accounting -------------------------------------------
+
+            /// @brief Inline, heap and peak bytes of this pool. O(1).
+            /// @note Heap bytes are measured when an object is added and when it is
+            ///       changed through Storage::modify(). Changes made through get_ref()
+            ///       are seen after modify() or refresh_memory_usage().
+            PoolMemoryUsage memory_usage() const noexcept override
+            {
+                uint64_t sample;
+                return memory_usage(sample);
+            }
+
+            PoolMemoryUsage memory_usage(uint64_t& sample) const noexcept override
+            {
+                // Numbered under the lock: changes need it exclusively, so sample
+                // order follows the order of the states sampled
+                std::shared_lock lock{ m_mutex };
+                sample = ++m_usage_samples;
+                PoolMemoryUsage usage;
+                usage.count = m_pool.count_used();
+                usage.inline_bytes = inline_bytes_no_lock();
+                usage.heap_bytes = m_heap_total;
+                usage.peak_bytes = m_peak_bytes;
+                return usage;
+            }
+
+            /// @brief Measure the heap bytes of one object again.
+            ///        Caller holds mutex() exclusively.
+            void remeasure_nolock(const Handle<T>& handle)
+            {
+                const auto h = validate_handle_no_lock(handle);
+                if (!h) throw ValidationError{ "Bad handle" };
+                track_heap_bytes_no_lock(h->idx, measure_heap_bytes(m_pool.get(*h)));
+            }
+
+            void remeasure_nolock(const MetaHandle& mh) override
+            {
+                auto opt = validate_handle_no_lock(mh);
+                if (!opt) throw ValidationError{ "Invalid or not-ready MetaHandle" };
+                track_heap_bytes_no_lock(opt->idx, measure_heap_bytes(m_pool.get(*opt)));
+            }
+
+            /// @brief Measure the heap bytes of every live object again. O(N).
+            void refresh_memory_usage() override
             {
                 std::lock_guard lock{ m_mutex };
-                return validate_handle_no_lock(h) && m_handle_to_guid.contains(h);
+                for (size_t idx = 0; idx < m_guids.size(); ++idx)
+                    if (m_guids[idx].valid())
+                        track_heap_bytes_no_lock(idx, measure_heap_bytes(m_pool.get(Handle<T>{ idx })));
+            }
+
+            /// @brief The pool's lock, for Storage to hold across a read or modify callback
+            PoolMutex& mutex() const noexcept override
+            {
+                return m_mutex;
+            }
+
+            bool valid(const Handle<T>& handle) const noexcept
+            {
+                std::shared_lock lock{ m_mutex };
+                const auto h = validate_handle_no_lock(handle);
+                return h && guid_at_no_lock(h->idx).valid();
             }
 
             bool valid(const MetaHandle& mh) const noexcept override
             {
-                std::lock_guard lock{ m_mutex };
-                if (auto typed_handle = mh.template cast<T>()) {
-                    return validate_handle_no_lock(*typed_handle) && m_handle_to_guid.contains(*typed_handle);
-                }
-                return false;
+                std::shared_lock lock{ m_mutex };
+                const auto h = validate_handle_no_lock(mh);
+                return h && guid_at_no_lock(h->idx).valid();
             }
 
             void clear() noexcept override
@@ -524,34 +647,69 @@ namespace eeng
 
                 m_pool.clear();
 
-                m_versions = VersionMap{};
+                m_forwards.clear();
                 m_ref_counts = RefCountMap{};
 
                 m_guid_to_handle.clear();
-                m_handle_to_guid.clear();
+                m_guids.clear();
+
+                m_heap_bytes.clear();
+                m_heap_total = 0;
+            }
+
+            /// @brief Move live objects to the lowest slots and release the free tail.
+            /// @return Old and new handle of every moved object. Old handles keep
+            ///         resolving to the moved object; GUID lookups return the new ones.
+            std::vector<std::pair<Handle<T>, Handle<T>>> compact()
+            {
+                std::lock_guard lock{ m_mutex };
+
+                std::vector<std::pair<Handle<T>, Handle<T>>> remap;
+                for (const PoolMove& move : m_pool.compact())
+                {
+                    const Handle<T> old_handle{ move.from, move.from_ver };
+                    const Handle<T> new_handle{ move.to, move.to_ver };
+                    m_ref_counts.relocate(old_handle, new_handle);
+                    if (move.from < m_heap_bytes.size())
+                        m_heap_bytes[move.to] = std::exchange(m_heap_bytes[move.from], 0);
+
+                    const Guid guid = guid_at_no_lock(move.from);
+                    if (guid.valid())
+                    {
+                        unbind_guid_no_lock(old_handle);
+                        bind_guid_no_lock(new_handle, guid);
+                    }
+                    remap.emplace_back(old_handle, new_handle);
+                }
+                m_heap_bytes.resize(std::min(m_heap_bytes.size(), m_pool.capacity()));
+                m_guids.resize(std::min(m_guids.size(), m_pool.capacity()));
+                forward_no_lock(remap);
+                return remap;
+            }
+
+            void compact(HandleRemap& remap) override
+            {
+                for (const auto& [old_handle, new_handle] : compact())
+                    remap.emplace(MetaHandle{ old_handle }, MetaHandle{ new_handle });
             }
 
             /// @brief Find the handle associated to a GUID, statically typed.
             /// @returns an empty optional if no such GUID or wrong type.
             std::optional<Handle<T>> typed_handle_for_guid(const Guid& guid) const noexcept
             {
-                std::lock_guard lock{ m_mutex };
-                auto it = m_guid_to_handle.find(guid);
-                if (it == m_guid_to_handle.end()) {
+                std::shared_lock lock{ m_mutex };
+                const Handle<T>* found = m_guid_to_handle.find(guid);
+                if (!found) {
                     return std::nullopt;
                 }
-                Handle<T> h = it->second;
-                return validate_handle_no_lock(h)
-                    ? std::optional<Handle<T>>(h)
-                    : std::nullopt;
+                return validate_handle_no_lock(*found);
             }
 
             std::optional<MetaHandle> handle_for_guid(const Guid& guid) const noexcept override
             {
-                std::lock_guard lock{ m_mutex };
-                auto it = m_guid_to_handle.find(guid);
-                if (it != m_guid_to_handle.end()) {
-                    MetaHandle mh{ it->second };
+                std::shared_lock lock{ m_mutex };
+                if (const Handle<T>* found = m_guid_to_handle.find(guid)) {
+                    MetaHandle mh{ *found };
                     if (auto h = validate_handle_no_lock(mh))
                         return mh;
                 }
@@ -560,25 +718,26 @@ namespace eeng
 
             /// @brief Find the GUID associated to a `Handle<T>`.
             /// @returns empty if invalid or not in this pool.
-            std::optional<Guid> guid_for_handle_typed(const Handle<T>& h) const noexcept {
-                std::lock_guard lock{ m_mutex };
-                if (!validate_handle_no_lock(h)) {
+            std::optional<Guid> guid_for_handle_typed(const Handle<T>& handle) const noexcept {
+                std::shared_lock lock{ m_mutex };
+                const auto h = validate_handle_no_lock(handle);
+                if (!h) {
                     return std::nullopt;
                 }
-                auto it = m_handle_to_guid.find(h);
-                return it != m_handle_to_guid.end()
-                    ? std::optional<Guid>(it->second)
+                const Guid guid = guid_at_no_lock(h->idx);
+                return guid.valid()
+                    ? std::optional<Guid>(guid)
                     : std::nullopt;
             }
 
             std::optional<Guid> guid_for_handle(const MetaHandle& mh) const noexcept override
             {
-                std::lock_guard lock{ m_mutex };
-                // First check that this handle is still valid under our versions map
+                std::shared_lock lock{ m_mutex };
+                // First check that this handle is still valid (or was moved)
                 if (auto h = validate_handle_no_lock(mh)) {
-                    auto it = m_handle_to_guid.find(*h);
-                    if (it != m_handle_to_guid.end())
-                        return it->second;
+                    const Guid guid = guid_at_no_lock(h->idx);
+                    if (guid.valid())
+                        return guid;
                 }
                 return std::nullopt;
             }
@@ -587,11 +746,13 @@ namespace eeng
 
             /// @brief Visit all objects of this static type in the pool.
             /// @param visitor A function that takes a const reference to T
+            /// @note Live objects are found through the allocator's occupancy bitmap;
+            ///       free slots are not touched.
             /// @note Risk for deadlock if visitor re-enters storage
             template<class F>
             void visit(F&& visitor) const noexcept
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 m_pool.used_visitor(std::forward<F>(visitor));
             }
 
@@ -610,7 +771,7 @@ namespace eeng
             /// @note Risk for deadlock if visitor re-enters storage
             void visit_any(const std::function<void(entt::meta_any)>& visitor) const noexcept override
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 m_pool.used_visitor([&](const T& elem) {
                     visitor(entt::forward_as_meta(elem));
                     });
@@ -633,10 +794,10 @@ namespace eeng
             /// @note Thread-safe, but may block if used in a visitor.
             std::string to_string() const override
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 std::ostringstream oss;
                 oss << "  entries: " << m_guid_to_handle.size() << "\n";
-                oss << "  versions:  " << m_versions.to_string() << "\n";
+                oss << "  forwards:  " << m_forwards.size() << "\n";
                 oss << "  ref-counts:" << m_ref_counts.to_string() << "\n";
                 oss << "  allocator:\n" << m_pool.to_string();
                 return oss.str();
@@ -644,16 +805,93 @@ namespace eeng
 
         private:
 
+            size_t inline_bytes_no_lock() const noexcept
+            {
+                return m_pool.capacity() * sizeof(T);
+            }
+
+            // Heap bytes owned by an object, through its memory_usage meta hook.
+            // Types without the hook report 0.
+            static size_t measure_heap_bytes(const T& object)
+            {
+                entt::meta_func meta_func = entt::resolve<T>().func(literals::memory_usage_hs);
+                if (!meta_func) return 0;
+                entt::meta_any bytes = meta_func.invoke({}, entt::forward_as_meta(object));
+                if (auto* value = bytes.try_cast<size_t>()) return *value;
+                return 0;
+            }
+
+            void track_heap_bytes_no_lock(size_t idx, size_t bytes)
+            {
+                if (idx >= m_heap_bytes.size()) m_heap_bytes.resize(idx + 1, 0);
+                m_heap_total = m_heap_total - m_heap_bytes[idx] + bytes;
+                m_heap_bytes[idx] = bytes;
+                m_peak_bytes = std::max(m_peak_bytes, inline_bytes_no_lock() + m_heap_total);
+            }
+
             inline bool map_contains(const auto& map, const auto& key)
             {
                 return map.find(key) != map.end();
             }
 
-            // Validation without locking or throwing
-            bool validate_handle_no_lock(
+            // --- GUID maps ---------------------------------------------------
+
+            void bind_guid_no_lock(const Handle<T>& handle, const Guid& guid)
+            {
+                if (m_guids.size() <= handle.idx)
+                    m_guids.resize(handle.idx + 1);
+                m_guids[handle.idx] = guid;
+                m_guid_to_handle.insert_or_assign(guid, handle);
+            }
+
+            void unbind_guid_no_lock(const Handle<T>& handle)
+            {
+                const Guid guid = guid_at_no_lock(handle.idx);
+                if (!guid.valid()) return;
+                m_guids[handle.idx] = Guid::invalid();
+                // The GUID may have been re-added since: only drop our own entry
+                if (const Handle<T>* mapped = m_guid_to_handle.find(guid); mapped && *mapped == handle)
+                    m_guid_to_handle.erase(guid);
+            }
+
+            Guid guid_at_no_lock(size_t idx) const noexcept
+            {
+                return idx < m_guids.size() ? m_guids[idx] : Guid::invalid();
+            }
+
+            // Validation without locking or throwing: the handle if it is current,
+            // the moved object's handle if it was taken before a compaction
+            std::optional<Handle<T>> validate_handle_no_lock(
                 const Handle<T>& handle) const noexcept
             {
-                return handle && m_versions.validate(handle);
+                if (m_pool.is_current(handle)) return handle;
+                if (m_forwards.empty()) return std::nullopt;
+                if (const Handle<T>* moved = m_forwards.find(handle); moved && m_pool.is_current(*moved))
+                    return *moved;
+                return std::nullopt;
+            }
+
+            // Add the moves of a compaction to the forwards. Earlier forwards to a
+            // moved object follow it; those to removed objects are dropped.
+            void forward_no_lock(const std::vector<std::pair<Handle<T>, Handle<T>>>& moves)
+            {
+                FlatHashMap<Handle<T>, Handle<T>> moved;
+                moved.reserve(moves.size());
+                for (const auto& [old_handle, new_handle] : moves)
+                    moved.insert_or_assign(old_handle, new_handle);
+
+                FlatHashMap<Handle<T>, Handle<T>> forwards;
+                forwards.reserve(m_forwards.size() + moves.size());
+                for (const auto& [old_handle, target] : m_forwards)
+                {
+                    const Handle<T>* now = moved.find(target);
+                    const Handle<T> current = now ? *now : target;
+                    if (m_pool.is_current(current))
+                        forwards.insert_or_assign(old_handle, current);
+                }
+                for (const auto& [old_handle, new_handle] : moves)
+                    forwards.insert_or_assign(old_handle, new_handle);
+                m_forwards = std::move(forwards);
             }
 
             // Validation without locking or throwing
@@ -661,12 +899,8 @@ namespace eeng
                 const MetaHandle& meta_handle) const noexcept
             {
                 if (!meta_handle.valid()) return {};
-                // if (auto h = meta_handle.template cast<T>(); h && *h && m_versions.validate(*h))
-                // if (auto h = meta_handle.template cast<T>(); h && validate_handle_no_lock(*h))
-                //     return *h;
                 if (auto h = meta_handle.template cast<T>())
-                    if (validate_handle_no_lock(*h))
-                        return *h;
+                    return validate_handle_no_lock(*h);
 
                 return {};
             }
@@ -674,7 +908,7 @@ namespace eeng
             std::optional<Handle<T>> validate_handle(
                 const MetaHandle& meta_handle) const noexcept
             {
-                std::lock_guard lock{ m_mutex };
+                std::shared_lock lock{ m_mutex };
                 return validate_handle_no_lock(meta_handle);
             }
         };
@@ -687,7 +921,7 @@ namespace eeng
         // Explicit move-ctor: steal pools under lock, leave a fresh mutex
         Storage(Storage&& other) noexcept {
             std::lock_guard lock{ other.storage_mutex };
-            pools = std::move(other.pools);
+            steal_no_lock(other);
             // other.storage_mutex stays valid (default-constructed)
         }
 
@@ -695,7 +929,7 @@ namespace eeng
         Storage& operator=(Storage&& other) noexcept {
             if (this != &other) {
                 std::scoped_lock lock{ storage_mutex, other.storage_mutex };
-                pools = std::move(other.pools);
+                steal_no_lock(other);
             }
             return *this;
         }
@@ -706,19 +940,23 @@ namespace eeng
         bool has_storage() const noexcept
         {
             entt::id_type meta_id = get_id_type<T>();
-            return pools.find(meta_id) != pools.end();
+            return find_pool(meta_id) != nullptr;
         }
 
-        /// Make sure a pool exists. Used by meta types. Not thread-safe.
+        /// Make sure a pool exists. Used by meta types (thread-safe).
         template<typename T>
         entt::id_type assure_storage()
         {
             //auto meta_type = entt::resolve<T>();
             entt::id_type meta_id = get_id_type<T>();
+            if (find_pool(meta_id)) return meta_id;
 
+            std::lock_guard lock{ storage_mutex };
             if (pools.find(meta_id) == pools.end())
             {
-                pools[meta_id] = std::make_unique<Pool<T>>();
+                auto pool = std::make_unique<Pool<T>>();
+                publish_pool_no_lock(meta_id, pool.get());
+                pools[meta_id] = std::move(pool);
 
                 // Debug log
                 // std::string type_name(type.info().name());
@@ -737,40 +975,45 @@ namespace eeng
             const T& t,
             const Guid& guid)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_or_create_pool<T>();
-            return pool.add(t, guid);
+            auto handle = pool.add(t, guid);
+            check_memory_budget(get_id_type<T>());
+            return handle;
         }
 
         /// @brief Add statically typed object as rvalue (thread-safe)
         /// @return A copy of the requested object
         template<typename T>
             requires(!std::is_same_v<std::decay_t<T>, entt::meta_any>)
-        Handle<T> add(
+        Handle<std::remove_cvref_t<T>> add(
             T&& t,
             const Guid& guid)
         {
-            std::lock_guard lock{ storage_mutex };
-            auto& pool = get_or_create_pool<std::remove_cv_t<std::remove_reference_t<T>>>();
-            return pool.add(std::forward<T>(t), guid);
+            using U = std::remove_cv_t<std::remove_reference_t<T>>;
+            auto& pool = get_or_create_pool<U>();
+            auto handle = pool.add(std::forward<T>(t), guid);
+            check_memory_budget(get_id_type<U>());
+            return handle;
         }
 
         // --- Meta typed add --------------------------------------------------
 
-        /// @brief Add runtime typed object as lvalue (not thread-safe)
+        /// @brief Add runtime typed object as lvalue (thread-safe)
         MetaHandle add(const entt::meta_any& data, const Guid& guid)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_or_create_pool(data.type());
-            return pool.add(guid, data); // lvalue
+            auto mh = pool.add(guid, data); // lvalue
+            check_memory_budget(mh.type.id());
+            return mh;
         }
 
-        /// @brief Add runtime typed object as rvalue (not thread-safe)
+        /// @brief Add runtime typed object as rvalue (thread-safe)
         MetaHandle add(entt::meta_any&& data, const Guid& guid)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_or_create_pool(data.type());
-            return pool.add(guid, std::move(data));  // rvalue
+            auto mh = pool.add(guid, std::move(data));  // rvalue
+            check_memory_budget(mh.type.id());
+            return mh;
         }
 
         // --- Meta typed get --------------------------------------------------
@@ -779,7 +1022,6 @@ namespace eeng
         /// @return An entt::meta_any with a const reference to the requested object
         entt::meta_any get_meta_ref(const MetaHandle& meta_handle) const
         {
-            std::lock_guard lock{ storage_mutex };
             return get_pool(meta_handle.type.id()).get_meta_ref(meta_handle);
         }
 
@@ -787,7 +1029,6 @@ namespace eeng
         /// @return An entt::meta_any with a reference to the requested object
         entt::meta_any get_meta_ref(const MetaHandle& meta_handle)
         {
-            std::lock_guard lock{ storage_mutex };
             return get_pool(meta_handle.type.id()).get_meta_ref(meta_handle);
         }
 
@@ -798,16 +1039,16 @@ namespace eeng
         template<typename T>
         T get_val(const Handle<T>& h) const
         {
-            std::lock_guard lk{ storage_mutex };
             return get_pool<T>().get_ref(h);
         }
 
-        /// @brief Reference‑returning, statically‑typed get (unsafe if allowing
-        /// concurrent add/release on the same type).
+        /// @brief Reference‑returning, statically‑typed get. Takes no lock: safe
+        /// while other objects of the type are added, unsafe if the object may be
+        /// released, or the pool compacted or cleared, concurrently.
         template<typename T>
         T& get_ref(const Handle<T>& h)
         {
-            // no internal lock: user must externally guard against races on this slot
+            // no internal lock: user must externally guard against releases of this object
             return get_pool<T>().get_ref_nolock(h);
         }
 
@@ -821,34 +1062,33 @@ namespace eeng
 
         std::optional<entt::meta_any> try_get_meta_ref(const MetaHandle& meta_handle) const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
-            auto it = pools.find(meta_handle.type.id());
-            if (it == pools.end()) return std::nullopt;
-
-            const IPool& pool = *it->second;
-            return pool.try_get_meta_ref(meta_handle);
+            const IPool* pool = find_pool(meta_handle.type.id());
+            if (!pool) return std::nullopt;
+            return pool->try_get_meta_ref(meta_handle);
         }
 
         std::optional<entt::meta_any> try_get_meta_ref(const MetaHandle& meta_handle) noexcept
         {
-            std::lock_guard lock{ storage_mutex };
-            auto it = pools.find(meta_handle.type.id());
-            if (it == pools.end()) return std::nullopt;
-
-            auto& pool = get_pool(meta_handle.type.id());
-            return pool.try_get_meta_ref(meta_handle);
+            IPool* pool = find_pool(meta_handle.type.id());
+            if (!pool) return std::nullopt;
+            return pool->try_get_meta_ref(meta_handle);
         }
 
          // --- Statically typed read -----------------------------------------
 
+        /// @brief Call f with the object, holding its pool's shared lock (thread-safe).
+        ///        Readers of a type run concurrently; writers of it wait.
+        /// @note f may read objects of other types. It must not use this storage
+        ///       for objects of type T in any way, reads included: the pool lock
+        ///       is not recursive (see PoolMutex). Debug builds assert on it.
         template<typename T, typename Fn>
             requires std::invocable<Fn, const T&>
         auto read(const Handle<T>& h, Fn&& f) const
             -> std::invoke_result_t<Fn, const T&>
         {
-            std::lock_guard lock{ storage_mutex };
             const auto& pool = get_pool<T>();
-            const T& obj = pool.get_ref(h); // locks pool
+            std::shared_lock lock{ pool.mutex() };
+            const T& obj = pool.get_ref_nolock(h);
             if constexpr (std::is_void_v<std::invoke_result_t<Fn, const T&>>) {
                 std::forward<Fn>(f)(obj);
             }
@@ -857,45 +1097,151 @@ namespace eeng
             }
         }
 
+        /// @brief Call f(i, object) for every valid handles[i], under one shared
+        ///        lock of the pool (thread-safe). Stale handles are skipped.
+        /// @return Number of objects visited
+        template<typename T, typename Fn>
+            requires std::invocable<Fn, size_t, const T&>
+        size_t read_many(std::span<const Handle<T>> handles, Fn&& f) const
+        {
+            const Pool<T>* pool = static_cast<const Pool<T>*>(find_pool(get_id_type<T>()));
+            if (!pool) return 0;
+
+            std::shared_lock lock{ pool->mutex() };
+            size_t visited = 0;
+            for (size_t i = 0; i < handles.size(); ++i) {
+                if (const T* obj = pool->try_get_nolock(handles[i])) {
+                    f(i, *obj);
+                    ++visited;
+                }
+            }
+            return visited;
+        }
+
+        // --- Read session ----------------------------------------------------
+
+        /// @brief Shared locks on the pools of Ts, held for the session's lifetime.
+        ///
+        /// Lookups through a session take no locks and return pointers that
+        /// stay valid until the session ends, since writers of Ts wait for it.
+        /// Meant to span a pass over many objects, such as a frame's draw loop:
+        ///
+        /// @code
+        /// auto session = storage.read_session<GpuModelAsset, GpuTextureAsset>();
+        /// if (const GpuModelAsset* gpu = session.get(model_handle)) ...
+        /// @endcode
+        ///
+        /// get() is const and may be called from several threads, such as the
+        /// workers of a parallel_for started by the session's owner.
+        /// @note Pools of Ts created after the session began are not seen.
+        ///       While the session lives, the owning thread must not use the
+        ///       storage for objects of Ts in any way other than through the
+        ///       session, reads such as read() or try_read_asset() included:
+        ///       the pool locks are not recursive (see PoolMutex). Debug builds
+        ///       assert on it. The session must end on the thread that began it.
+        template<typename... Ts>
+        class ReadSession
+        {
+            friend class Storage;
+
+            std::tuple<const Pool<Ts>*...> m_pools;
+            std::array<std::shared_lock<PoolMutex>, sizeof...(Ts)> m_locks;
+
+            explicit ReadSession(const Storage& storage)
+                : m_pools{ static_cast<const Pool<Ts>*>(storage.find_pool(storage.get_id_type<Ts>()))... }
+            {
+                size_t i = 0;
+                std::apply([&](auto*... pools) {
+                    ((pools ? void(m_locks[i] = std::shared_lock{ pools->mutex() }) : void(), ++i), ...);
+                    }, m_pools);
+            }
+
+        public:
+            ReadSession(ReadSession&&) noexcept = default;
+            ReadSession& operator=(ReadSession&&) noexcept = default;
+
+            /// @brief The object, or nullptr if the handle is stale or T has no pool
+            template<typename T>
+            const T* get(const Handle<T>& h) const noexcept
+            {
+                static_assert((std::is_same_v<T, Ts> || ...), "Type is not pinned by this session");
+                const Pool<T>* pool = std::get<const Pool<T>*>(m_pools);
+                return pool ? pool->try_get_nolock(h) : nullptr;
+            }
+
+            template<typename T>
+            bool valid(const Handle<T>& h) const noexcept
+            {
+                return get(h) != nullptr;
+            }
+        };
+
+        /// @brief Pin the pools of Ts for reading. See ReadSession.
+        template<typename... Ts>
+        ReadSession<Ts...> read_session() const
+        {
+            return ReadSession<Ts...>{ *this };
+        }
+
         // --- Meta typed read -----------------------------------------------
 
         // ...
 
         // --- Meta typed modify -----------------------------------------------
 
+        /// @brief Call f with the object, holding its pool's exclusive lock (thread-safe).
+        /// @note f may read objects of other types, not of this one.
         template<class Fn>
             requires std::invocable<Fn, entt::meta_any&>
         auto modify(const MetaHandle& mh, Fn&& f)
             -> std::invoke_result_t<Fn, entt::meta_any&>
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_pool(mh.type.id());
-            entt::meta_any obj = pool.get_meta_ref(mh);
+            std::unique_lock lock{ pool.mutex() };
+            entt::meta_any obj = pool.get_meta_ref_nolock(mh);
 
+            // The object may have grown: measure it again
             if constexpr (std::is_void_v<std::invoke_result_t<Fn, entt::meta_any&>>) {
                 std::forward<Fn>(f)(obj);
+                pool.remeasure_nolock(mh);
+                lock.unlock();
+                check_memory_budget(mh.type.id());
             }
             else {
-                return std::forward<Fn>(f)(obj);
+                decltype(auto) result = std::forward<Fn>(f)(obj);
+                pool.remeasure_nolock(mh);
+                lock.unlock();
+                check_memory_budget(mh.type.id());
+                return result;
             }
         }
 
         // --- Statically typed modify -----------------------------------------
 
+        /// @brief Call f with the object, holding its pool's exclusive lock (thread-safe).
+        /// @note f may read objects of other types, not of this one.
         template<typename T, typename Fn>
             requires std::invocable<Fn, T&>
         auto modify(const Handle<T>& h, Fn&& f)
             -> std::invoke_result_t<Fn, T&>
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_pool<T>();
-            T& obj = pool.get_ref(h);
+            std::unique_lock lock{ pool.mutex() };
+            T& obj = pool.get_ref_nolock(h);
 
+            // The object may have grown: measure it again
             if constexpr (std::is_void_v<std::invoke_result_t<Fn, T&>>) {
                 std::forward<Fn>(f)(obj);
+                pool.remeasure_nolock(h);
+                lock.unlock();
+                check_memory_budget(get_id_type<T>());
             }
             else {
-                return std::forward<Fn>(f)(obj);
+                decltype(auto) result = std::forward<Fn>(f)(obj);
+                pool.remeasure_nolock(h);
+                lock.unlock();
+                check_memory_budget(get_id_type<T>());
+                return result;
             }
         }
 
@@ -921,15 +1267,15 @@ namespace eeng
         template<typename T>
         void remove_now(const Handle<T>& h)
         {
-            std::lock_guard lock{ storage_mutex };
             get_pool<T>().remove_now(h);
+            check_memory_budget(get_id_type<T>());
         }
 
         /// @brief Immediately destroy the resource referred to by a runtime‑typed handle (thread‑safe).
         void remove_now(const MetaHandle& mh)
         {
-            std::lock_guard lock{ storage_mutex };
             get_pool(mh.type.id()).remove_now(mh);
+            check_memory_budget(mh.type.id());
         }
 
         /// Increase the ref-count for a resource.
@@ -937,7 +1283,6 @@ namespace eeng
         template<typename T>
         size_t retain(const Handle<T>& h)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_pool<T>();
             return pool.retain(h);
         }
@@ -946,7 +1291,6 @@ namespace eeng
         /// @returns the new ref-count.
         size_t retain(const MetaHandle& mh)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_pool(mh.type.id());
             return pool.retain(mh);
         }
@@ -954,16 +1298,18 @@ namespace eeng
         template<typename T>
         size_t release(const Handle<T>& h)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_pool<T>();
-            return pool.release_and_destroy(h);
+            auto cnt = pool.release_and_destroy(h);
+            if (cnt == 0) check_memory_budget(get_id_type<T>());
+            return cnt;
         }
 
         size_t release(const MetaHandle& mh)
         {
-            std::lock_guard lock{ storage_mutex };
             auto& pool = get_pool(mh.type.id());
-            return pool.release_and_destroy(mh);
+            auto cnt = pool.release_and_destroy(mh);
+            if (cnt == 0) check_memory_budget(mh.type.id());
+            return cnt;
         }
 
         // --- Capacity and free slots -----------------------------------------
@@ -971,22 +1317,95 @@ namespace eeng
         template<typename T>
         size_t count_free() const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             return get_pool<T>().count_free();
         }
 
         size_t capacity(entt::id_type id_type) const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             return get_pool(id_type).capacity();
         }
 
+        // --- Memory accounting -----------------------------------------------
+
+        /// @brief Memory held by the pool of a type (thread-safe). O(1).
+        /// @note Heap bytes come from the type's memory_usage meta hook and are
+        ///       measured on add() and modify(). See refresh_memory_usage().
+        template<typename T>
+        PoolMemoryUsage memory_usage() const
+        {
+            return memory_usage(get_id_type<T>());
+        }
+
+        /// @brief Memory held by the pool of a runtime type (thread-safe). O(1).
+        PoolMemoryUsage memory_usage(entt::id_type id_type) const
+        {
+            PoolMemoryUsage usage;
+            if (const IPool* pool = find_pool(id_type))
+                usage = pool->memory_usage();
+            usage.type_id = id_type;
+
+            std::lock_guard lock{ storage_mutex };
+            if (auto it = memory_budgets.find(id_type); it != memory_budgets.end())
+                usage.budget_bytes = it->second;
+            return usage;
+        }
+
+        /// @brief Memory held by every pool (thread-safe).
+        std::vector<PoolMemoryUsage> memory_usage() const
+        {
+            std::vector<PoolMemoryUsage> usages;
+            for (const auto& [id_type, _] : pool_table_snapshot())
+                usages.push_back(memory_usage(id_type));
+            return usages;
+        }
+
+        /// @brief Measure every live object again, e.g. after changes made
+        ///        through get_ref(), and check the budgets (thread-safe). O(N).
+        void refresh_memory_usage()
+        {
+            for (const auto& [id_type, pool] : pool_table_snapshot()) {
+                pool->refresh_memory_usage();
+                check_memory_budget(id_type);
+            }
+        }
+
+        /// @brief Limit the inline + heap bytes of a type. 0 removes the limit.
+        ///        Exceeding it raises a MemoryBudgetExceededEvent via the listener.
+        template<typename T>
+        void set_memory_budget(size_t bytes)
+        {
+            set_memory_budget(get_id_type<T>(), bytes);
+        }
+
+        void set_memory_budget(entt::id_type id_type, size_t bytes)
+        {
+            {
+                std::lock_guard lock{ storage_mutex };
+                over_budget.erase(id_type);
+                if (bytes == 0) {
+                    memory_budgets.erase(id_type);
+                    return;
+                }
+                memory_budgets[id_type] = bytes;
+            }
+            check_memory_budget(id_type);
+        }
+
+        /// @brief Receiver of budget events, typically forwarding to an EventQueue.
+        /// @note Called on the thread that grew the pool, after the storage has
+        ///       released its locks: the listener may query the storage, but it
+        ///       may run on several threads at once and must be thread-safe.
+        void set_memory_budget_listener(std::function<void(const MemoryBudgetExceededEvent&)> listener)
+        {
+            std::lock_guard lock{ storage_mutex };
+            memory_budget_listener = std::move(listener);
+        }
+
         // --- Validation methods ----------------------------------------------
 
         template<typename T>
         bool validate(const Handle<T>& h) const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             if (!has_storage<T>()) return false;
             const auto& pool = get_pool<T>();
             return pool.valid(h);
@@ -995,35 +1414,57 @@ namespace eeng
         /// @return true if there's a pool for `mh.type` and the handle’s version is still valid.
         bool validate(const MetaHandle& mh) const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
-            auto it = pools.find(mh.type.id());
-            if (it == pools.end()) return false;
-            return it->second->valid(mh);
+            const IPool* pool = find_pool(mh.type.id());
+            return pool && pool->valid(mh);
         }
 
         /// @brief Remove *all* resources in *all* pools, but keep the same pool objects.
         void clear() noexcept
         {
-            std::lock_guard lock{ storage_mutex };
-            for (auto& [_, pool] : pools) {
+            for (const auto& [_, pool] : pool_table_snapshot()) {
                 pool->clear();
             }
         }
 
+        // --- Compaction ------------------------------------------------------
+
+        /// @brief Move the live objects of a type to the lowest slots of its pool
+        ///        and release the free tail (thread-safe).
+        /// @return Old and new handle of every moved object. Old handles, such as
+        ///         those bound in AssetRefs, keep resolving to the moved object;
+        ///         holders may rebind to the new ones through the returned pairs.
+        /// @note Invalidates references returned by get_ref().
+        template<typename T>
+        std::vector<std::pair<Handle<T>, Handle<T>>> compact()
+        {
+            if (!has_storage<T>()) return {};
+            return get_pool<T>().compact();
+        }
+
+        /// @brief Compact every pool (thread-safe).
+        /// @return Old -> new handle of every moved object, over all types.
+        ///         Old handles keep resolving, as for compact<T>().
+        HandleRemap compact()
+        {
+            HandleRemap remap;
+            for (const auto& [_, pool] : pool_table_snapshot()) {
+                pool->compact(remap);
+            }
+            return remap;
+        }
+
         // ---------------------------------------------------------------------
 
         template<class T>
         std::optional<Handle<T>> handle_for_guid(const Guid& guid) const noexcept
         {
-            std::lock_guard lock(storage_mutex);
             if (!has_storage<T>()) return std::nullopt;
             return get_pool<T>().typed_handle_for_guid(guid);
         }
 
         std::optional<MetaHandle> handle_for_guid(const Guid& guid) const noexcept
         {
-            std::lock_guard lock(storage_mutex);
-            for (auto const& [_, pool] : pools) {
+            for (auto const& [_, pool] : pool_table_snapshot()) {
                 if (auto h = pool->handle_for_guid(guid))
                     return h;
             }
@@ -1032,10 +1473,8 @@ namespace eeng
 
         std::optional<Guid> guid_for_handle(const MetaHandle& mh) const noexcept
         {
-            std::lock_guard lock(storage_mutex);
-            auto it = pools.find(mh.type.id());
-            if (it != pools.end())
-                return it->second->guid_for_handle(mh);
+            if (const IPool* pool = find_pool(mh.type.id()))
+                return pool->guid_for_handle(mh);
             return std::nullopt;
         }
 
@@ -1054,7 +1493,6 @@ namespace eeng
             requires std::is_invocable_v<F, T&>
         bool visit(F&& visitor) noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             try {
                 get_pool<T>().visit(std::forward<F>(visitor));
             }
@@ -1069,7 +1507,6 @@ namespace eeng
             requires std::is_invocable_v<F, const T&>
         bool visit(F&& visitor) const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             try {
                 get_pool<T>().visit(std::forward<F>(visitor));
             }
@@ -1084,7 +1521,6 @@ namespace eeng
             requires std::is_invocable_v<F, entt::meta_any>
         bool visit(entt::id_type id_type, F&& visitor) const noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             try {
                 auto& pool = get_pool(id_type);
                 pool.visit_any(
@@ -1107,7 +1543,6 @@ namespace eeng
             requires std::is_invocable_v<F, entt::meta_any>
         bool visit(entt::id_type id_type, F&& visitor) noexcept
         {
-            std::lock_guard lock{ storage_mutex };
             try {
                 auto& pool = get_pool(id_type);
                 pool.visit_any(
@@ -1129,10 +1564,9 @@ namespace eeng
 
         std::string to_string() const
         {
-            std::lock_guard lock{ storage_mutex };
             std::ostringstream oss;
             oss << "Storage summary:\n";
-            for (auto const& [type_id, pool_ptr] : pools)
+            for (auto const& [type_id, pool_ptr] : pool_table_snapshot())
             {
                 auto type_name = entt::resolve(type_id).info().name();
                 oss << "- Type " << type_name << " (id = " << type_id << ")\n";
@@ -1156,51 +1590,132 @@ namespace eeng
         template<typename T>
         const Pool<T>& get_pool() const
         {
-            auto meta_id = get_id_type<T>();
-            return *static_cast<const Pool<T>*>(pools.at(meta_id).get());
+            const IPool* pool = find_pool(get_id_type<T>());
+            if (!pool) throw std::out_of_range("Pool not found");
+            return *static_cast<const Pool<T>*>(pool);
         }
 
         template<typename T>
         Pool<T>& get_pool()
         {
-            auto meta_id = get_id_type<T>();
-            return *static_cast<Pool<T>*>(pools.at(meta_id).get());
+            IPool* pool = find_pool(get_id_type<T>());
+            if (!pool) throw std::out_of_range("Pool not found");
+            return *static_cast<Pool<T>*>(pool);
         }
 
         template<typename T>
         Pool<T>& get_or_create_pool()
         {
             auto meta_id = assure_storage<T>();
-            return *static_cast<Pool<T>*>(pools.at(meta_id).get());
+            return *static_cast<Pool<T>*>(find_pool(meta_id));
         }
 
         // --- Meta typed pool getters -----------------------------------------
 
         const IPool& get_pool(entt::id_type id_type) const
         {
-            auto id = id_type; //meta_type.id();
-            auto it = pools.find(id);
-            if (it == pools.end()) throw std::runtime_error("Pool not found");
-            return *it->second;
+            const IPool* pool = find_pool(id_type);
+            if (!pool) throw std::runtime_error("Pool not found");
+            return *pool;
         }
 
         IPool& get_pool(entt::id_type id_type)
         {
-            auto id = id_type; //meta_type.id();
-            auto it = pools.find(id);
-            if (it == pools.end()) throw std::runtime_error("Pool not found");
-            return *it->second;
+            IPool* pool = find_pool(id_type);
+            if (!pool) throw std::runtime_error("Pool not found");
+            return *pool;
         }
 
         IPool& get_or_create_pool(entt::meta_type meta_type)
         {
             if (!meta_type) throw std::runtime_error("No meta type found");
+            if (IPool* pool = find_pool(meta_type.id())) return *pool;
             assure_storage(meta_type);
-            return *pools.at(meta_type.id());
+            return get_pool(meta_type.id());
         }
 
         // --- Private helpers -------------------------------------------------
 
+        // Readers find pools in an immutable table published with one atomic
+        // store, so lookups take no lock. Adding a pool (rare) copies the table
+        // under storage_mutex; replaced tables are kept until the Storage dies
+        // since a reader may still hold one.
+
+        using PoolTable = std::unordered_map<entt::id_type, IPool*>;
+
+        const IPool* find_pool(entt::id_type id_type) const noexcept
+        {
+            const PoolTable* table = pool_table.load(std::memory_order_acquire);
+            if (!table) return nullptr;
+            auto it = table->find(id_type);
+            return it != table->end() ? it->second : nullptr;
+        }
+
+        IPool* find_pool(entt::id_type id_type) noexcept
+        {
+            return const_cast<IPool*>(std::as_const(*this).find_pool(id_type));
+        }
+
+        const PoolTable& pool_table_snapshot() const noexcept
+        {
+            static const PoolTable empty;
+            const PoolTable* table = pool_table.load(std::memory_order_acquire);
+            return table ? *table : empty;
+        }
+
+        void publish_pool_no_lock(entt::id_type id_type, IPool* pool)
+        {
+            auto table = std::make_unique<PoolTable>(pool_table_snapshot());
+            table->emplace(id_type, pool);
+            pool_table.store(table.get(), std::memory_order_release);
+            pool_tables.push_back(std::move(table));
+        }
+
+        void steal_no_lock(Storage& other) noexcept
+        {
+            pools = std::move(other.pools);
+            pool_tables = std::move(other.pool_tables);
+            pool_table.store(other.pool_table.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+            memory_budgets = std::move(other.memory_budgets);
+            over_budget = std::move(other.over_budget);
+            budget_samples = std::move(other.budget_samples);
+            memory_budget_listener = std::move(other.memory_budget_listener);
+        }
+
+        // Raise an event when a pool goes over its budget; re-arm when it is back under.
+        // Usage is read before storage_mutex is taken: the pool lock is never
+        // acquired while holding it. Samples older than one already applied are
+        // dropped, so concurrent checks cannot apply totals out of order. The
+        // listener is called after storage_mutex is released.
+        void check_memory_budget(entt::id_type id_type)
+        {
+            const IPool* pool = find_pool(id_type);
+            if (!pool) return;
+            uint64_t sample;
+            const size_t total = pool->memory_usage(sample).total_bytes();
+
+            std::function<void(const MemoryBudgetExceededEvent&)> listener;
+            MemoryBudgetExceededEvent event;
+            {
+                std::lock_guard lock{ storage_mutex };
+                auto it = memory_budgets.find(id_type);
+                if (it == memory_budgets.end()) return;
+
+                uint64_t& applied = budget_samples[id_type];
+                if (sample <= applied) return;
+                applied = sample;
+
+                if (total <= it->second) {
+                    over_budget.erase(id_type);
+                    return;
+                }
+                if (!over_budget.insert(id_type).second || !memory_budget_listener) return;
+                listener = memory_budget_listener;
+                event = MemoryBudgetExceededEvent{ id_type, total, it->second };
+            }
+            listener(event);
+        }
+
         template<class T>
         constexpr entt::id_type get_id_type() const noexcept
         {
@@ -1210,9 +1725,18 @@ namespace eeng
 
         // --- Private members -------------------------------------------------
 
-        // mutable std::mutex storage_mutex;
-        mutable std::recursive_mutex storage_mutex;
-        std::unordered_map<entt::id_type, std::unique_ptr<IPool>> pools;
+        // Guards pool creation, the pool tables and budgets. Element access
+        // only takes the lock of the pool involved
+        mutable std::mutex storage_mutex;
+        std::unordered_map<entt::id_type, std::unique_ptr<IPool>> pools; // Owner
+
+        std::atomic<const PoolTable*> pool_table{ nullptr };    // Current, read lock-free
+        std::vector<std::unique_ptr<PoolTable>> pool_tables;    // Current and replaced
+
+        std::unordered_map<entt::id_type, size_t> memory_budgets;
+        std::unordered_set<entt::id_type> over_budget;
+        std::unordered_map<entt::id_type, uint64_t> budget_samples; // Newest usage sample applied
+        std::function<void(const MemoryBudgetExceededEvent&)> memory_budget_listener;
 
     public:
 
@@ -855,7 +855,7 @@ namespace eeng::assets
                         std::make_move_iterator(new_clips.end()));
                 });
 
-            resource_manager.save_loaded_asset<ModelDataAsset>(options.target_model);
+            resource_manager.save_loaded_asset<ModelDataAsset>(options.target_model, ctx);
 
             result.success = true;
             result.model_guid = options.target_model;
@@ -1008,7 +1008,8 @@ namespace eeng::assets
                     model_folder_name + "_Texture" + std::to_string(i),
                     meta::get_meta_type_id_string<TextureAsset>()
                 },
-                tex_meta_file_path.string());
+                tex_meta_file_path.string(),
+                ctx);
 
             const auto gpu_tex_guid = gpu_texture_guids[i];
             const auto gpu_tex_file_base = gpu_tex_guid.to_string();
@@ -1028,7 +1029,8 @@ namespace eeng::assets
                     model_folder_name + "_GpuTexture" + std::to_string(i),
                     meta::get_meta_type_id_string<GpuTextureAsset>()
                 },
-                gpu_tex_meta_file_path.string());
+                gpu_tex_meta_file_path.string(),
+                ctx);
         }
 
         std::vector<MaterialAsset> materials = parsed.materials;
@@ -1054,7 +1056,8 @@ namespace eeng::assets
                     model_folder_name + "_Material" + std::to_string(i),
                     meta::get_meta_type_id_string<MaterialAsset>()
                 },
-                mtl_meta_file_path.string());
+                mtl_meta_file_path.string(),
+                ctx);
 
             const auto gpu_mtl_guid = gpu_material_guids[i];
             const auto gpu_mtl_file_base = gpu_mtl_guid.to_string();
@@ -1084,7 +1087,8 @@ namespace eeng::assets
                     model_folder_name + "_GpuMaterial" + std::to_string(i),
                     meta::get_meta_type_id_string<GpuMaterialAsset>()
                 },
-                gpu_mtl_meta_file_path.string());
+                gpu_mtl_meta_file_path.string(),
+                ctx);
         }
 
         ModelDataAsset model = parsed.model_data;
@@ -1107,7 +1111,8 @@ namespace eeng::assets
                 model_folder_name,
                 meta::get_meta_type_id_string<ModelDataAsset>()
             },
-            model_meta_file_path.string());
+            model_meta_file_path.string(),
+            ctx);
 
         GpuModelAsset gpu_model{};
         gpu_model.model_ref = AssetRef<ModelDataAsset>{ model_guid };
@@ -1138,7 +1143,8 @@ namespace eeng::assets
                 model_folder_name + "_GpuModel",
                 meta::get_meta_type_id_string<GpuModelAsset>()
             },
-            gpu_model_meta_file_path.string());
+            gpu_model_meta_file_path.string(),
+            ctx);
 
         result.success = true;
         result.gpu_model = AssetRef<GpuModelAsset>{ gpu_model_guid };
@@ -152,7 +152,8 @@ namespace eeng::mock {
             mesh,
             mesh_file_path.string(),
             mesh_meta,
-            mesh_meta_file_path.string()); // Serialize to file
+            mesh_meta_file_path.string(),
+            *ctx); // Serialize to file
         // Add mesh reference to model
         model.meshes.push_back(mesh_ref);
 
@@ -171,7 +172,8 @@ namespace eeng::mock {
             texture,
             texture_file_path.string(),
             texture_meta,
-            texture_meta_file_path.string()); // Serialize to file
+            texture_meta_file_path.string(),
+            *ctx); // Serialize to file
         // Add mesh reference to model
         model.textures.push_back(texture_ref);
 
@@ -188,7 +190,8 @@ namespace eeng::mock {
             model,
             model_file_path.string(),
             model_meta,
-            model_meta_file_path.string()); // Serialize to file
+            model_meta_file_path.string(),
+            *ctx); // Serialize to file
         //auto model_ref = resource_manager.file(model, model_path);
 
         // DELAY
@@ -279,7 +282,8 @@ namespace eeng::mock {
             tex,
             tex_file_path.string(),
             tex_meta,
-            tex_meta_file_path.string());
+            tex_meta_file_path.string(),
+            *ctx);
 
         // GpuTextureAsset referencing the TextureAsset
 
@@ -297,7 +301,8 @@ namespace eeng::mock {
                 std::string("MockGpuTexture") + std::to_string(value),
                 meta::get_meta_type_id_string<GpuTextureAsset>()
             },
-            gputex_meta_file_path.string());
+            gputex_meta_file_path.string(),
+            *ctx);
 
         // Material referencing the texture
 
@@ -318,7 +323,8 @@ namespace eeng::mock {
             mtl,
             mtl_file_path.string(),
             mtl_meta,
-            mtl_meta_file_path.string());
+            mtl_meta_file_path.string(),
+            *ctx);
 
         // GpuMaterialAsset referencing the GpuTextureAsset
 
@@ -339,7 +345,8 @@ namespace eeng::mock {
                 std::string("MockGpuMaterial") + std::to_string(value),
                 meta::get_meta_type_id_string<GpuMaterialAsset>()
             },
-            gpumtl_meta_file_path.string());
+            gpumtl_meta_file_path.string(),
+            *ctx);
 
         // ModelData containing two quads, both using the same material
 
@@ -360,7 +367,8 @@ namespace eeng::mock {
             model,
             model_file_path.string(),
             model_meta,
-            model_meta_file_path.string());
+            model_meta_file_path.string(),
+            *ctx);
 
         // GpuModelAsset referencing the ModelDataAsset and GPU materials
 
@@ -386,7 +394,8 @@ namespace eeng::mock {
                 std::string("MockGpuModel") + std::to_string(value),
                 meta::get_meta_type_id_string<GpuModelAsset>()
             },
-            gpumodel_meta_file_path.string());
+            gpumodel_meta_file_path.string(),
+            *ctx);
 
         return AssetRef<GpuModelAsset>{ gpu_model_guid };
     }
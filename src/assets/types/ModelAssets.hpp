@@ -13,6 +13,7 @@
 #include <glm/gtc/quaternion.hpp>
 
 #include "AssetRef.hpp"
+#include "HeapBytes.hpp"
 #include "VecTree.h"
 
 namespace eeng::assets
@@ -390,4 +391,60 @@ namespace eeng::assets
             visit_asset_refs(sm, visitor);
         }
     }
+
+    // -------------------------------------------------------------------------
+    // Heap usage (ADL hooks for heap_bytes_of, used by Storage memory accounting)
+    // -------------------------------------------------------------------------
+
+    inline size_t heap_bytes(const TextureAsset& texture)
+    {
+        return heap_bytes_of(texture.source_path);
+    }
+
+    inline size_t heap_bytes(const GpuModelAsset& gm)
+    {
+        return heap_bytes_of(gm.submeshes);
+    }
+
+    inline size_t heap_bytes(const SkeletonNode& node)
+    {
+        return heap_bytes_of(node.name);
+    }
+
+    inline size_t heap_bytes(const Bone& bone)
+    {
+        return heap_bytes_of(bone.name);
+    }
+
+    inline size_t heap_bytes(const AnimTrack& track)
+    {
+        return heap_bytes_of(track.pos_keys)
+            + heap_bytes_of(track.scale_keys)
+            + heap_bytes_of(track.rot_keys);
+    }
+
+    inline size_t heap_bytes(const AnimClip& clip)
+    {
+        return heap_bytes_of(clip.name) + heap_bytes_of(clip.node_animations);
+    }
+
+    inline size_t heap_bytes(const ModelDataAsset& model)
+    {
+        // VecTree keeps its nodes in a vector; counted by size
+        size_t nodetree_bytes = model.nodetree.size() * sizeof(TreeNode<SkeletonNode>);
+        for (size_t i = 0; i < model.nodetree.size(); ++i)
+            nodetree_bytes += heap_bytes(model.nodetree.get_payload_at(i));
+
+        return heap_bytes_of(model.positions)
+            + heap_bytes_of(model.texcoords)
+            + heap_bytes_of(model.normals)
+            + heap_bytes_of(model.tangents)
+            + heap_bytes_of(model.binormals)
+            + heap_bytes_of(model.skin)
+            + heap_bytes_of(model.indices)
+            + heap_bytes_of(model.submeshes)
+            + nodetree_bytes
+            + heap_bytes_of(model.bones)
+            + heap_bytes_of(model.animations);
+    }
 }
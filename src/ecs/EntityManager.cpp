@@ -211,14 +211,13 @@ namespace eeng
             entities_pending_destruction_.pop_front();
 
             // Remove entity mappings
-            auto guid_it = entity_to_guid_map_.find(entity);
-            assert(guid_it != entity_to_guid_map_.end());
-            auto guid = guid_it->second;
+            const Guid* guid_ptr = entity_to_guid_map_.find(entity);
+            assert(guid_ptr);
+            const Guid guid = *guid_ptr;
             entity_to_guid_map_.erase(entity);
 
-            auto entity_it = guid_to_entity_map_.find(guid);
-            assert(entity_it != guid_to_entity_map_.end());
-            guid_to_entity_map_.erase(guid);
+            [[maybe_unused]] const bool erased = guid_to_entity_map_.erase(guid);
+            assert(erased);
 
             // Remove from chunk registry
             //chunk_registry.remove_entity(registry_->get<HeaderComponent>(entity).chunk_tag, entity);
@@ -278,20 +277,20 @@ namespace eeng
     const Guid EntityManager::get_entity_guid(const ecs::Entity& entity) const
     {
         assert(entity.has_id());
-        auto it = entity_to_guid_map_.find(entity);
-        assert(it != entity_to_guid_map_.end());
-        return it->second;
+        const Guid* guid = entity_to_guid_map_.find(entity);
+        assert(guid);
+        return *guid;
     }
 
 std::optional<ecs::Entity> EntityManager::get_entity_from_guid(const Guid& guid) const
 {
-    auto it = guid_to_entity_map_.find(guid);
-    if (it == guid_to_entity_map_.end())
+    const ecs::Entity* entity = guid_to_entity_map_.find(guid);
+    if (!entity)
     {
         return std::nullopt;
     }
 
-    return it->second;
+    return *entity;
 }
 
 } // namespace eeng
@@ -4,6 +4,7 @@
 #pragma once
 #include "IEntityManager.hpp"
 #include "Guid.h"
+#include "FlatHashMap.h"
 #include "ecs/SceneGraph.hpp"
 
 namespace eeng::ecs
@@ -100,8 +101,8 @@ namespace eeng
 
     private:
         std::shared_ptr<entt::registry>     registry_;
-        std::unordered_map<Guid, ecs::Entity>    guid_to_entity_map_;
-        std::unordered_map<ecs::Entity, Guid>    entity_to_guid_map_;
+        FlatHashMap<Guid, ecs::Entity>      guid_to_entity_map_;
+        FlatHashMap<ecs::Entity, Guid>      entity_to_guid_map_;
         // On create:
         // guid_to_entity_map[guid] = entity;
         // On destroy:
@@ -45,6 +45,12 @@ namespace eeng::ecs
 }
 #endif
 
+    /// Marks an entity spawned by a batch load that is not yet registered with
+    /// the entity manager (no GUID mapping, not in the scene graph). Batches are
+    /// spawned over several frames; systems skip tagged entities until the
+    /// final registration step removes the tag.
+    struct PendingSpawnTag {};
+
     struct ChunkModifiedEvent
     {
         Entity entity;
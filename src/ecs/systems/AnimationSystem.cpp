@@ -5,13 +5,16 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
 
 #include "EngineContext.hpp"
 #include "EngineContextHelpers.hpp"
+#include "ThreadPool.hpp"
 #include "ecs/ModelComponent.hpp"
+#include "ecs/HeaderComponent.hpp"
 #include "assets/types/ModelAssets.hpp"
 
 namespace
@@ -129,91 +132,101 @@ namespace
 
 namespace eeng::ecs::systems
 {
+    // Model instances per parallel_for chunk; a few skeletons is enough to pay for a hand-off
+    constexpr size_t animation_grain = 4;
+
     /// @brief Evaluate animation for all ModelComponent instances and update bone matrices.
     void AnimationSystem::update(entt::registry& registry, EngineContext& ctx, float delta_time)
     {
         auto rm = eeng::try_get_resource_manager(ctx, "AnimationSystem");
         if (!rm) return;
 
-        auto view = registry.view<ecs::ModelComponent>();
-        for (auto&& [entity, model_component] : view.each())
+        // Instances are independent, so they are evaluated in parallel on the pool
+        auto view = registry.view<ecs::ModelComponent>(entt::exclude<ecs::PendingSpawnTag>);
+        const std::vector<entt::entity> entities(view.begin(), view.end());
+
+        // Pinned once for all workers; lookups through it take no locks
+        const auto session = rm->storage().read_session<assets::GpuModelAsset, assets::ModelDataAsset>();
+
+        auto evaluate = [&](size_t entity_index)
         {
+            auto& model_component = view.get<ecs::ModelComponent>(entities[entity_index]);
             if (!model_component.model_ref.is_bound())
-                continue;
+                return;
 
-            Handle<assets::ModelDataAsset> model_handle{};
-            eeng::Guid model_guid = eeng::Guid::invalid();
-            const bool gpu_read = eeng::try_read_asset_ref(
-                *rm,
+            const auto* gpu = eeng::try_get_asset_ref(
+                session,
                 model_component.model_ref,
                 ctx,
                 "AnimationSystem",
-                "Missing GpuModelAsset for ModelComponent:",
-                [&](const assets::GpuModelAsset& gpu)
-                {
-                    model_handle = gpu.model_ref.handle;
-                    model_guid = gpu.model_ref.guid;
-                });
+                "Missing GpuModelAsset for ModelComponent:");
 
-            if (!gpu_read)
+            if (!gpu)
             {
                 // TODO: consider binding a placeholder model for animation.
-                continue;
+                return;
             }
 
-            if (!eeng::try_read_asset(
-                *rm,
-                model_handle,
-                model_guid,
+            const auto* model_ptr = eeng::try_get_asset(
+                session,
+                gpu->model_ref.handle,
+                gpu->model_ref.guid,
                 ctx,
                 "AnimationSystem",
-                "Missing ModelDataAsset for ModelComponent:",
-                [&](const assets::ModelDataAsset& model)
-                {
-                    model_component.clip_time += delta_time * model_component.clip_speed;
-
-                    const auto* clip = resolve_clip(model, model_component.clip_index);
-                    const float ntime = normalized_time(clip, model_component.clip_time, model_component.loop);
-
-                    const size_t node_count = model.nodetree.size();
-                    if (model_component.node_global_matrices.size() != node_count)
-                        model_component.node_global_matrices.assign(node_count, glm::mat4(1.0f));
-
-                    const size_t bone_count = model.bones.size();
-                    if (model_component.bone_matrices.size() != bone_count)
-                        model_component.bone_matrices.assign(bone_count, glm::mat4(1.0f));
-
-                    model.nodetree.traverse_depthfirst(
-                        [&](const assets::SkeletonNode*,
-                            const assets::SkeletonNode* parent,
-                            size_t node_index,
-                            size_t parent_index)
-                        {
-                            glm::mat4 local = evaluate_node_transform(node_index, clip, ntime, model.nodetree);
-                            // Global pose = parent global * local (model space).
-                            if (parent)
-                                local = model_component.node_global_matrices[parent_index] * local;
-                            model_component.node_global_matrices[node_index] = local;
-                        });
-
-                    for (size_t i = 0; i < bone_count; i++)
-                    {
-                        const auto& bone = model.bones[i];
-                        if (bone.node_index == assets::null_index)
-                        {
-                            model_component.bone_matrices[i] = glm::mat4(1.0f);
-                            continue;
-                        }
-
-                        const auto& node_tfm = model_component.node_global_matrices[bone.node_index];
-                        // Skinning matrix: pose in model space * inverse bind (bind -> bone local).
-                        model_component.bone_matrices[i] = node_tfm * bone.inverse_bind_tfm;
-                    }
-                }))
+                "Missing ModelDataAsset for ModelComponent:");
+
+            if (!model_ptr)
             {
                 // TODO: consider binding a placeholder model for animation.
-                continue;
+                return;
             }
-        }
+
+            const assets::ModelDataAsset& model = *model_ptr;
+
+            model_component.clip_time += delta_time * model_component.clip_speed;
+
+            const auto* clip = resolve_clip(model, model_component.clip_index);
+            const float ntime = normalized_time(clip, model_component.clip_time, model_component.loop);
+
+            const size_t node_count = model.nodetree.size();
+            if (model_component.node_global_matrices.size() != node_count)
+                model_component.node_global_matrices.assign(node_count, glm::mat4(1.0f));
+
+            const size_t bone_count = model.bones.size();
+            if (model_component.bone_matrices.size() != bone_count)
+                model_component.bone_matrices.assign(bone_count, glm::mat4(1.0f));
+
+            model.nodetree.traverse_depthfirst(
+                [&](const assets::SkeletonNode*,
+                    const assets::SkeletonNode* parent,
+                    size_t node_index,
+                    size_t parent_index)
+                {
+                    glm::mat4 local = evaluate_node_transform(node_index, clip, ntime, model.nodetree);
+                    // Global pose = parent global * local (model space).
+                    if (parent)
+                        local = model_component.node_global_matrices[parent_index] * local;
+                    model_component.node_global_matrices[node_index] = local;
+                });
+
+            for (size_t i = 0; i < bone_count; i++)
+            {
+                const auto& bone = model.bones[i];
+                if (bone.node_index == assets::null_index)
+                {
+                    model_component.bone_matrices[i] = glm::mat4(1.0f);
+                    continue;
+                }
+
+                const auto& node_tfm = model_component.node_global_matrices[bone.node_index];
+                // Skinning matrix: pose in model space * inverse bind (bind -> bone local).
+                model_component.bone_matrices[i] = node_tfm * bone.inverse_bind_tfm;
+            }
+        };
+
+        if (ctx.thread_pool)
+            ctx.thread_pool->parallel_for(size_t{ 0 }, entities.size(), animation_grain, evaluate, TaskPriority::FrameCritical);
+        else
+            for (size_t i = 0; i < entities.size(); i++) evaluate(i);
     }
 }
@@ -11,6 +11,7 @@
 #include "ShaderLoader.h"
 #include "EngineContextHelpers.hpp"
 #include "ecs/ModelComponent.hpp"
+#include "ecs/HeaderComponent.hpp"
 #include "ecs/TransformComponent.hpp"
 #include "assets/types/ModelAssets.hpp"
 
@@ -95,61 +96,43 @@ namespace eeng::ecs::systems
             bind_frame_uniforms(shader_program_);
         CheckAndThrowGLErrors();
 
-        auto view = registry.view<ecs::ModelComponent>();
+        // Pin the asset pools for the whole pass: lookups below take no locks
+        // and return pointers that stay valid until the session ends
+        const auto session = rm->storage().read_session<
+            assets::GpuModelAsset,
+            assets::ModelDataAsset,
+            assets::GpuMaterialAsset,
+            assets::GpuTextureAsset>();
+
+        auto view = registry.view<ecs::ModelComponent>(entt::exclude<ecs::PendingSpawnTag>);
         for (auto [entity, model] : view.each())
         {
             if (!model.model_ref.is_bound())
                 continue;
 
-            GLuint vao = 0;
-            GLuint ibo = 0;
-            std::vector<assets::GpuSubMesh> submeshes;
-            Handle<assets::ModelDataAsset> model_handle{};
-            Guid model_guid = Guid::invalid();
-            std::vector<assets::SubMesh> cpu_submeshes;
-            size_t bone_count = 0;
-            bool gpu_ready = false;
-
-            const bool gpu_read = eeng::try_read_asset_ref(
-                *rm,
+            const auto* gpu = eeng::try_get_asset_ref(
+                session,
                 model.model_ref,
                 ctx,
                 "RenderSystem",
-                "Missing GpuModelAsset for ModelComponent:",
-                [&](const assets::GpuModelAsset& gpu)
-                {
-                    if (gpu.state != assets::GpuLoadState::Ready || gpu.vao == 0)
-                        return;
-
-                    vao = gpu.vao;
-                    ibo = gpu.ibo;
-                    submeshes = gpu.submeshes;
-                    model_handle = gpu.model_ref.handle;
-                    model_guid = gpu.model_ref.guid;
-                    gpu_ready = true;
-                });
-
-            if (!gpu_read || !gpu_ready || vao == 0 || ibo == 0 || submeshes.empty())
+                "Missing GpuModelAsset for ModelComponent:");
+
+            if (!gpu)
             {
-                if (!gpu_read)
-                {
-                    // TODO: consider binding a placeholder model for rendering.
-                }
+                // TODO: consider binding a placeholder model for rendering.
                 continue;
             }
+            if (gpu->state != assets::GpuLoadState::Ready || gpu->vao == 0 || gpu->ibo == 0 || gpu->submeshes.empty())
+                continue;
 
-            eeng::try_read_asset(
-                *rm,
-                model_handle,
-                model_guid,
+            const auto* cpu_model = eeng::try_get_asset(
+                session,
+                gpu->model_ref.handle,
+                gpu->model_ref.guid,
                 ctx,
                 "RenderSystem",
-                "Missing ModelDataAsset for ModelComponent:",
-                [&](const assets::ModelDataAsset& cpu_model)
-                {
-                    cpu_submeshes = cpu_model.submeshes;
-                    bone_count = cpu_model.bones.size();
-                });
+                "Missing ModelDataAsset for ModelComponent:");
+            const size_t bone_count = cpu_model ? cpu_model->bones.size() : 0;
 
             const auto* tfm = registry.try_get<ecs::TransformComponent>(entity);
             const glm::mat4 world = tfm ? tfm->world_matrix : glm::mat4(1.0f);
@@ -163,8 +146,8 @@ namespace eeng::ecs::systems
                 bind_entity_uniforms(shader_program_, entity, model);
             CheckAndThrowGLErrors();
 
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+            glBindVertexArray(gpu->vao);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu->ibo);
             CheckAndThrowGLErrors();
 
             if (bone_count > 0 && !model.bone_matrices.empty())
@@ -177,26 +160,20 @@ namespace eeng::ecs::systems
                     glm::value_ptr(model.bone_matrices[0]));
             }
 
-            for (const auto& sm : submeshes)
+            for (const auto& sm : gpu->submeshes)
             {
                 if (sm.index_count == 0)
                     continue;
 
-                assets::GpuMaterialAsset material{};
-                bool has_material = false;
-                if (sm.material.is_bound())
-                {
-                    has_material = eeng::try_read_asset_ref(
-                        *rm,
-                        sm.material,
-                        ctx,
-                        "RenderSystem",
-                        "Missing GpuMaterialAsset for ModelComponent:",
-                        [&](const assets::GpuMaterialAsset& mtl)
-                        {
-                            material = mtl;
-                        });
-                }
+                static const assets::GpuMaterialAsset default_material{};
+                const auto* mtl = eeng::try_get_asset_ref(
+                    session,
+                    sm.material,
+                    ctx,
+                    "RenderSystem",
+                    "Missing GpuMaterialAsset for ModelComponent:");
+                const bool has_material = mtl != nullptr;
+                const auto& material = has_material ? *mtl : default_material;
 
                 glUniform3fv(glGetUniformLocation(shader_program_, "Ka"), 1, glm::value_ptr(material.Ka));
                 glUniform3fv(glGetUniformLocation(shader_program_, "Kd"), 1, glm::value_ptr(material.Kd));
@@ -211,21 +188,15 @@ namespace eeng::ecs::systems
                     if (has_material)
                     {
                         const auto& tex_ref = material.textures[static_cast<size_t>(texture_desc.slot)];
-                        if (tex_ref.is_bound())
+                        if (const auto* tex = eeng::try_get_asset_ref(
+                            session,
+                            tex_ref,
+                            ctx,
+                            "RenderSystem",
+                            "Missing GpuTextureAsset for ModelComponent:"))
                         {
-                            bool texture_ready = false;
-                            const bool texture_read = eeng::try_read_asset_ref(
-                                *rm,
-                                tex_ref,
-                                ctx,
-                                "RenderSystem",
-                                "Missing GpuTextureAsset for ModelComponent:",
-                                [&](const assets::GpuTextureAsset& tex)
-                                {
-                                    tex_id = tex.gl_id;
-                                    texture_ready = (tex_id != 0 && tex.state == assets::GpuLoadState::Ready);
-                                });
-                            has_texture = texture_read && texture_ready;
+                            tex_id = tex->gl_id;
+                            has_texture = (tex_id != 0 && tex->state == assets::GpuLoadState::Ready);
                         }
                     }
 
@@ -234,9 +205,9 @@ namespace eeng::ecs::systems
                     glUniform1i(glGetUniformLocation(shader_program_, texture_desc.flag_name), has_texture);
                 }
 
-                const size_t sm_index = &sm - submeshes.data();
-                const bool submesh_skinned = (sm_index < cpu_submeshes.size())
-                    ? cpu_submeshes[sm_index].is_skinned
+                const size_t sm_index = &sm - gpu->submeshes.data();
+                const bool submesh_skinned = (cpu_model && sm_index < cpu_model->submeshes.size())
+                    ? cpu_model->submeshes[sm_index].is_skinned
                     : false;
                 const bool use_skinning = submesh_skinned && !model.bone_matrices.empty();
                 glUniform1i(glGetUniformLocation(shader_program_, "u_is_skinned"), use_skinning ? 1 : 0);
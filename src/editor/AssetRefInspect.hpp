@@ -43,7 +43,7 @@ namespace eeng::editor
         auto handle = ptr->handle;
         if (handle)
         {
-            ImGui::Text("idx %zu", handle.idx);
+            ImGui::Text("idx %u", handle.idx);
             ImGui::Text("ver %u", handle.ver);
         }
         else
@@ -6,6 +6,7 @@
 #include "MainThreadQueue.hpp"
 #include "ThreadPool.hpp"
 #include "EventQueue.h"
+#include "FrameArena.hpp"
 #include "editor/CommandQueue.hpp"
 #include "engineapi/SelectionManager.hpp"
 
@@ -55,6 +56,12 @@ namespace eeng
             case EngineValue::MasterVolume:
                 // ...
                 break;
+            case EngineValue::MainThreadQueueBudget:
+                // Polled by the main loop
+                break;
+            case EngineValue::SimulatedIoLatency:
+                io_latency_.set_default(new_value > 0.0f ? IoLatencyModel::fixed(new_value) : IoLatencyModel{});
+                break;
             }
         }
     }
@@ -65,6 +72,17 @@ namespace eeng
         return it != values.end() ? it->second : 0.0f;
     }
 
+    namespace
+    {
+        ThreadPoolConfig thread_pool_config()
+        {
+            ThreadPoolConfig config;
+            config.name = "eeng-worker";
+            config.numa_aware = true; // One group per node; a no-op on single-node machines
+            return config;
+        }
+    }
+
     EngineContext::EngineContext(
         std::unique_ptr<IEntityManager> entity_manager,
         std::shared_ptr<IResourceManager> resource_manager,
@@ -79,8 +97,9 @@ namespace eeng
         , input_manager(std::move(input_manager))
         , log_manager(log_manager)
         , main_thread_queue(std::make_unique<MainThreadQueue>())
-        , thread_pool(std::make_unique<ThreadPool>()) // 2+, reload async deadlocks for < 2 threads
+        , thread_pool(std::make_unique<ThreadPool>(thread_pool_config())) // 2+, reload async deadlocks for < 2 threads
         , event_queue(std::make_unique<EventQueue>())
+        , frame_arena(std::make_unique<FrameArena>())
         , command_queue(std::make_unique<editor::CommandQueue>())
         , asset_selection(std::make_unique<editor::SelectionManager<Guid>>())
         , entity_selection(std::make_unique<editor::SelectionManager<ecs::Entity>>())
@@ -90,4 +109,9 @@ namespace eeng
 
     EngineContext::~EngineContext() = default;
 
+    MainThreadAwaiter EngineContext::main_thread() const
+    {
+        return main_thread_queue->schedule();
+    }
+
 } // namespace eeng
@@ -10,14 +10,17 @@
 #include "IInputManager.hpp"
 #include "ILogManager.hpp"
 #include "Guid.h"
+#include "SimulatedIoLatency.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <string>
 #include <memory>
 
 class MainThreadQueue;
+struct MainThreadAwaiter;
 class ThreadPool;
 class EventQueue;
+class FrameArena;
 namespace eeng::editor {
     template<typename T> class SelectionManager;
     class CommandQueue;
@@ -34,6 +37,7 @@ namespace eeng
     - Resource manager
     - Thread pool
     - Event dispatcher
+    - Frame arena for per-frame transient allocations
     - Logger
     - Selection manager for assets & entities
     - CommandQueue
@@ -95,6 +99,8 @@ namespace eeng
     {
         MinFrameTime,
         MasterVolume,
+        MainThreadQueueBudget,  // ms per frame for main-thread tasks, 0 = run all
+        SimulatedIoLatency,     // ms added to every asset load, 0 = off
         // ...
     };
 
@@ -113,9 +119,17 @@ namespace eeng
 
         float get_value(EngineValue key) const;
 
+        // --- Simulated asset I/O ---
+        /// Per-type latency models for asset loads; off by default.
+        /// EngineValue::SimulatedIoLatency sets a fixed default model.
+        SimulatedIoLatency& io_latency() { return io_latency_; }
+
+        const SimulatedIoLatency& io_latency() const { return io_latency_; }
+
     private:
         std::unordered_map<EngineFlag, bool> flags;
         std::unordered_map<EngineValue, float> values;
+        SimulatedIoLatency io_latency_;
         EventQueue& event_queue;
     };
 
@@ -131,6 +145,9 @@ namespace eeng
 
         ~EngineContext();
 
+        /// co_await to continue the current coroutine on the main thread
+        MainThreadAwaiter main_thread() const;
+
         std::unique_ptr<IEntityManager>         entity_manager;
         std::shared_ptr<IResourceManager>       resource_manager;
         std::unique_ptr<IBatchRegistry>         batch_registry;
@@ -140,6 +157,7 @@ namespace eeng
         std::unique_ptr<MainThreadQueue>        main_thread_queue;
         std::unique_ptr<ThreadPool>             thread_pool;
         std::unique_ptr<EventQueue>             event_queue;
+        std::unique_ptr<FrameArena>             frame_arena;
         std::unique_ptr<editor::CommandQueue>   command_queue;
         std::unique_ptr<GuidSelection>          asset_selection;
         std::unique_ptr<EntitySelection>        entity_selection;
@@ -12,6 +12,7 @@
 #include "EventQueue.h"
 
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
@@ -34,8 +35,14 @@ namespace eeng
         {
             const char* tag = normalize_log_tag(log_tag);
             static std::unordered_set<std::string> warned;
+            static std::mutex warned_mutex; // Systems may run in parallel_for
             std::string key = std::string(tag) + "|" + message;
-            if (warned.insert(key).second)
+            bool first = false;
+            {
+                std::lock_guard lk(warned_mutex);
+                first = warned.insert(std::move(key)).second;
+            }
+            if (first)
                 EENG_LOG_WARN(&ctx, "[%s] %s", tag, message);
         }
 
@@ -46,8 +53,14 @@ namespace eeng
             const char* tag = normalize_log_tag(log_tag);
             const std::string guid_str = guid.to_string();
             static std::unordered_set<std::string> warned;
+            static std::mutex warned_mutex;
             std::string key = std::string(tag) + "|" + message + "|" + guid_str;
-            if (warned.insert(key).second)
+            bool first = false;
+            {
+                std::lock_guard lk(warned_mutex);
+                first = warned.insert(std::move(key)).second;
+            }
+            if (first)
                 EENG_LOG_WARN(&ctx, "[%s] %s %s", tag, message, guid_str.c_str());
         }
 
@@ -177,4 +190,34 @@ namespace eeng
             return false;
         return try_read_asset(rm, ref.handle, ref.guid, ctx, log_tag, missing_label, std::forward<Fn>(fn));
     }
+
+    // Lookups through a Storage::ReadSession: no locking, and the returned
+    // pointer stays valid for the session's lifetime. nullptr if missing.
+    template<typename T, typename Session>
+    const T* try_get_asset(
+        const Session& session,
+        const Handle<T>& handle,
+        const Guid& guid,
+        EngineContext& ctx,
+        const char* log_tag,
+        const char* missing_label)
+    {
+        const T* asset = handle ? session.get(handle) : nullptr;
+        if (!asset)
+            detail::log_warn_once(ctx, log_tag, guid, missing_label);
+        return asset;
+    }
+
+    template<typename T, typename Session>
+    const T* try_get_asset_ref(
+        const Session& session,
+        const AssetRef<T>& ref,
+        EngineContext& ctx,
+        const char* log_tag,
+        const char* missing_label)
+    {
+        if (!ref.is_bound())
+            return nullptr;
+        return try_get_asset(session, ref.handle, ref.guid, ctx, log_tag, missing_label);
+    }
 } // namespace eeng
@@ -4,6 +4,7 @@
 #include "Guid.h"
 #include "Handle.h"
 #include "AssetIndexData.hpp"
+#include "CoTask.hpp"
 #include <string>
 #include <future>
 #include <deque>
@@ -89,6 +90,16 @@ namespace eeng
         virtual std::shared_future<TaskResult> unbind_and_unload_async(std::deque<Guid> branch_guids, const BatchId& batch, EngineContext& ctx) = 0;
         virtual std::shared_future<TaskResult> reload_and_rebind_async(std::deque<Guid> guids, const BatchId& batch, EngineContext& ctx) = 0;
 
+        // Coroutine variants of the above (the _async calls spawn these). Loads
+        // and main-thread steps are awaited without holding a thread, while
+        // operations stay exclusive of each other. The caller resumes on the
+        // thread that finished the operation, a worker or the main thread.
+        // Arguments are taken by value since the coroutine starts when awaited.
+        virtual CoTask<TaskResult> co_scan_assets(std::filesystem::path root, EngineContext& ctx) = 0;
+        virtual CoTask<TaskResult> co_load_and_bind(std::deque<Guid> branch_guids, BatchId batch, EngineContext& ctx) = 0;
+        virtual CoTask<TaskResult> co_unbind_and_unload(std::deque<Guid> branch_guids, BatchId batch, EngineContext& ctx) = 0;
+        virtual CoTask<TaskResult> co_reload_and_rebind(std::deque<Guid> guids, BatchId batch, EngineContext& ctx) = 0;
+
         // virtual void retain_guid(const Guid& guid) = 0;
         // virtual void release_guid(const Guid& guid, EngineContext& ctx) = 0;
 
@@ -18,6 +18,7 @@
 #include "engineapi/SelectionManager.hpp"
 #include "ThreadPool.hpp" // remove?
 #include "MainThreadQueue.hpp"
+#include "FrameArena.hpp"
 // #include "MetaInspect.hpp"
 
 // Inspection TODO -> using a Comp command - need an Asset command?
@@ -29,6 +30,7 @@
 #include "imgui_impl_opengl3.h"
 
 #include <algorithm>
+#include <fstream>
 //#include <future>
 
 namespace eeng
@@ -206,11 +208,12 @@ namespace eeng
 
         ImGui::Begin("Storage Occupancy");
 
-        if (ImGui::BeginTable("StorageTable", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        if (ImGui::BeginTable("StorageTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
         {
             ImGui::TableSetupColumn("Type");
             ImGui::TableSetupColumn("Used / Capacity");
             ImGui::TableSetupColumn("Occupancy");
+            ImGui::TableSetupColumn("Memory (KB)");
             ImGui::TableHeadersRow();
 
             for (auto& [id_type, pool_ptr] : storage)
@@ -232,6 +235,20 @@ namespace eeng
                 // Column 3: Colored cell bar
                 ImGui::TableSetColumnIndex(2);
                 DrawOccupancyBar(used, capacity);
+
+                // Column 4: Inline + heap, peak and budget
+                ImGui::TableSetColumnIndex(3);
+                const auto memory = storage.memory_usage(id_type);
+                const bool over_budget = memory.budget_bytes && memory.total_bytes() > memory.budget_bytes;
+                if (over_budget) ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 96, 96, 255));
+                ImGui::Text("%.1f + %.1f (peak %.1f)",
+                    memory.inline_bytes / 1024.0, memory.heap_bytes / 1024.0, memory.peak_bytes / 1024.0);
+                if (memory.budget_bytes)
+                {
+                    ImGui::SameLine();
+                    ImGui::Text("/ %.1f", memory.budget_bytes / 1024.0);
+                }
+                if (over_budget) ImGui::PopStyleColor();
             }
 
             ImGui::EndTable();
@@ -1010,8 +1027,28 @@ namespace eeng
             ImGui::BulletText("Working:        %zu", pool->nbr_working_threads());
             ImGui::BulletText("Idle:           %zu", pool->nbr_idle_threads());
             ImGui::BulletText("Queued tasks:   %zu", pool->task_queue_size());
+            ImGui::BulletText("  frame:        %zu", pool->task_queue_size(TaskPriority::FrameCritical));
+            ImGui::BulletText("  interactive:  %zu", pool->task_queue_size(TaskPriority::Interactive));
+            ImGui::BulletText("  background:   %zu", pool->task_queue_size(TaskPriority::Background));
             ImGui::BulletText("Queue is empty: %s",
                 pool->is_task_queue_empty() ? "yes" : "no");
+            ImGui::BulletText("Executed:       %zu", pool->nbr_executed_tasks());
+            ImGui::BulletText("NUMA nodes:     %zu", pool->nbr_numa_nodes());
+
+            if (ImGui::TreeNode("Workers"))
+            {
+                for (size_t i = 0; i < pool->nbr_threads(); ++i)
+                {
+                    const double busy_ms = std::chrono::duration<double, std::milli>(pool->busy_time(i)).count();
+                    ImGui::BulletText("%s  node %zu  cpu %d  tasks %zu  busy %.1f ms",
+                        pool->worker_name(i).c_str(),
+                        pool->worker_numa_node(i),
+                        pool->worker_cpu(i),
+                        pool->nbr_executed_tasks(i),
+                        busy_ms);
+                }
+                ImGui::TreePop();
+            }
         }
         else
         {
@@ -1028,14 +1065,60 @@ namespace eeng
             ImGui::TextUnformatted("Main Thread Queue");
             ImGui::Separator();
 
-            bool empty = mtq->empty();
-            ImGui::BulletText("Pending tasks: %s", empty ? "0 (empty)" : "> 0");
+            const auto stats = mtq->stats();
+            ImGui::BulletText("Pending tasks:  %zu", mtq->size());
+            ImGui::BulletText("Queued:         %llu", static_cast<unsigned long long>(stats.queued));
+            ImGui::BulletText("Executed:       %llu", static_cast<unsigned long long>(stats.executed));
+            ImGui::BulletText("Deferred:       %llu", static_cast<unsigned long long>(stats.deferred));
         }
         else
         {
             ImGui::TextUnformatted("No main-thread queue available.");
         }
 
+        ImGui::Separator();
+
+        // Executor instrumentation (latency/run-time histograms, Chrome traces)
+        if (ctx.thread_pool && ctx.main_thread_queue && ImGui::TreeNode("Instrumentation"))
+        {
+            ExecutorStats* executors[] = { &ctx.thread_pool->instrumentation(), &ctx.main_thread_queue->instrumentation() };
+
+            bool enabled = executors[0]->enabled();
+            if (ImGui::Checkbox("Enabled", &enabled))
+                for (auto* stats : executors) stats->enable(enabled);
+            ImGui::SameLine();
+            bool traced = executors[0]->trace_enabled();
+            if (ImGui::Checkbox("Trace", &traced))
+                for (auto* stats : executors) stats->enable_trace(traced);
+
+            for (auto* stats : executors)
+            {
+                const auto latency = stats->histogram(ExecutorMetric::QueueLatency);
+                const auto run = stats->histogram(ExecutorMetric::RunTime);
+                const auto blocked = stats->histogram(ExecutorMetric::BlockedWait);
+                ImGui::BulletText("%s: latency p50 %.1f us p99 %.1f us, run p50 %.1f us p99 %.1f us, blocked waits %llu",
+                    stats->name().c_str(),
+                    latency.percentile(0.5) / 1000.0, latency.percentile(0.99) / 1000.0,
+                    run.percentile(0.5) / 1000.0, run.percentile(0.99) / 1000.0,
+                    static_cast<unsigned long long>(blocked.count));
+            }
+
+            if (ImGui::Button("Export"))
+            {
+                for (auto* stats : executors)
+                {
+                    std::ofstream(stats->name() + "_stats.json") << stats->to_json();
+                    std::ofstream(stats->name() + "_trace.json") << stats->to_chrome_trace();
+                }
+                EENG_LOG_INFO(&ctx, "Exported executor stats and traces to the working directory");
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Reset"))
+                for (auto* stats : executors) stats->reset();
+
+            ImGui::TreePop();
+        }
+
         ImGui::End();
     }
 
@@ -1099,6 +1182,31 @@ namespace eeng
             {
                 ctx.engine_config->set_flag(EngineFlag::WireframeRendering, wf);
             }
+
+            // Per-frame time budget for main-thread tasks
+            float mtq_budget_ms = ctx.engine_config->get_value(EngineValue::MainThreadQueueBudget);
+            if (ImGui::SliderFloat("Main-thread task budget (ms)", &mtq_budget_ms, 0.0f, 16.0f, "%.1f"))
+            {
+                ctx.engine_config->set_value(EngineValue::MainThreadQueueBudget, mtq_budget_ms);
+            }
+
+            // Artificial delay per asset load, for testing async loading
+            float io_latency_ms = ctx.engine_config->get_value(EngineValue::SimulatedIoLatency);
+            if (ImGui::SliderFloat("Simulated asset I/O latency (ms)", &io_latency_ms, 0.0f, 2000.0f, "%.0f"))
+            {
+                ctx.engine_config->set_value(EngineValue::SimulatedIoLatency, io_latency_ms);
+            }
+
+            // Transient per-frame memory
+            if (ctx.frame_arena)
+            {
+                const auto stats = ctx.frame_arena->stats();
+                ImGui::Text("Frame arena: %.1f KB last frame, %.1f KB peak, %.1f KB held, %llu heap blocks",
+                    stats.last_frame_bytes / 1024.0,
+                    stats.high_water_bytes / 1024.0,
+                    stats.capacity_bytes / 1024.0,
+                    static_cast<unsigned long long>(stats.upstream_allocations));
+            }
         }
 
         if (ImGui::CollapsingHeader("Controllers", ImGuiTreeNodeFlags_DefaultOpen))
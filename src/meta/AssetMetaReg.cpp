@@ -17,6 +17,7 @@
 #include "gpu/GpuAssetOps.hpp"
 #include "mock/MockAssetTypes.hpp"
 #include "Storage.hpp"
+#include "HeapBytes.hpp"
 #include "ResourceManager.hpp"
 #include "LogMacros.h"
 
@@ -53,6 +54,13 @@ namespace eeng {
             storage.assure_storage<T>();
         }
 
+        // Heap bytes owned by an asset, for Storage memory accounting
+        template<class T>
+        size_t memory_usage(const T& asset)
+        {
+            return heap_bytes_of(asset);
+        }
+
         template<class T>
         void load_asset(const Guid& guid, EngineContext& ctx)
         {
@@ -221,6 +229,9 @@ namespace eeng {
                 // Assure type storage
                 .template func<&assure_storage<T>, entt::as_void_t>(eeng::literals::assure_storage_hs)
 
+                // Heap memory owned by an instance
+                .template func<&memory_usage<T>>(eeng::literals::memory_usage_hs)
+
                 // Collect asset references
                 .template func<&meta::collect_asset_guids<T>, entt::as_void_t>(literals::collect_asset_guids_hs)
 
@@ -16,6 +16,9 @@ namespace eeng::literals
     constexpr entt::hashed_string inspect_hs = "inspect"_hs;
     constexpr entt::hashed_string post_assign_hs = "post_assign"_hs;
     constexpr entt::hashed_string assure_storage_hs = "assure_storage"_hs;
+    constexpr entt::hashed_string memory_usage_hs = "memory_usage"_hs;
+    constexpr entt::hashed_string cook_hs = "cook"_hs;
+    constexpr entt::hashed_string load_cooked_hs = "load_cooked"_hs;
 
     constexpr entt::hashed_string load_asset_hs = "load_asset"_hs;
     constexpr entt::hashed_string unload_asset_hs = "unload_asset"_hs;
@@ -7,7 +7,10 @@
 #include "MetaAux.h"
 #include "EngineContext.hpp"
 #include "ecs/HeaderComponent.hpp"
+#include "JsonStream.hpp"
+#include <deque>
 #include <iostream>
+#include <istream>
 #include <sstream>
 #include <cassert>
 #include <stdexcept>
@@ -563,6 +566,217 @@ namespace eeng::meta
         }
     }
 
+    namespace
+    {
+        // SAX handler behind the streaming deserialize_any. Reflected objects
+        // and sequence containers are filled as their tokens arrive; any other
+        // value is collected into a DOM of just that value and handed to the
+        // DOM deserialize_any, which keeps the two paths in agreement.
+        class MetaSaxReader : public JsonSaxHandler<MetaSaxReader>
+        {
+        public:
+            MetaSaxReader(
+                entt::meta_any& any,
+                const ecs::Entity& entity,
+                EngineContext& context,
+                SerializationPurpose purpose)
+                : root_(any)
+                , entity_(entity)
+                , context_(context)
+                , purpose_(purpose)
+            {
+            }
+
+            bool scalar(nlohmann::json&& value)
+            {
+                if (skip_depth_)
+                    return true;
+                if (dom_.building())
+                {
+                    dom_.value(std::move(value));
+                    return true;
+                }
+                if (entt::meta_any target = next_target(); target)
+                {
+                    deserialize_any(value, target, entity_, context_, purpose_);
+                    commit(target);
+                }
+                return true;
+            }
+
+            bool start_object(std::size_t)
+            {
+                return open(nlohmann::json::object());
+            }
+
+            bool start_array(std::size_t)
+            {
+                return open(nlohmann::json::array());
+            }
+
+            bool key(std::string& key)
+            {
+                if (skip_depth_)
+                    return true;
+                if (dom_.building())
+                    dom_.key(key);
+                else
+                    frames_.back().field = find_field(frames_.back(), key);
+                return true;
+            }
+
+            bool end_object()
+            {
+                return close();
+            }
+
+            bool end_array()
+            {
+                return close();
+            }
+
+        private:
+            struct Frame
+            {
+                entt::meta_any value;   // Object or sequence container being filled
+                entt::meta_type type;   // Reflected type of an object, empty for a sequence
+                entt::meta_data field;  // Object: member the next value goes to
+                size_t index = 0;       // Sequence: next element
+            };
+
+            bool open(nlohmann::json&& container)
+            {
+                if (skip_depth_)
+                {
+                    ++skip_depth_;
+                    return true;
+                }
+                if (dom_.building())
+                {
+                    dom_.open(std::move(container));
+                    return true;
+                }
+
+                entt::meta_any target = next_target();
+                if (!target)
+                {
+                    skip_depth_ = 1;
+                    return true;
+                }
+
+                entt::meta_type type = entt::resolve(target.type().id());
+                if (container.is_object() && type && !type.func(literals::deserialize_hs) && !type.is_enum())
+                    frames_.push_back(Frame{ std::move(target), type });
+                else if (container.is_array() && !type && target.type().is_sequence_container())
+                    frames_.push_back(Frame{ std::move(target) });
+                else
+                {
+                    dom_target_ = std::move(target);
+                    dom_.open(std::move(container));
+                }
+                return true;
+            }
+
+            bool close()
+            {
+                if (skip_depth_)
+                {
+                    --skip_depth_;
+                    return true;
+                }
+                if (dom_.building())
+                {
+                    if (dom_.close())
+                    {
+                        const nlohmann::json json = dom_.take();
+                        deserialize_any(json, dom_target_, entity_, context_, purpose_);
+                        commit(dom_target_);
+                        dom_target_.reset();
+                    }
+                    return true;
+                }
+
+                Frame frame = std::move(frames_.back());
+                frames_.pop_back();
+                // Drop elements beyond the ones read (no-op for fixed-size containers)
+                if (!frame.type)
+                    frame.value.as_sequence_container().resize(frame.index);
+                commit(frame.value);
+                return true;
+            }
+
+            // Destination of the next value: the pending member of the enclosing
+            // object, the next element of the enclosing sequence, or the root.
+            // Empty if the value is to be skipped.
+            entt::meta_any next_target()
+            {
+                if (frames_.empty())
+                    return root_.as_ref();
+
+                Frame& top = frames_.back();
+                if (top.type)
+                    return top.field ? top.field.get(top.value) : entt::meta_any{};
+
+                auto view = top.value.as_sequence_container();
+                assert(view && "as_sequence_container() failed");
+                if (top.index >= view.size() && !view.resize(top.index + 1))
+                    throw std::runtime_error("Too many elements for " + get_meta_type_display_name(top.value.type()));
+                return view[top.index];
+            }
+
+            // Stores a completed value in the enclosing object. Sequence elements
+            // and the root are filled in place.
+            void commit(entt::meta_any& value)
+            {
+                if (frames_.empty())
+                    return;
+
+                Frame& top = frames_.back();
+                if (top.type)
+                {
+                    top.field.set(top.value, value);
+                    top.field = {};
+                }
+                else
+                    ++top.index;
+            }
+
+            entt::meta_data find_field(const Frame& frame, const std::string& key) const
+            {
+                for (auto&& [id, meta_data] : frame.type.data())
+                {
+                    if (traits::is_serializable(meta_data, purpose_) &&
+                        get_meta_data_display_name(id, meta_data) == key)
+                        return meta_data;
+                }
+                return {};
+            }
+
+            entt::meta_any& root_;
+            const ecs::Entity& entity_;
+            EngineContext& context_;
+            SerializationPurpose purpose_;
+
+            std::deque<Frame> frames_;      // Deque: elements refer into their parents
+            JsonDomBuilder dom_;            // Value read whole
+            entt::meta_any dom_target_;     // ... and where it goes
+            size_t skip_depth_ = 0;         // Open containers of a skipped member
+        };
+    }
+
+    void deserialize_any(
+        std::istream& in,
+        entt::meta_any& any,
+        const ecs::Entity& entity,
+        EngineContext& context,
+        SerializationPurpose purpose)
+    {
+        assert(any);
+
+        MetaSaxReader reader{ any, entity, context, purpose };
+        nlohmann::json::sax_parse(in, &reader);
+    }
+
     ecs::EntityRef deserialize_entity(
         const nlohmann::json& json,
         EngineContext& ctx,
@@ -619,6 +833,11 @@ namespace eeng::meta
     /// @param json 
     /// @return 
     EntitySpawnDesc create_entity_spawn_desc(const nlohmann::json& json)
+    {
+        return create_entity_spawn_desc(nlohmann::json(json));
+    }
+
+    EntitySpawnDesc create_entity_spawn_desc(nlohmann::json&& json)
     {
         EntitySpawnDesc out;
         out.guid = Guid{ json["entity_guid"].get<Guid::underlying_type>() };
@@ -629,7 +848,7 @@ namespace eeng::meta
             c.type_id_str = comp_name;
             // c.type_id = entt::hashed_string::value(comp_name.c_str());
             //c.type_id = meta::resolve_by_type_id_string(comp_name).id(); // touches entt meta
-            c.data = comp_json;
+            c.data = std::move(comp_json);
             out.components.push_back(std::move(c));
         }
         return out;
@@ -6,6 +6,7 @@
 
 #include <entt/entt.hpp>
 #include <cstdint>
+#include <iosfwd>
 
 // Note: We're including the full nlohmann header and not just 
 // <nlohmann/json_fwd.hpp>. The expected usage of this header is on engine cpp:s
@@ -66,6 +67,21 @@ namespace eeng::meta
         SerializationPurpose purpose = SerializationPurpose::generic
     );
 
+    /// Streaming deserialize_any: reads the JSON text in `in` with a SAX parser
+    /// and fills reflected objects and sequence containers as tokens arrive,
+    /// so no DOM of the whole document is built. Values read by a custom
+    /// deserialize function, enums and associative containers are passed to
+    /// the DOM overload as a DOM of just that value. Members not found on the
+    /// type (or not serializable for `purpose`) are skipped.
+    /// Throws nlohmann::json::parse_error on malformed input.
+    void deserialize_any(
+        std::istream& in,
+        entt::meta_any& meta_any,
+        const ecs::Entity& entity,
+        EngineContext& context,
+        SerializationPurpose purpose = SerializationPurpose::generic
+    );
+
     /// One-shot deserialize-and-create entity from JSON
     // Entity is not registered to scene graph or chunk
     ecs::EntityRef deserialize_entity(
@@ -79,6 +95,11 @@ namespace eeng::meta
         const nlohmann::json& json
     );
 
+    // As above, but moves the component data out of json
+    EntitySpawnDesc create_entity_spawn_desc(
+        nlohmann::json&& json
+    );
+
     // Main-thread (touches entt::meta and entt::registry)
     ecs::EntityRef spawn_entity_from_desc(
         const EntitySpawnDesc& desc,
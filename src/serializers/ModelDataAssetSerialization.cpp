@@ -5,7 +5,12 @@
 #include "serializers/GLMSerialize.hpp"
 
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -13,6 +18,7 @@
 #include <nlohmann/json.hpp>
 
 #include "MetaLiterals.h"
+#include "MappedFile.hpp"
 #include "assets/types/ModelAssets.hpp"
 
 namespace eeng::serializers
@@ -138,30 +144,20 @@ namespace eeng::serializers
             return j;
         }
 
-        void deserialize_nodetree(const nlohmann::json& j, VecTree<assets::SkeletonNode>& tree)
+        // Rebuild a tree from nodes in depth-first order and their parent indices
+        void build_nodetree(
+            const std::vector<assets::SkeletonNode>& nodes,
+            const std::vector<int>& parents,
+            VecTree<assets::SkeletonNode>& tree)
         {
-            tree.clear();
-            if (!j.is_array())
-                return;
-            const size_t count = j.size();
-            std::vector<assets::SkeletonNode> nodes(count);
-            std::vector<int> parents(count, VecTree_NullIndex);
+            const size_t count = nodes.size();
             std::vector<std::vector<size_t>> children(count);
             std::vector<size_t> roots;
             for (size_t i = 0; i < count; i++)
             {
-                const auto& elem = j[i];
-                assets::SkeletonNode node{};
-                node.name = elem.value("name", "");
-                if (elem.contains("local_bind_tfm"))
-                    node.local_bind_tfm = deserialize_mat4(elem["local_bind_tfm"]);
-                node.bone_index = elem.value("bone_index", assets::null_index);
-                node.nbr_meshes = elem.value("nbr_meshes", 0);
-                nodes[i] = std::move(node);
-                const int parent_index = elem.value("parent_index", VecTree_NullIndex);
-                parents[i] = parent_index;
+                const int parent_index = parents[i];
                 if (parent_index == VecTree_NullIndex || parent_index < 0 ||
-                    static_cast<size_t>(parent_index) >= nodes.size())
+                    static_cast<size_t>(parent_index) >= count)
                 {
                     roots.push_back(i);
                 }
@@ -176,7 +172,7 @@ namespace eeng::serializers
             {
                 const int parent_index = parents[node_index];
                 if (parent_index == VecTree_NullIndex || parent_index < 0 ||
-                    static_cast<size_t>(parent_index) >= nodes.size())
+                    static_cast<size_t>(parent_index) >= count)
                 {
                     tree.insert_as_root(nodes[node_index]);
                 }
@@ -200,6 +196,29 @@ namespace eeng::serializers
                 insert_subtree(root_index, insert_subtree);
         }
 
+        void deserialize_nodetree(const nlohmann::json& j, VecTree<assets::SkeletonNode>& tree)
+        {
+            tree.clear();
+            if (!j.is_array())
+                return;
+            const size_t count = j.size();
+            std::vector<assets::SkeletonNode> nodes(count);
+            std::vector<int> parents(count, VecTree_NullIndex);
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto& elem = j[i];
+                assets::SkeletonNode node{};
+                node.name = elem.value("name", "");
+                if (elem.contains("local_bind_tfm"))
+                    node.local_bind_tfm = deserialize_mat4(elem["local_bind_tfm"]);
+                node.bone_index = elem.value("bone_index", assets::null_index);
+                node.nbr_meshes = elem.value("nbr_meshes", 0);
+                nodes[i] = std::move(node);
+                parents[i] = elem.value("parent_index", VecTree_NullIndex);
+            }
+            build_nodetree(nodes, parents, tree);
+        }
+
         nlohmann::json serialize_bones(const std::vector<assets::Bone>& values)
         {
             nlohmann::json j = nlohmann::json::array();
@@ -371,10 +390,455 @@ namespace eeng::serializers
             model.skin.resize(model.positions.size());
     }
 
+    // -------------------------------------------------------------------------
+    // Cooked binary format
+    // -------------------------------------------------------------------------
+
+    namespace
+    {
+        // Layout: CookedHeader, CookedSection[section_count], then the section
+        // payloads, each starting at a multiple of cooked_alignment. Values are
+        // stored in native byte order: cooked files are a local build product,
+        // the JSON stays the portable source.
+        constexpr char cooked_magic[4] = { 'E', 'M', 'D', 'A' };
+        constexpr size_t cooked_alignment = 16;
+
+        enum class CookedSectionId : uint32_t
+        {
+            Positions = 1,
+            Texcoords,
+            Normals,
+            Tangents,
+            Binormals,
+            Skin,
+            Indices,
+            SubMeshes,
+            Nodes,
+            Bones,
+            Clips,
+            Tracks,
+            Vec3Keys,   // Position and scale keys of all tracks
+            QuatKeys,   // Rotation keys of all tracks
+            Strings     // Names, referenced by CookedString
+        };
+
+        struct CookedHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t section_count;
+            uint32_t reserved;
+            uint64_t file_size;
+            uint64_t source_size;       // CookedSourceStamp of the JSON
+            int64_t source_write_time;
+        };
+
+        struct CookedSection
+        {
+            CookedSectionId id;
+            uint32_t stride;    // sizeof one element, checked on load
+            uint64_t offset;    // From the start of the file
+            uint64_t count;
+        };
+
+        struct CookedString
+        {
+            uint32_t offset = 0;
+            uint32_t size = 0;
+        };
+
+        struct CookedSubMesh
+        {
+            assets::u32 base_index;
+            assets::u32 nbr_indices;
+            assets::u32 base_vertex;
+            assets::u32 nbr_vertices;
+            Guid::underlying_type material;
+            assets::i32 node_index;
+            assets::u32 is_skinned;
+        };
+
+        struct CookedNode
+        {
+            glm::mat4 local_bind_tfm;
+            assets::i32 bone_index;
+            assets::i32 nbr_meshes;
+            assets::i32 parent_index;
+            CookedString name;
+        };
+
+        struct CookedBone
+        {
+            glm::mat4 inverse_bind_tfm;
+            assets::i32 node_index;
+            CookedString name;
+        };
+
+        struct CookedClip
+        {
+            CookedString name;
+            float duration_ticks;
+            float ticks_per_second;
+            assets::u32 first_track;
+            assets::u32 nbr_tracks;
+        };
+
+        struct CookedTrack
+        {
+            assets::u32 is_used;
+            assets::u32 first_pos_key;
+            assets::u32 nbr_pos_keys;
+            assets::u32 first_scale_key;
+            assets::u32 nbr_scale_keys;
+            assets::u32 first_rot_key;
+            assets::u32 nbr_rot_keys;
+        };
+
+        class CookedWriter
+        {
+            struct Payload
+            {
+                CookedSectionId id;
+                uint32_t stride;
+                const void* data;
+                uint64_t count;
+            };
+            std::vector<Payload> payloads_;
+            std::string strings_;
+
+            static size_t align(size_t offset)
+            {
+                return (offset + cooked_alignment - 1) & ~(cooked_alignment - 1);
+            }
+
+        public:
+            /// Add a section. The values are copied by finish(), so they must outlive it.
+            template<typename T>
+            void add(CookedSectionId id, const std::vector<T>& values)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                payloads_.push_back({ id, static_cast<uint32_t>(sizeof(T)), values.data(), values.size() });
+            }
+
+            CookedString add_string(const std::string& s)
+            {
+                CookedString ref{ static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(s.size()) };
+                strings_ += s;
+                return ref;
+            }
+
+            std::vector<std::byte> finish(const CookedSourceStamp& source)
+            {
+                payloads_.push_back({ CookedSectionId::Strings, 1, strings_.data(), strings_.size() });
+
+                std::vector<CookedSection> table;
+                size_t offset = align(sizeof(CookedHeader) + payloads_.size() * sizeof(CookedSection));
+                for (const auto& payload : payloads_)
+                {
+                    table.push_back({ payload.id, payload.stride, offset, payload.count });
+                    offset = align(offset + payload.stride * payload.count);
+                }
+
+                std::vector<std::byte> bytes(offset);
+                CookedHeader header{};
+                std::memcpy(header.magic, cooked_magic, sizeof(cooked_magic));
+                header.version = model_data_cooked_version;
+                header.section_count = static_cast<uint32_t>(table.size());
+                header.file_size = offset;
+                header.source_size = source.size;
+                header.source_write_time = source.write_time;
+                std::memcpy(bytes.data(), &header, sizeof(header));
+                std::memcpy(bytes.data() + sizeof(header), table.data(), table.size() * sizeof(CookedSection));
+                for (size_t i = 0; i < payloads_.size(); i++)
+                {
+                    if (payloads_[i].count)
+                        std::memcpy(bytes.data() + table[i].offset, payloads_[i].data, payloads_[i].stride * payloads_[i].count);
+                }
+                return bytes;
+            }
+        };
+
+        class CookedReader
+        {
+            std::span<const std::byte> bytes_;
+            std::vector<CookedSection> table_;
+            std::string_view strings_;
+
+            const CookedSection* find(CookedSectionId id) const
+            {
+                for (const auto& section : table_)
+                    if (section.id == id) return &section;
+                return nullptr;
+            }
+
+        public:
+            CookedReader(std::span<const std::byte> bytes, const CookedSourceStamp& source)
+                : bytes_(bytes)
+            {
+                CookedHeader header{};
+                if (bytes.size() < sizeof(header))
+                    throw std::runtime_error("Cooked model data: truncated header");
+                std::memcpy(&header, bytes.data(), sizeof(header));
+                if (std::memcmp(header.magic, cooked_magic, sizeof(cooked_magic)) != 0)
+                    throw std::runtime_error("Cooked model data: bad magic");
+                if (header.version != model_data_cooked_version)
+                    throw std::runtime_error("Cooked model data: unsupported version " + std::to_string(header.version));
+                if (header.file_size != bytes.size() ||
+                    header.section_count > (bytes.size() - sizeof(header)) / sizeof(CookedSection))
+                    throw std::runtime_error("Cooked model data: truncated file");
+                if (CookedSourceStamp{ header.source_size, header.source_write_time } != source)
+                    throw std::runtime_error("Cooked model data: stale, the source has changed");
+
+                table_.resize(header.section_count);
+                std::memcpy(table_.data(), bytes.data() + sizeof(header), table_.size() * sizeof(CookedSection));
+                for (const auto& section : table_)
+                {
+                    if (section.stride == 0 || section.offset > bytes.size() ||
+                        section.count > (bytes.size() - section.offset) / section.stride)
+                        throw std::runtime_error("Cooked model data: section out of bounds");
+                }
+
+                if (const auto* strings = find(CookedSectionId::Strings))
+                    strings_ = { reinterpret_cast<const char*>(bytes.data() + strings->offset), strings->count };
+            }
+
+            /// Bulk-copy a section into values, which is left empty if the section is missing
+            template<typename T>
+            void read(CookedSectionId id, std::vector<T>& values) const
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                values.clear();
+                const auto* section = find(id);
+                if (!section) return;
+                if (section->stride != sizeof(T))
+                    throw std::runtime_error("Cooked model data: unexpected element size");
+                values.resize(section->count);
+                if (section->count)
+                    std::memcpy(values.data(), bytes_.data() + section->offset, section->count * sizeof(T));
+            }
+
+            std::string string(CookedString ref) const
+            {
+                if (ref.offset > strings_.size() || ref.size > strings_.size() - ref.offset)
+                    throw std::runtime_error("Cooked model data: string out of bounds");
+                return std::string{ strings_.substr(ref.offset, ref.size) };
+            }
+        };
+
+        // Element [first, first + count) of a key pool, bounds-checked
+        template<typename T>
+        void copy_keys(const std::vector<T>& pool, assets::u32 first, assets::u32 count, std::vector<T>& keys)
+        {
+            if (first > pool.size() || count > pool.size() - first)
+                throw std::runtime_error("Cooked model data: key range out of bounds");
+            keys.assign(pool.begin() + first, pool.begin() + first + count);
+        }
+    }
+
+    CookedSourceStamp cooked_source_stamp(const std::filesystem::path& source_path)
+    {
+        return CookedSourceStamp{
+            static_cast<uint64_t>(std::filesystem::file_size(source_path)),
+            static_cast<int64_t>(std::filesystem::last_write_time(source_path).time_since_epoch().count()) };
+    }
+
+    std::vector<std::byte> cook_model_data(const assets::ModelDataAsset& model, const CookedSourceStamp& source)
+    {
+        CookedWriter writer;
+        writer.add(CookedSectionId::Positions, model.positions);
+        writer.add(CookedSectionId::Texcoords, model.texcoords);
+        writer.add(CookedSectionId::Normals, model.normals);
+        writer.add(CookedSectionId::Tangents, model.tangents);
+        writer.add(CookedSectionId::Binormals, model.binormals);
+        writer.add(CookedSectionId::Skin, model.skin);
+        writer.add(CookedSectionId::Indices, model.indices);
+
+        std::vector<CookedSubMesh> submeshes;
+        submeshes.reserve(model.submeshes.size());
+        for (const auto& sm : model.submeshes)
+        {
+            submeshes.push_back({ sm.base_index, sm.nbr_indices, sm.base_vertex, sm.nbr_vertices,
+                sm.material.guid.raw(), sm.node_index, sm.is_skinned ? 1u : 0u });
+        }
+        writer.add(CookedSectionId::SubMeshes, submeshes);
+
+        std::vector<CookedNode> nodes(model.nodetree.size());
+        model.nodetree.traverse_depthfirst([&](const assets::SkeletonNode* node,
+            const assets::SkeletonNode*,
+            size_t node_index,
+            size_t parent_index)
+            {
+                const int parent_out = (parent_index == static_cast<size_t>(VecTree_NullIndex))
+                    ? VecTree_NullIndex
+                    : static_cast<int>(parent_index);
+                nodes[node_index] = { node->local_bind_tfm, node->bone_index, node->nbr_meshes,
+                    parent_out, writer.add_string(node->name) };
+            });
+        writer.add(CookedSectionId::Nodes, nodes);
+
+        std::vector<CookedBone> bones;
+        bones.reserve(model.bones.size());
+        for (const auto& bone : model.bones)
+            bones.push_back({ bone.inverse_bind_tfm, bone.node_index, writer.add_string(bone.name) });
+        writer.add(CookedSectionId::Bones, bones);
+
+        // Tracks of all clips in one table, keys of all tracks in two pools
+        std::vector<CookedClip> clips;
+        std::vector<CookedTrack> tracks;
+        std::vector<glm::vec3> vec3_keys;
+        std::vector<glm::quat> quat_keys;
+        for (const auto& clip : model.animations)
+        {
+            clips.push_back({ writer.add_string(clip.name), clip.duration_ticks, clip.ticks_per_second,
+                static_cast<assets::u32>(tracks.size()), static_cast<assets::u32>(clip.node_animations.size()) });
+            for (const auto& track : clip.node_animations)
+            {
+                CookedTrack cooked{};
+                cooked.is_used = track.is_used ? 1u : 0u;
+                cooked.first_pos_key = static_cast<assets::u32>(vec3_keys.size());
+                cooked.nbr_pos_keys = static_cast<assets::u32>(track.pos_keys.size());
+                vec3_keys.insert(vec3_keys.end(), track.pos_keys.begin(), track.pos_keys.end());
+                cooked.first_scale_key = static_cast<assets::u32>(vec3_keys.size());
+                cooked.nbr_scale_keys = static_cast<assets::u32>(track.scale_keys.size());
+                vec3_keys.insert(vec3_keys.end(), track.scale_keys.begin(), track.scale_keys.end());
+                cooked.first_rot_key = static_cast<assets::u32>(quat_keys.size());
+                cooked.nbr_rot_keys = static_cast<assets::u32>(track.rot_keys.size());
+                quat_keys.insert(quat_keys.end(), track.rot_keys.begin(), track.rot_keys.end());
+                tracks.push_back(cooked);
+            }
+        }
+        writer.add(CookedSectionId::Clips, clips);
+        writer.add(CookedSectionId::Tracks, tracks);
+        writer.add(CookedSectionId::Vec3Keys, vec3_keys);
+        writer.add(CookedSectionId::QuatKeys, quat_keys);
+
+        return writer.finish(source);
+    }
+
+    void read_cooked_model_data(std::span<const std::byte> bytes, assets::ModelDataAsset& model, const CookedSourceStamp& source)
+    {
+        const CookedReader reader(bytes, source);
+
+        reader.read(CookedSectionId::Positions, model.positions);
+        reader.read(CookedSectionId::Texcoords, model.texcoords);
+        reader.read(CookedSectionId::Normals, model.normals);
+        reader.read(CookedSectionId::Tangents, model.tangents);
+        reader.read(CookedSectionId::Binormals, model.binormals);
+        reader.read(CookedSectionId::Skin, model.skin);
+        reader.read(CookedSectionId::Indices, model.indices);
+
+        std::vector<CookedSubMesh> submeshes;
+        reader.read(CookedSectionId::SubMeshes, submeshes);
+        model.submeshes.resize(submeshes.size());
+        for (size_t i = 0; i < submeshes.size(); i++)
+        {
+            const auto& cooked = submeshes[i];
+            auto& sm = model.submeshes[i];
+            sm.base_index = cooked.base_index;
+            sm.nbr_indices = cooked.nbr_indices;
+            sm.base_vertex = cooked.base_vertex;
+            sm.nbr_vertices = cooked.nbr_vertices;
+            sm.node_index = cooked.node_index;
+            sm.is_skinned = cooked.is_skinned != 0;
+            sm.material = AssetRef<assets::MaterialAsset>{ Guid{ cooked.material } };
+        }
+
+        std::vector<CookedNode> cooked_nodes;
+        reader.read(CookedSectionId::Nodes, cooked_nodes);
+        std::vector<assets::SkeletonNode> nodes(cooked_nodes.size());
+        std::vector<int> parents(cooked_nodes.size());
+        for (size_t i = 0; i < cooked_nodes.size(); i++)
+        {
+            nodes[i].local_bind_tfm = cooked_nodes[i].local_bind_tfm;
+            nodes[i].bone_index = cooked_nodes[i].bone_index;
+            nodes[i].nbr_meshes = cooked_nodes[i].nbr_meshes;
+            nodes[i].name = reader.string(cooked_nodes[i].name);
+            parents[i] = cooked_nodes[i].parent_index;
+        }
+        model.nodetree.clear();
+        build_nodetree(nodes, parents, model.nodetree);
+
+        std::vector<CookedBone> bones;
+        reader.read(CookedSectionId::Bones, bones);
+        model.bones.resize(bones.size());
+        for (size_t i = 0; i < bones.size(); i++)
+        {
+            model.bones[i].inverse_bind_tfm = bones[i].inverse_bind_tfm;
+            model.bones[i].node_index = bones[i].node_index;
+            model.bones[i].name = reader.string(bones[i].name);
+        }
+
+        std::vector<CookedClip> clips;
+        std::vector<CookedTrack> tracks;
+        std::vector<glm::vec3> vec3_keys;
+        std::vector<glm::quat> quat_keys;
+        reader.read(CookedSectionId::Clips, clips);
+        reader.read(CookedSectionId::Tracks, tracks);
+        reader.read(CookedSectionId::Vec3Keys, vec3_keys);
+        reader.read(CookedSectionId::QuatKeys, quat_keys);
+        model.animations.resize(clips.size());
+        for (size_t c = 0; c < clips.size(); c++)
+        {
+            const auto& cooked = clips[c];
+            auto& clip = model.animations[c];
+            clip.name = reader.string(cooked.name);
+            clip.duration_ticks = cooked.duration_ticks;
+            clip.ticks_per_second = cooked.ticks_per_second;
+            if (cooked.first_track > tracks.size() || cooked.nbr_tracks > tracks.size() - cooked.first_track)
+                throw std::runtime_error("Cooked model data: track range out of bounds");
+            clip.node_animations.resize(cooked.nbr_tracks);
+            for (size_t t = 0; t < cooked.nbr_tracks; t++)
+            {
+                const auto& cooked_track = tracks[cooked.first_track + t];
+                auto& track = clip.node_animations[t];
+                track.is_used = cooked_track.is_used != 0;
+                copy_keys(vec3_keys, cooked_track.first_pos_key, cooked_track.nbr_pos_keys, track.pos_keys);
+                copy_keys(vec3_keys, cooked_track.first_scale_key, cooked_track.nbr_scale_keys, track.scale_keys);
+                copy_keys(quat_keys, cooked_track.first_rot_key, cooked_track.nbr_rot_keys, track.rot_keys);
+            }
+        }
+
+        if (model.skin.empty() && !model.positions.empty())
+            model.skin.resize(model.positions.size());
+    }
+
+    void write_cooked_model_data_file(const assets::ModelDataAsset& model, const std::filesystem::path& path, const CookedSourceStamp& source)
+    {
+        const auto bytes = cook_model_data(model, source);
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            throw std::runtime_error("Failed to open cooked file for writing: " + path.string());
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!out)
+            throw std::runtime_error("Failed to write cooked file: " + path.string());
+    }
+
+    void read_cooked_model_data_file(const std::filesystem::path& path, assets::ModelDataAsset& model, const CookedSourceStamp& source)
+    {
+        const MappedFile file(path);
+        read_cooked_model_data(file.bytes(), model, source);
+    }
+
+    void cook_ModelDataAsset(const entt::meta_any& any, const std::filesystem::path& path, const std::filesystem::path& source_path)
+    {
+        auto ptr = any.try_cast<assets::ModelDataAsset>();
+        assert(ptr && "cook_ModelDataAsset: bad meta_any");
+        write_cooked_model_data_file(*ptr, path, cooked_source_stamp(source_path));
+    }
+
+    void load_cooked_ModelDataAsset(const std::filesystem::path& path, const std::filesystem::path& source_path, entt::meta_any& any)
+    {
+        auto ptr = any.try_cast<assets::ModelDataAsset>();
+        assert(ptr && "load_cooked_ModelDataAsset: bad meta_any");
+        read_cooked_model_data_file(path, *ptr, cooked_source_stamp(source_path));
+    }
+
     void register_modeldataasset_serialization()
     {
         entt::meta_factory<assets::ModelDataAsset>{}
             .func<&serialize_ModelDataAsset>(eeng::literals::serialize_hs)
-            .func<&deserialize_ModelDataAsset>(eeng::literals::deserialize_hs);
+            .func<&deserialize_ModelDataAsset>(eeng::literals::deserialize_hs)
+            .func<&cook_ModelDataAsset>(eeng::literals::cook_hs)
+            .func<&load_cooked_ModelDataAsset>(eeng::literals::load_cooked_hs);
     }
 }
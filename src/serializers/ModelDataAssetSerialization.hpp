@@ -5,16 +5,58 @@
 
 #include <nlohmann/json_fwd.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
 namespace entt
 {
     class meta_any;
 }
 
+namespace eeng::assets
+{
+    struct ModelDataAsset;
+}
+
 namespace eeng::serializers
 {
     void serialize_ModelDataAsset(nlohmann::json& j, const entt::meta_any& any);
     void deserialize_ModelDataAsset(const nlohmann::json& j, entt::meta_any& any);
 
+    // Cooked binary format: a versioned container of aligned, typed sections
+    // (vertex streams, indices, skin, submeshes, node tree, bones, clips,
+    // tracks and key pools). Loading bulk-copies each section, with no
+    // per-value parsing. JSON remains the authoring format.
+    // Readers throw std::runtime_error on a bad, truncated, outdated or stale file.
+    constexpr uint32_t model_data_cooked_version = 2;
+
+    // Size and write time of the JSON a cooked file was built from, stored in
+    // its header. A cooked file whose stamp differs from the current JSON is
+    // stale and rejected like one of an unsupported version.
+    struct CookedSourceStamp
+    {
+        uint64_t size = 0;
+        int64_t write_time = 0; // file_time_type ticks
+
+        bool operator==(const CookedSourceStamp&) const = default;
+    };
+    // Throws std::filesystem::filesystem_error if the file is missing
+    CookedSourceStamp cooked_source_stamp(const std::filesystem::path& source_path);
+
+    std::vector<std::byte> cook_model_data(const assets::ModelDataAsset& model, const CookedSourceStamp& source = {});
+    void read_cooked_model_data(std::span<const std::byte> bytes, assets::ModelDataAsset& model, const CookedSourceStamp& source = {});
+
+    void write_cooked_model_data_file(const assets::ModelDataAsset& model, const std::filesystem::path& path, const CookedSourceStamp& source = {});
+    // Memory-maps the file and reads the sections straight from the mapped pages
+    void read_cooked_model_data_file(const std::filesystem::path& path, assets::ModelDataAsset& model, const CookedSourceStamp& source = {});
+
+    // Hooks: source_path is the asset's JSON, stamped into / checked against the cooked file
+    void cook_ModelDataAsset(const entt::meta_any& any, const std::filesystem::path& path, const std::filesystem::path& source_path);
+    void load_cooked_ModelDataAsset(const std::filesystem::path& path, const std::filesystem::path& source_path, entt::meta_any& any);
+
     // Register ModelDataAsset serialization hooks with entt meta.
     void register_modeldataasset_serialization();
 }
@@ -0,0 +1,109 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef AppendOnlyTable_h
+#define AppendOnlyTable_h
+
+#include <algorithm> // std::copy_n, std::max
+#include <atomic>
+#include <cassert>
+#include <memory> // std::unique_ptr
+#include <utility> // std::exchange
+#include <vector>
+
+namespace eeng {
+
+    // --- AppendOnlyTable -----------------------------------------------------
+
+    // Growable array of pointers that can be read without a lock
+    // * One writer at a time, under the owner's lock: push_back, pop_back, clear
+    // * Readers index the current array after one acquire load. Growing copies it
+    //   into an array twice the size and keeps the old arrays until clear(), so a
+    //   reader still holding an old array reads valid entries
+    // * pop_back, clear and moves need that no reader is active
+    // * The pointees are not owned
+
+    template<class P>
+    class AppendOnlyTable
+    {
+        std::atomic<P*> m_items{ nullptr };     // Current array
+        std::atomic<size_t> m_size{ 0 };
+        size_t m_capacity = 0;
+        std::vector<std::unique_ptr<P[]>> m_arrays; // Current array last
+
+    public:
+        AppendOnlyTable() = default;
+        AppendOnlyTable(const AppendOnlyTable&) = delete;
+        AppendOnlyTable& operator=(const AppendOnlyTable&) = delete;
+
+        AppendOnlyTable(AppendOnlyTable&& rhs) noexcept
+        {
+            *this = std::move(rhs);
+        }
+
+        AppendOnlyTable& operator=(AppendOnlyTable&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                m_items.store(rhs.m_items.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+                m_size.store(rhs.m_size.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                m_capacity = std::exchange(rhs.m_capacity, 0);
+                m_arrays = std::move(rhs.m_arrays);
+                rhs.m_arrays.clear();
+            }
+            return *this;
+        }
+
+        P operator[](size_t i) const
+        {
+            assert(i < size());
+            return m_items.load(std::memory_order_acquire)[i];
+        }
+
+        size_t size() const
+        {
+            return m_size.load(std::memory_order_acquire);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        P back() const
+        {
+            return (*this)[size() - 1];
+        }
+
+        void push_back(P item)
+        {
+            const size_t n = m_size.load(std::memory_order_relaxed);
+            if (n == m_capacity)
+            {
+                m_capacity = std::max<size_t>(m_capacity * 2, 8);
+                auto array = std::make_unique<P[]>(m_capacity);
+                if (n) std::copy_n(m_items.load(std::memory_order_relaxed), n, array.get());
+                m_items.store(array.get(), std::memory_order_release);
+                m_arrays.push_back(std::move(array));
+            }
+            m_items.load(std::memory_order_relaxed)[n] = item;
+            m_size.store(n + 1, std::memory_order_release);
+        }
+
+        void pop_back()
+        {
+            assert(!empty());
+            m_size.store(m_size.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+        }
+
+        void clear()
+        {
+            m_items.store(nullptr, std::memory_order_relaxed);
+            m_size.store(0, std::memory_order_relaxed);
+            m_capacity = 0;
+            m_arrays.clear();
+        }
+    };
+
+} // namespace eeng
+
+#endif /* AppendOnlyTable_h */
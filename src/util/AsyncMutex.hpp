@@ -0,0 +1,144 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#pragma once
+#include "IExecutor.hpp"
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/// FIFO mutex for coroutines.
+///
+/// `co_await mutex.lock(executor)` suspends until the mutex is free, holding no
+/// thread while waiting, and continues the coroutine as a task on `executor`.
+/// The coroutine owns the mutex until the returned Lock is destroyed, across
+/// any suspensions in between. Use it to keep a multi-step coroutine exclusive
+/// where a strand alone would only serialize the steps:
+///
+/// @code
+/// auto lock = co_await gate.lock(strand);   // now on the strand, owning gate
+/// auto data = prepare();
+/// co_await mtq.schedule();                  // strand free, gate still held
+/// apply(data);
+/// @endcode
+class AsyncMutex
+{
+public:
+    /// Ownership of the mutex, released on destruction
+    class Lock
+    {
+    public:
+        Lock() noexcept = default;
+        explicit Lock(AsyncMutex* mutex) noexcept : mutex_(mutex) {}
+        Lock(Lock&& other) noexcept : mutex_(std::exchange(other.mutex_, nullptr)) {}
+        Lock& operator=(Lock&& other) noexcept
+        {
+            if (this != &other)
+            {
+                unlock();
+                mutex_ = std::exchange(other.mutex_, nullptr);
+            }
+            return *this;
+        }
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+        ~Lock() { unlock(); }
+
+        bool owns_lock() const noexcept { return mutex_ != nullptr; }
+
+        void unlock()
+        {
+            if (mutex_) std::exchange(mutex_, nullptr)->release();
+        }
+
+    private:
+        AsyncMutex* mutex_ = nullptr;
+    };
+
+    struct LockAwaiter
+    {
+        AsyncMutex& mutex;
+        IExecutor& executor;
+        std::optional<TaskPriority> priority; // None: the executor's default lane
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> awaiting) { mutex.acquire({ awaiting, &executor, priority }); }
+        Lock await_resume() noexcept { return Lock{ &mutex }; }
+    };
+
+    AsyncMutex() = default;
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+    /// co_await to own the mutex and continue as a task on `resume_on`
+    LockAwaiter lock(IExecutor& resume_on) { return { *this, resume_on, std::nullopt }; }
+    LockAwaiter lock(IExecutor& resume_on, TaskPriority priority) { return { *this, resume_on, priority }; }
+
+    /// True while owned
+    bool is_locked() const
+    {
+        std::lock_guard lk(mutex_);
+        return locked_;
+    }
+
+    /// Block until the mutex is free and nobody waits for it
+    void wait_idle()
+    {
+        std::unique_lock lk(mutex_);
+        idle_cv_.wait(lk, [&] { return !locked_; });
+    }
+
+private:
+    struct Waiter
+    {
+        std::coroutine_handle<> handle;
+        IExecutor* executor = nullptr;
+        std::optional<TaskPriority> priority;
+    };
+
+    void acquire(Waiter waiter)
+    {
+        {
+            std::lock_guard lk(mutex_);
+            if (locked_)
+            {
+                waiters_.push_back(waiter);
+                return;
+            }
+            locked_ = true;
+        }
+        resume(waiter);
+    }
+
+    void release()
+    {
+        Waiter next;
+        {
+            std::lock_guard lk(mutex_);
+            if (waiters_.empty())
+            {
+                locked_ = false;
+                idle_cv_.notify_all();
+                return;
+            }
+            // Hand over without unlocking, so waiters are served in order
+            next = waiters_.front();
+            waiters_.pop_front();
+        }
+        resume(next);
+    }
+
+    static void resume(const Waiter& waiter)
+    {
+        auto task = [handle = waiter.handle]() { handle.resume(); };
+        if (waiter.priority) waiter.executor->post(task, *waiter.priority);
+        else waiter.executor->post(task);
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_cv_;
+    bool locked_ = false;
+    std::deque<Waiter> waiters_;
+};
@@ -0,0 +1,301 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef COTASK_HPP
+#define COTASK_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename T = void>
+class CoTask;
+
+namespace cotask_detail
+{
+    struct PromiseBase
+    {
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::exception_ptr error;
+
+        // Lazy: the body starts when the task is awaited
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Resume the awaiting coroutine directly (symmetric transfer, no stack growth)
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template <typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+            {
+                return h.promise().continuation;
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+    };
+
+    template <typename T>
+    struct Promise : PromiseBase
+    {
+        std::optional<T> value;
+
+        CoTask<T> get_return_object() noexcept;
+
+        template <typename U>
+        void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+
+        T result()
+        {
+            if (error) std::rethrow_exception(error);
+            return std::move(*value);
+        }
+    };
+
+    template <>
+    struct Promise<void> : PromiseBase
+    {
+        CoTask<void> get_return_object() noexcept;
+
+        void return_void() noexcept {}
+
+        void result()
+        {
+            if (error) std::rethrow_exception(error);
+        }
+    };
+
+    // Eager, self-destroying coroutine used by spawn()
+    struct Detached
+    {
+        struct promise_type
+        {
+            Detached get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+}
+
+/// Lazily started coroutine returning T.
+///
+/// A CoTask does nothing until it is co_awaited (or passed to spawn()), and
+/// the awaiting coroutine is resumed on whichever thread finishes the task.
+/// Combine with the executor awaitables to move between threads:
+///
+/// @code
+/// CoTask<int> load(ThreadPool& pool, MainThreadQueue& mtq)
+/// {
+///     co_await pool.schedule();          // now on a worker
+///     int n = parse();
+///     co_await mtq.schedule();           // now on the main thread
+///     upload(n);
+///     co_return n;
+/// }
+/// @endcode
+///
+/// Exceptions thrown by the body are rethrown at the co_await (or stored in
+/// the spawn() future).
+/// @note Coroutine parameters are captured at the call but used later, so take
+///       them by value rather than by reference to temporaries.
+template <typename T>
+class [[nodiscard]] CoTask
+{
+public:
+    using promise_type = cotask_detail::Promise<T>;
+    using value_type = T;
+
+    CoTask() noexcept = default;
+
+    CoTask(CoTask&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr))
+    {
+    }
+
+    CoTask& operator=(CoTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    CoTask(const CoTask&) = delete;
+    CoTask& operator=(const CoTask&) = delete;
+
+    ~CoTask()
+    {
+        if (handle) handle.destroy();
+    }
+
+    bool valid() const noexcept { return static_cast<bool>(handle); }
+
+    auto operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+            {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().result(); }
+        };
+        return Awaiter{ handle };
+    }
+
+private:
+    friend promise_type;
+    explicit CoTask(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+namespace cotask_detail
+{
+    template <typename T>
+    CoTask<T> Promise<T>::get_return_object() noexcept
+    {
+        return CoTask<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline CoTask<void> Promise<void>::get_return_object() noexcept
+    {
+        return CoTask<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+
+    template <typename T>
+    Detached run_detached(CoTask<T> task, std::promise<T> promise)
+    {
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await task;
+                promise.set_value();
+            }
+            else
+            {
+                promise.set_value(co_await task);
+            }
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+namespace cotask_detail
+{
+    template <typename T>
+    struct WhenAllState
+    {
+        explicit WhenAllState(size_t count) : remaining(count + 1), results(count) {}
+
+        std::atomic<size_t> remaining; // Tasks still running, plus one until all are started
+        std::coroutine_handle<> continuation;
+        std::vector<std::optional<T>> results;
+        std::mutex error_mutex;
+        std::exception_ptr error;      // First exception thrown by a task
+
+        // Returns true for the last arrival, which resumes the awaiting coroutine
+        bool arrive() noexcept
+        {
+            return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+    };
+
+    template <typename T>
+    Detached run_when_all_child(CoTask<T> task, std::shared_ptr<WhenAllState<T>> state, size_t index)
+    {
+        try
+        {
+            state->results[index].emplace(co_await task);
+        }
+        catch (...)
+        {
+            std::lock_guard lock(state->error_mutex);
+            if (!state->error) state->error = std::current_exception();
+        }
+        if (state->arrive())
+            state->continuation.resume();
+    }
+}
+
+/// @brief Run tasks concurrently and resume when all of them are done.
+/// Each task starts on the calling thread and runs there until its first
+/// suspension, so tasks normally begin with an executor hop. The awaiting
+/// coroutine resumes on the thread that finishes last.
+/// @return The results in task order. The first exception thrown by any task
+///         is rethrown once all have finished.
+template <typename T>
+CoTask<std::vector<T>> when_all(std::vector<CoTask<T>> tasks)
+{
+    using State = cotask_detail::WhenAllState<T>;
+    auto state = std::make_shared<State>(tasks.size());
+
+    // Refers to the state owned by the frame: a temporary awaiter should not own anything
+    struct Awaiter
+    {
+        std::vector<CoTask<T>>& tasks;
+        const std::shared_ptr<State>& state;
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            state->continuation = awaiting;
+            for (size_t i = 0; i < tasks.size(); ++i)
+                cotask_detail::run_when_all_child(std::move(tasks[i]), state, i);
+
+            // All started: stay suspended unless every task has already finished
+            return !state->arrive();
+        }
+
+        void await_resume() const noexcept {}
+    };
+    co_await Awaiter{ tasks, state };
+
+    if (state->error) std::rethrow_exception(state->error);
+    std::vector<T> results;
+    results.reserve(state->results.size());
+    for (auto& result : state->results)
+        results.push_back(std::move(*result));
+    co_return results;
+}
+
+/// @brief Start a task now and return a future for its result.
+/// Bridges coroutines to future-based callers; the task runs on the calling
+/// thread until its first suspension.
+template <typename T>
+std::shared_future<T> spawn(CoTask<T> task)
+{
+    std::promise<T> promise;
+    auto future = promise.get_future().share();
+    cotask_detail::run_detached(std::move(task), std::move(promise));
+    return future;
+}
+
+#endif // COTASK_HPP
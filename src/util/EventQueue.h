@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <algorithm>
 #include <vector>
+#include <memory_resource>
 #include <iostream>
 
 namespace internal
@@ -106,13 +107,17 @@ public:
     }
 
     /// Dispatch and remove all remaining events
-    void dispatch_all_events()
+    /// @param scratch Memory for the batch being dispatched, e.g. a frame arena.
+    ///        The queue keeps its own buffer, so steady traffic does not allocate.
+    void dispatch_all_events(std::pmr::memory_resource* scratch = std::pmr::get_default_resource())
     {
-        // swap out the whole queue under lock, then process unlocked
-        std::vector<std::any> work;
+        // move out the whole queue under lock, then process unlocked
+        std::pmr::vector<std::any> work(scratch); // Not braces: std::any would take the pointer
         {
             std::lock_guard lock(events_mutex);
-            work.swap(events);
+            work.assign(std::make_move_iterator(events.begin()),
+                std::make_move_iterator(events.end()));
+            events.clear();
         }
         for (auto& e : work)
             dispatch_event(e);
@@ -0,0 +1,220 @@
+#include "ExecutorStats.hpp"
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    std::atomic<size_t> next_thread_index{ 0 };
+
+    std::string escape_json(const std::string& text)
+    {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\') out.push_back('\\');
+            out.push_back(c);
+        }
+        return out;
+    }
+}
+
+ExecutorStats::ExecutorStats(std::string name)
+    : name_(std::move(name))
+{
+}
+
+ExecutorStats::~ExecutorStats()
+{
+    Slot* slots = slots_.load(std::memory_order_acquire);
+    if (!slots) return;
+    for (size_t i = 0; i < slot_count; ++i)
+        delete[] slots[i].trace.load(std::memory_order_acquire);
+    delete[] slots;
+}
+
+void ExecutorStats::enable(bool on)
+{
+    if (on && !slots_.load(std::memory_order_acquire))
+    {
+        Slot* slots = new Slot[slot_count];
+        Slot* expected = nullptr;
+        if (!slots_.compare_exchange_strong(expected, slots, std::memory_order_acq_rel))
+            delete[] slots;
+    }
+    enabled_.store(on, std::memory_order_release);
+}
+
+size_t ExecutorStats::thread_index()
+{
+    thread_local const size_t index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+void ExecutorStats::push_event(const char* name, char phase, uint64_t ts, uint64_t value)
+{
+    Slot* slot = local_slot();
+    if (!slot) return;
+
+    TraceEvent* ring = slot->trace.load(std::memory_order_acquire);
+    if (!ring)
+    {
+        TraceEvent* fresh = new TraceEvent[trace_capacity];
+        if (slot->trace.compare_exchange_strong(ring, fresh, std::memory_order_acq_rel))
+            ring = fresh;
+        else
+            delete[] fresh;
+    }
+
+    // Seqlock-style publish, so an exporter never sees a half-written event
+    const uint64_t claim = slot->trace_claimed.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent& e = ring[claim % trace_capacity];
+    e.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    e.name.store(name, std::memory_order_relaxed);
+    e.phase.store(phase, std::memory_order_relaxed);
+    e.ts.store(ts, std::memory_order_relaxed);
+    e.value.store(value, std::memory_order_relaxed);
+    e.seq.store(claim + 1, std::memory_order_release);
+}
+
+Histogram ExecutorStats::histogram(ExecutorMetric metric) const
+{
+    Histogram out;
+    const Slot* slots = slots_.load(std::memory_order_acquire);
+    if (!slots) return out;
+
+    for (size_t i = 0; i < slot_count; ++i)
+    {
+        const auto& h = slots[i].metrics[static_cast<size_t>(metric)];
+        for (size_t b = 0; b < Histogram::bucket_count; ++b)
+            out.buckets[b] += h.buckets[b].load(std::memory_order_relaxed);
+        out.count += h.count.load(std::memory_order_relaxed);
+        out.sum += h.sum.load(std::memory_order_relaxed);
+        out.max = std::max(out.max, h.max.load(std::memory_order_relaxed));
+    }
+    return out;
+}
+
+void ExecutorStats::reset()
+{
+    Slot* slots = slots_.load(std::memory_order_acquire);
+    if (!slots) return;
+
+    for (size_t i = 0; i < slot_count; ++i)
+    {
+        for (auto& h : slots[i].metrics)
+        {
+            for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+            h.count.store(0, std::memory_order_relaxed);
+            h.sum.store(0, std::memory_order_relaxed);
+            h.max.store(0, std::memory_order_relaxed);
+        }
+        if (TraceEvent* ring = slots[i].trace.load(std::memory_order_acquire))
+        {
+            for (size_t k = 0; k < trace_capacity; ++k)
+                ring[k].seq.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const char* ExecutorStats::metric_name(ExecutorMetric metric)
+{
+    switch (metric)
+    {
+    case ExecutorMetric::QueueLatency: return "queue_latency_ns";
+    case ExecutorMetric::RunTime:      return "run_time_ns";
+    case ExecutorMetric::QueueDepth:   return "queue_depth";
+    case ExecutorMetric::StrandHold:   return "strand_hold_ns";
+    case ExecutorMetric::BlockedWait:  return "blocked_wait_ns";
+    }
+    return "unknown";
+}
+
+std::string ExecutorStats::to_json() const
+{
+    std::ostringstream os;
+    os << "{\"name\":\"" << escape_json(name_) << "\",\"metrics\":{";
+    for (size_t m = 0; m < ExecutorMetricCount; ++m)
+    {
+        const auto metric = static_cast<ExecutorMetric>(m);
+        const Histogram h = histogram(metric);
+
+        // Trailing empty buckets are left out
+        size_t used = Histogram::bucket_count;
+        while (used > 0 && h.buckets[used - 1] == 0) --used;
+
+        if (m) os << ',';
+        os << '"' << metric_name(metric) << "\":{"
+            << "\"count\":" << h.count
+            << ",\"mean\":" << h.mean()
+            << ",\"p50\":" << h.percentile(0.5)
+            << ",\"p90\":" << h.percentile(0.9)
+            << ",\"p99\":" << h.percentile(0.99)
+            << ",\"max\":" << h.max
+            << ",\"buckets\":[";
+        for (size_t b = 0; b < used; ++b)
+            os << (b ? "," : "") << h.buckets[b];
+        os << "]}";
+    }
+    os << "}}";
+    return os.str();
+}
+
+std::string ExecutorStats::to_chrome_trace() const
+{
+    struct Event
+    {
+        const char* name;
+        char phase;
+        uint64_t ts;
+        uint64_t value;
+        size_t tid;
+    };
+    std::vector<Event> events;
+
+    if (const Slot* slots = slots_.load(std::memory_order_acquire))
+    {
+        for (size_t i = 0; i < slot_count; ++i)
+        {
+            const TraceEvent* ring = slots[i].trace.load(std::memory_order_acquire);
+            if (!ring) continue;
+            for (size_t k = 0; k < trace_capacity; ++k)
+            {
+                const TraceEvent& e = ring[k];
+                const uint64_t seq = e.seq.load(std::memory_order_acquire);
+                if (seq == 0) continue;
+                Event copy{
+                    e.name.load(std::memory_order_relaxed),
+                    e.phase.load(std::memory_order_relaxed),
+                    e.ts.load(std::memory_order_relaxed),
+                    e.value.load(std::memory_order_relaxed),
+                    i };
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (e.seq.load(std::memory_order_relaxed) != seq || !copy.name) continue; // Overwritten meanwhile
+                events.push_back(copy);
+            }
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.ts < b.ts; });
+
+    std::ostringstream os;
+    os.setf(std::ios::fixed);
+    os.precision(3);
+    const std::string cat = escape_json(name_);
+    os << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const Event& e = events[i];
+        if (i) os << ',';
+        os << "{\"name\":\"" << e.name << "\",\"cat\":\"" << cat << "\",\"ph\":\"" << e.phase
+            << "\",\"ts\":" << double(e.ts) / 1000.0 << ",\"pid\":1,\"tid\":" << e.tid;
+        if (e.phase == 'X')
+            os << ",\"dur\":" << double(e.value) / 1000.0;
+        else
+            os << ",\"args\":{\"value\":" << e.value << '}';
+        os << '}';
+    }
+    os << "]}";
+    return os.str();
+}
@@ -0,0 +1,187 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef EXECUTORSTATS_HPP
+#define EXECUTORSTATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// What an ExecutorStats histogram measures
+enum class ExecutorMetric : uint8_t
+{
+    QueueLatency,   // ns from post/push to the task starting
+    RunTime,        // ns a task ran
+    QueueDepth,     // Tasks queued, sampled at each post/push
+    StrandHold,     // ns a SerialExecutor drain occupied a worker
+    BlockedWait,    // ns a pool worker blocked in wait()/get() with nothing to help with
+};
+
+inline constexpr size_t ExecutorMetricCount = 5;
+
+/// Histogram with power-of-two buckets: bucket 0 holds 0 and 1, bucket i
+/// holds [2^i, 2^(i+1)). Plain values; see ExecutorStats for the concurrent side.
+struct Histogram
+{
+    static constexpr size_t bucket_count = 48;
+
+    std::array<uint64_t, bucket_count> buckets{};
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    static size_t bucket_of(uint64_t value)
+    {
+        const size_t b = value < 2 ? 0 : static_cast<size_t>(std::bit_width(value) - 1);
+        return b < bucket_count ? b : bucket_count - 1;
+    }
+
+    double mean() const { return count ? double(sum) / double(count) : 0.0; }
+
+    /// Upper bound of the bucket holding the p-th fraction of samples, p in [0, 1]
+    uint64_t percentile(double p) const
+    {
+        if (count == 0) return 0;
+        const uint64_t rank = static_cast<uint64_t>(p * double(count - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < bucket_count; ++b)
+        {
+            seen += buckets[b];
+            if (seen >= rank)
+                return std::min<uint64_t>(max, (uint64_t(2) << b) - 1);
+        }
+        return max;
+    }
+};
+
+/// Optional instrumentation for an executor (ThreadPool, SerialExecutor,
+/// MainThreadQueue), reached through their instrumentation() accessor.
+///
+/// Disabled by default, when every hook costs one relaxed load and no memory
+/// is allocated. When enabled, samples go to per-thread slots of atomic
+/// counters, so recording takes no lock and threads rarely share a cache
+/// line. With tracing enabled as well, each slot also keeps a ring of the
+/// most recent events, exportable in the Chrome trace format
+/// (chrome://tracing, Perfetto).
+///
+/// @code
+/// pool.instrumentation().enable(true);
+/// ...
+/// std::ofstream("pool.json") << pool.instrumentation().to_json();
+/// @endcode
+class ExecutorStats
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t slot_count = 64;         // Threads beyond this share slots
+    static constexpr size_t trace_capacity = 4096;   // Most recent events kept per slot
+
+    explicit ExecutorStats(std::string name);
+    ~ExecutorStats();
+    ExecutorStats(const ExecutorStats&) = delete;
+    ExecutorStats& operator=(const ExecutorStats&) = delete;
+
+    const std::string& name() const { return name_; }
+
+    void enable(bool on);
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Also record trace events (implies more memory traffic per task). Needs enable().
+    void enable_trace(bool on) { trace_enabled_.store(on, std::memory_order_relaxed); }
+    bool trace_enabled() const { return trace_enabled_.load(std::memory_order_relaxed); }
+
+    /// Timestamp for hooks: 0 when disabled, so callers can skip the matching record
+    uint64_t now_if_enabled() const { return enabled() ? now() : 0; }
+
+    static uint64_t now()
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    }
+
+    /// Add a sample. Ignored if never enabled.
+    void record(ExecutorMetric metric, uint64_t value)
+    {
+        Slot* slot = local_slot();
+        if (!slot) return;
+
+        auto& h = slot->metrics[static_cast<size_t>(metric)];
+        h.buckets[Histogram::bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        h.count.fetch_add(1, std::memory_order_relaxed);
+        h.sum.fetch_add(value, std::memory_order_relaxed);
+        uint64_t prev = h.max.load(std::memory_order_relaxed);
+        while (value > prev && !h.max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+    }
+
+    /// Complete event ("X") spanning [start_ns, end_ns], `name` must be a string literal
+    void trace_span(const char* name, uint64_t start_ns, uint64_t end_ns)
+    {
+        if (trace_enabled()) push_event(name, 'X', start_ns, end_ns - start_ns);
+    }
+
+    /// Counter event ("C"), e.g. queue depth, `name` must be a string literal
+    void trace_counter(const char* name, uint64_t ts_ns, uint64_t value)
+    {
+        if (trace_enabled()) push_event(name, 'C', ts_ns, value);
+    }
+
+    /// Merged snapshot over all threads
+    Histogram histogram(ExecutorMetric metric) const;
+
+    void reset();
+
+    /// {"name":..., "metrics":{"queue_latency_ns":{count, mean, p50, p90, p99, max, buckets}, ...}}
+    std::string to_json() const;
+
+    /// {"traceEvents":[...]}; timestamps in microseconds, tid = internal thread index
+    std::string to_chrome_trace() const;
+
+    static const char* metric_name(ExecutorMetric metric);
+
+private:
+    struct AtomicHistogram
+    {
+        std::array<std::atomic<uint64_t>, Histogram::bucket_count> buckets{};
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> sum{ 0 };
+        std::atomic<uint64_t> max{ 0 };
+    };
+
+    struct TraceEvent
+    {
+        std::atomic<uint64_t> seq{ 0 };   // Claim number + 1 once written, 0 while empty
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t> ts{ 0 };
+        std::atomic<uint64_t> value{ 0 }; // Duration (X) or counter value (C)
+        std::atomic<char> phase{ 'X' };
+    };
+
+    struct alignas(64) Slot
+    {
+        std::array<AtomicHistogram, ExecutorMetricCount> metrics;
+        std::atomic<uint64_t> trace_claimed{ 0 };
+        std::atomic<TraceEvent*> trace{ nullptr }; // trace_capacity events, allocated on first use
+    };
+
+    static size_t thread_index();
+    Slot* local_slot()
+    {
+        Slot* slots = slots_.load(std::memory_order_acquire);
+        return slots ? &slots[thread_index() % slot_count] : nullptr;
+    }
+    void push_event(const char* name, char phase, uint64_t ts, uint64_t value);
+
+    const std::string name_;
+    std::atomic<bool> enabled_{ false };
+    std::atomic<bool> trace_enabled_{ false };
+    std::atomic<Slot*> slots_{ nullptr }; // slot_count slots, allocated on first enable()
+};
+
+#endif // EXECUTORSTATS_HPP
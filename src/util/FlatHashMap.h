@@ -0,0 +1,207 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef FlatHashMap_h
+#define FlatHashMap_h
+
+#include <bit> // std::countr_zero
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::hash
+#include <type_traits>
+#include <utility> // std::pair, std::move
+#include <vector>
+
+namespace eeng {
+
+    // --- FlatHashMap ---------------------------------------------------------
+
+    // Open-addressing hash map for small, cheap keys and values (GUIDs,
+    // handles, entities)
+    // * Entries live inline in one array: no allocation per entry, and a
+    //   lookup usually touches a single cache line
+    // * Linear probing over a power-of-two table kept at most 7/8 full. Hashes
+    //   are spread with a Fibonacci multiply, so identity hashes of
+    //   sequential ids probe well
+    // * Erase shifts the rest of the probe run back, leaving no tombstones
+    // * Insert and erase invalidate iterators and pointers to values
+    // * Not thread-safe
+
+    template<class K, class V, class Hash = std::hash<K>>
+    class FlatHashMap
+    {
+        static_assert(std::is_default_constructible_v<K> && std::is_default_constructible_v<V>);
+
+        using Entry = std::pair<K, V>;
+
+        std::vector<Entry> m_entries;
+        std::vector<uint8_t> m_used;    // 1 if the entry holds a key
+        size_t m_size = 0;
+        size_t m_mask = 0;              // Capacity - 1
+        unsigned m_shift = 64;          // 64 - log2(capacity)
+        [[no_unique_address]] Hash m_hash;
+
+        size_t home(const K& key) const
+        {
+            const uint64_t h = static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+            return m_shift >= 64 ? 0 : static_cast<size_t>(h >> m_shift);
+        }
+
+        // Index of the key, or of the empty entry ending its probe run
+        size_t probe(const K& key) const
+        {
+            size_t i = home(key);
+            while (m_used[i] && !(m_entries[i].first == key))
+                i = (i + 1) & m_mask;
+            return i;
+        }
+
+        void rehash(size_t capacity)
+        {
+            assert((capacity & (capacity - 1)) == 0);
+            std::vector<Entry> entries(capacity);
+            std::vector<uint8_t> used(capacity, 0);
+            std::swap(entries, m_entries);
+            std::swap(used, m_used);
+            m_mask = capacity - 1;
+            m_shift = 64 - static_cast<unsigned>(std::countr_zero(capacity));
+
+            for (size_t i = 0; i < used.size(); ++i)
+            {
+                if (!used[i]) continue;
+                size_t j = home(entries[i].first);
+                while (m_used[j]) j = (j + 1) & m_mask;
+                m_entries[j] = std::move(entries[i]);
+                m_used[j] = 1;
+            }
+        }
+
+        // Room for one more entry
+        void reserve_one()
+        {
+            if ((m_size + 1) * 8 > m_entries.size() * 7)
+                rehash(m_entries.empty() ? 16 : m_entries.size() * 2);
+        }
+
+    public:
+        class const_iterator
+        {
+            const FlatHashMap* m_map = nullptr;
+            size_t m_index = 0;
+
+            void skip_free()
+            {
+                while (m_index < m_map->m_used.size() && !m_map->m_used[m_index]) ++m_index;
+            }
+
+        public:
+            const_iterator() = default;
+            const_iterator(const FlatHashMap* map, size_t index) : m_map(map), m_index(index) { skip_free(); }
+
+            const Entry& operator*() const { return m_map->m_entries[m_index]; }
+            const Entry* operator->() const { return &m_map->m_entries[m_index]; }
+            const_iterator& operator++() { ++m_index; skip_free(); return *this; }
+            bool operator==(const const_iterator& rhs) const { return m_index == rhs.m_index; }
+        };
+
+        FlatHashMap() = default;
+
+        size_t size() const { return m_size; }
+        bool empty() const { return m_size == 0; }
+        size_t capacity() const { return m_entries.size(); }
+
+        /// @brief Make room for n entries without rehashing
+        void reserve(size_t n)
+        {
+            size_t capacity = 16;
+            while (capacity * 7 < n * 8) capacity *= 2;
+            if (capacity > m_entries.size()) rehash(capacity);
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+            m_used.clear();
+            m_size = 0;
+            m_mask = 0;
+            m_shift = 64;
+        }
+
+        V* find(const K& key)
+        {
+            if (m_size == 0) return nullptr;
+            const size_t i = probe(key);
+            return m_used[i] ? &m_entries[i].second : nullptr;
+        }
+
+        const V* find(const K& key) const
+        {
+            return const_cast<FlatHashMap*>(this)->find(key);
+        }
+
+        bool contains(const K& key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        /// @return true if the key was inserted, false if its value was replaced
+        bool insert_or_assign(const K& key, V value)
+        {
+            reserve_one();
+            const size_t i = probe(key);
+            const bool inserted = !m_used[i];
+            if (inserted)
+            {
+                m_entries[i].first = key;
+                m_used[i] = 1;
+                ++m_size;
+            }
+            m_entries[i].second = std::move(value);
+            return inserted;
+        }
+
+        /// @brief The value of key, default-constructed and inserted if missing
+        V& operator[](const K& key)
+        {
+            reserve_one();
+            const size_t i = probe(key);
+            if (!m_used[i])
+            {
+                m_entries[i] = Entry{ key, V{} };
+                m_used[i] = 1;
+                ++m_size;
+            }
+            return m_entries[i].second;
+        }
+
+        /// @return true if the key was found and removed
+        bool erase(const K& key)
+        {
+            if (m_size == 0) return false;
+            size_t i = probe(key);
+            if (!m_used[i]) return false;
+
+            // Backward shift: pull later entries of the run into the hole
+            // unless that would move them before their home index
+            for (size_t j = (i + 1) & m_mask; m_used[j]; j = (j + 1) & m_mask)
+            {
+                const size_t h = home(m_entries[j].first);
+                if (((j - h) & m_mask) >= ((j - i) & m_mask))
+                {
+                    m_entries[i] = std::move(m_entries[j]);
+                    i = j;
+                }
+            }
+            m_entries[i] = Entry{};
+            m_used[i] = 0;
+            --m_size;
+            return true;
+        }
+
+        const_iterator begin() const { return const_iterator{ this, 0 }; }
+        const_iterator end() const { return const_iterator{ this, m_used.size() }; }
+    };
+
+} // namespace eeng
+
+#endif /* FlatHashMap_h */
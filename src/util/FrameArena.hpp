@@ -0,0 +1,206 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef FRAMEARENA_HPP
+#define FRAMEARENA_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/// Linear (bump) allocator for short-lived data, usable as a std::pmr
+/// memory resource. Allocation moves a cursor; deallocation does nothing and
+/// all memory is reclaimed at once by reset().
+///
+/// When the current block is full, a block at least twice as large is taken
+/// from the upstream resource. reset() merges the blocks into one that holds
+/// the peak, so a steady workload soon stops touching the heap.
+/// Not thread-safe.
+class LinearArena : public std::pmr::memory_resource
+{
+public:
+    explicit LinearArena(
+        size_t initial_bytes = 64 * 1024,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream)
+        , next_block_bytes_(std::max<size_t>(initial_bytes, 1024))
+    {
+    }
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    ~LinearArena() override
+    {
+        release();
+    }
+
+    /// Reclaim everything allocated since the last reset. Keeps (at most) one block.
+    void reset()
+    {
+        if (head_ && head_->prev)
+        {
+            // Several blocks: replace them by one that fits them all
+            const size_t total = capacity_;
+            release();
+            next_block_bytes_ = total;
+            add_block(0);
+        }
+        else if (head_)
+            cursor_ = reinterpret_cast<char*>(head_ + 1);
+        used_ = 0;
+    }
+
+    /// Return all blocks to the upstream resource
+    void release()
+    {
+        while (head_)
+        {
+            Block* prev = head_->prev;
+            upstream_->deallocate(head_, head_->bytes, alignof(std::max_align_t));
+            head_ = prev;
+        }
+        cursor_ = end_ = nullptr;
+        capacity_ = 0;
+        used_ = 0;
+    }
+
+    /// Bytes handed out since the last reset, alignment padding included
+    size_t used() const { return used_; }
+
+    /// Bytes held in blocks
+    size_t capacity() const { return capacity_; }
+
+    /// Largest used() ever reached
+    size_t high_water() const { return high_water_; }
+
+    /// Blocks taken from the upstream resource, in total
+    uint64_t upstream_allocations() const { return upstream_allocations_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        char* p = align(cursor_, alignment);
+        if (!head_ || p + bytes > end_)
+        {
+            add_block(bytes + alignment);
+            p = align(cursor_, alignment);
+        }
+        used_ += static_cast<size_t>(p + bytes - cursor_);
+        high_water_ = std::max(high_water_, used_);
+        cursor_ = p + bytes;
+        return p;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    struct alignas(std::max_align_t) Block
+    {
+        Block* prev;
+        size_t bytes;   // Including this header
+    };
+
+    static char* align(char* p, size_t alignment)
+    {
+        assert((alignment & (alignment - 1)) == 0);
+        const auto address = reinterpret_cast<uintptr_t>(p);
+        return p + ((alignment - address % alignment) % alignment);
+    }
+
+    void add_block(size_t min_payload)
+    {
+        const size_t bytes = std::max(next_block_bytes_, min_payload + sizeof(Block));
+        void* memory = upstream_->allocate(bytes, alignof(std::max_align_t));
+        head_ = ::new(memory) Block{ head_, bytes };
+        cursor_ = reinterpret_cast<char*>(head_ + 1);
+        end_ = static_cast<char*>(memory) + bytes;
+        capacity_ += bytes;
+        next_block_bytes_ = bytes * 2;
+        ++upstream_allocations_;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    Block* head_ = nullptr;     // Current block, linked to the previous ones
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    size_t next_block_bytes_;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t high_water_ = 0;
+    uint64_t upstream_allocations_ = 0;
+};
+
+/// Double-buffered frame arena for per-frame transient data (scratch vectors,
+/// copies of asset data for a draw loop, event batches).
+///
+/// Two LinearArenas take turns: memory allocated during a frame stays valid
+/// through the next frame, then is reclaimed in bulk when end_frame() makes
+/// its arena current again. Owned by EngineContext and flipped by Engine::run
+/// at the end of every frame. Main thread only.
+///
+/// @code
+/// std::pmr::vector<GpuSubMesh> submeshes(ctx.frame_arena->resource());
+/// @endcode
+class FrameArena
+{
+public:
+    struct Stats
+    {
+        uint64_t frames = 0;                // end_frame() calls
+        size_t last_frame_bytes = 0;        // Used by the last completed frame
+        size_t high_water_bytes = 0;        // Most used by any frame
+        size_t capacity_bytes = 0;          // Held by both arenas
+        uint64_t upstream_allocations = 0;  // Blocks taken from the heap, in total
+    };
+
+    explicit FrameArena(size_t initial_bytes = 256 * 1024)
+        : arenas_{ LinearArena(initial_bytes), LinearArena(initial_bytes) }
+    {
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /// The arena of the current frame
+    LinearArena& current() { return arenas_[current_]; }
+
+    /// The current frame's arena as a std::pmr resource
+    std::pmr::memory_resource* resource() { return &arenas_[current_]; }
+
+    /// Close the current frame: record its usage, then switch to the other
+    /// arena, reclaiming what the frame before this one allocated.
+    void end_frame()
+    {
+        const size_t used = arenas_[current_].used();
+        stats_.last_frame_bytes = used;
+        stats_.high_water_bytes = std::max(stats_.high_water_bytes, used);
+        ++stats_.frames;
+
+        current_ ^= 1;
+        arenas_[current_].reset();
+    }
+
+    Stats stats() const
+    {
+        Stats s = stats_;
+        s.capacity_bytes = arenas_[0].capacity() + arenas_[1].capacity();
+        s.upstream_allocations = arenas_[0].upstream_allocations() + arenas_[1].upstream_allocations();
+        return s;
+    }
+
+private:
+    LinearArena arenas_[2];
+    size_t current_ = 0;
+    Stats stats_;
+};
+
+#endif // FRAMEARENA_HPP
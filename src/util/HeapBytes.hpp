@@ -0,0 +1,74 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef HEAPBYTES_HPP
+#define HEAPBYTES_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace eeng
+{
+    namespace detail
+    {
+        template<class T> struct is_std_vector : std::false_type {};
+        template<class T, class A> struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+        template<class T> struct is_std_array : std::false_type {};
+        template<class T, size_t N> struct is_std_array<std::array<T, N>> : std::true_type {};
+    }
+
+    /// Heap memory owned by a value, not counting sizeof the value itself.
+    ///
+    /// Vectors count their capacity and recurse into elements, strings count
+    /// storage outside the small-string buffer. Other types report 0 unless
+    /// they provide an ADL overload `size_t heap_bytes(const T&)`, which in
+    /// turn calls heap_bytes_of on its members:
+    ///
+    /// @code
+    /// inline size_t heap_bytes(const AnimTrack& t)
+    /// {
+    ///     return heap_bytes_of(t.pos_keys) + heap_bytes_of(t.rot_keys);
+    /// }
+    /// @endcode
+    template<class T>
+    size_t heap_bytes_of(const T& value)
+    {
+        if constexpr (detail::is_std_vector<T>::value)
+        {
+            using E = typename T::value_type;
+            size_t bytes = value.capacity() * sizeof(E);
+            if constexpr (!std::is_trivially_copyable_v<E>)
+                for (const E& e : value)
+                    bytes += heap_bytes_of(e);
+            return bytes;
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            static const size_t small_capacity = std::string().capacity();
+            return value.capacity() > small_capacity ? value.capacity() + 1 : 0;
+        }
+        else if constexpr (detail::is_std_array<T>::value)
+        {
+            size_t bytes = 0;
+            if constexpr (!std::is_trivially_copyable_v<typename T::value_type>)
+                for (const auto& e : value)
+                    bytes += heap_bytes_of(e);
+            return bytes;
+        }
+        else if constexpr (requires { { heap_bytes(value) } -> std::convertible_to<size_t>; })
+        {
+            return heap_bytes(value);
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+} // namespace eeng
+
+#endif // HEAPBYTES_HPP
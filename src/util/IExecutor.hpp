@@ -1,9 +1,57 @@
 #pragma once
+#include "UniqueTask.hpp"
+#include <coroutine>
 #include <future>
+#include <optional>
 #include <functional>
+#include <cstddef>
+#include <cstdint>
+
+/// Scheduling lanes, highest priority first
+enum class TaskPriority : uint8_t
+{
+    FrameCritical,  // Work the current frame waits on (e.g. skinning, parallel systems)
+    Interactive,    // Default: user-triggered work that should complete promptly
+    Background      // Long-running work such as asset scans and batch saves
+};
+
+inline constexpr size_t TaskPriorityCount = 3;
+
+struct IExecutor;
+
+/// Awaitable that resumes the awaiting coroutine as a task on an executor,
+/// see IExecutor::schedule()
+struct ExecutorAwaiter
+{
+    IExecutor& executor;
+    std::optional<TaskPriority> priority; // None: the executor's default lane
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> awaiting);
+    void await_resume() const noexcept {}
+};
 
 struct IExecutor 
 {
     virtual ~IExecutor() = default;
-    virtual void post(std::function<void()> fn) = 0;
-};
\ No newline at end of file
+    virtual void post(UniqueTask fn) = 0;
+
+    /// Post with a priority hint. Executors without priority lanes ignore it.
+    virtual void post(UniqueTask fn, TaskPriority priority)
+    {
+        (void)priority;
+        post(std::move(fn));
+    }
+
+    /// co_await to continue the current coroutine as a task on this executor,
+    /// e.g. `co_await strand.schedule();`
+    ExecutorAwaiter schedule() { return { *this, std::nullopt }; }
+    ExecutorAwaiter schedule(TaskPriority priority) { return { *this, priority }; }
+};
+
+inline void ExecutorAwaiter::await_suspend(std::coroutine_handle<> awaiting)
+{
+    auto resume = [awaiting]() { awaiting.resume(); };
+    if (priority) executor.post(resume, *priority);
+    else executor.post(resume);
+}
@@ -0,0 +1,153 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "JsonStream.hpp"
+
+#include <algorithm>
+#include <istream>
+#include <stdexcept>
+#include <utility>
+
+namespace eeng
+{
+    void JsonDomBuilder::open(nlohmann::json&& container)
+    {
+        if (stack_.empty())
+        {
+            root_ = std::move(container);
+            stack_.push_back(&root_);
+        }
+        else
+            stack_.push_back(&add(std::move(container)));
+    }
+
+    bool JsonDomBuilder::close()
+    {
+        stack_.pop_back();
+        return stack_.empty();
+    }
+
+    nlohmann::json& JsonDomBuilder::add(nlohmann::json&& value)
+    {
+        // Only the innermost container grows, so pointers to the open ones stay valid
+        nlohmann::json& parent = *stack_.back();
+        if (parent.is_array())
+        {
+            parent.push_back(std::move(value));
+            return parent.back();
+        }
+        return parent[key_] = std::move(value);
+    }
+
+    namespace
+    {
+        class MemberReader : public JsonSaxHandler<MemberReader>
+        {
+        public:
+            MemberReader(
+                std::initializer_list<std::string_view> element_keys,
+                const std::function<void(const std::string&, nlohmann::json&&)>& on_member,
+                const std::function<void(const std::string&, nlohmann::json&&)>& on_element)
+                : element_keys_(element_keys)
+                , on_member_(on_member)
+                , on_element_(on_element)
+            {
+            }
+
+            bool scalar(nlohmann::json&& value)
+            {
+                if (dom_.building())
+                    dom_.value(std::move(value));
+                else if (!in_root_)
+                    throw std::runtime_error("Expected a JSON object");
+                else
+                    deliver(std::move(value));
+                return true;
+            }
+
+            bool start_object(std::size_t)
+            {
+                return open(nlohmann::json::object());
+            }
+
+            bool start_array(std::size_t)
+            {
+                if (in_root_ && !in_elements_ && !dom_.building() &&
+                    std::find(element_keys_.begin(), element_keys_.end(), key_) != element_keys_.end())
+                {
+                    in_elements_ = true;
+                    return true;
+                }
+                return open(nlohmann::json::array());
+            }
+
+            bool key(std::string& key)
+            {
+                if (dom_.building())
+                    dom_.key(key);
+                else
+                    key_ = std::move(key);
+                return true;
+            }
+
+            bool end_object()
+            {
+                return close();
+            }
+
+            bool end_array()
+            {
+                if (in_elements_ && !dom_.building())
+                    in_elements_ = false;
+                else
+                    close();
+                return true;
+            }
+
+        private:
+            bool open(nlohmann::json&& container)
+            {
+                if (in_root_ || dom_.building())
+                    dom_.open(std::move(container));
+                else if (container.is_object())
+                    in_root_ = true;
+                else
+                    throw std::runtime_error("Expected a JSON object");
+                return true;
+            }
+
+            bool close()
+            {
+                if (!dom_.building())
+                    in_root_ = false;
+                else if (dom_.close())
+                    deliver(dom_.take());
+                return true;
+            }
+
+            void deliver(nlohmann::json&& value)
+            {
+                const auto& fn = in_elements_ ? on_element_ : on_member_;
+                if (fn) fn(key_, std::move(value));
+            }
+
+            std::initializer_list<std::string_view> element_keys_;
+            const std::function<void(const std::string&, nlohmann::json&&)>& on_member_;
+            const std::function<void(const std::string&, nlohmann::json&&)>& on_element_;
+
+            JsonDomBuilder dom_;
+            std::string key_;           // Current member of the root object
+            bool in_root_ = false;
+            bool in_elements_ = false;  // Inside an array listed in element_keys
+        };
+    }
+
+    void for_each_json_member(
+        std::istream& in,
+        std::initializer_list<std::string_view> element_keys,
+        const std::function<void(const std::string& key, nlohmann::json&& value)>& on_member,
+        const std::function<void(const std::string& key, nlohmann::json&& element)>& on_element)
+    {
+        MemberReader reader{ element_keys, on_member, on_element };
+        nlohmann::json::sax_parse(in, &reader);
+    }
+}
@@ -0,0 +1,88 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef JSONSTREAM_HPP
+#define JSONSTREAM_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace eeng
+{
+    /// Base for SAX handlers passed to nlohmann::json::sax_parse. Routes every
+    /// scalar token to Derived::scalar(nlohmann::json&&) and rethrows parse
+    /// errors, so a handler only deals with structure.
+    template<class Derived>
+    class JsonSaxHandler
+    {
+    public:
+        using json = nlohmann::json;
+
+        bool null() { return self().scalar(json(nullptr)); }
+        bool boolean(bool value) { return self().scalar(json(value)); }
+        bool number_integer(json::number_integer_t value) { return self().scalar(json(value)); }
+        bool number_unsigned(json::number_unsigned_t value) { return self().scalar(json(value)); }
+        bool number_float(json::number_float_t value, const json::string_t&) { return self().scalar(json(value)); }
+        bool string(json::string_t& value) { return self().scalar(json(std::move(value))); }
+        bool binary(json::binary_t& value) { return self().scalar(json(std::move(value))); }
+
+        template<class Exception>
+        bool parse_error(std::size_t, const std::string&, const Exception& e)
+        {
+            throw e;
+        }
+
+    private:
+        Derived& self() { return static_cast<Derived&>(*this); }
+    };
+
+    /// Builds a DOM from SAX events. Streaming readers use it for the parts
+    /// of a document they read as a whole, so only that part is ever held
+    /// as a DOM.
+    class JsonDomBuilder
+    {
+    public:
+        /// True while a container is open
+        bool building() const { return !stack_.empty(); }
+
+        /// Opens an object or array: the root of a new DOM, or nested in the
+        /// innermost open container
+        void open(nlohmann::json&& container);
+
+        /// Closes the innermost container. Returns true if that completed the DOM.
+        bool close();
+
+        void key(std::string& key) { key_ = std::move(key); }
+        void value(nlohmann::json&& value) { add(std::move(value)); }
+
+        nlohmann::json take() { return std::move(root_); }
+
+    private:
+        nlohmann::json& add(nlohmann::json&& value);
+
+        nlohmann::json root_;
+        std::vector<nlohmann::json*> stack_;
+        std::string key_;
+    };
+
+    /// Reads the JSON object in `in` one member at a time, without holding the
+    /// whole document as a DOM. Each member is passed to on_member as a DOM of
+    /// its own, except arrays whose key is in element_keys: their elements are
+    /// passed to on_element one by one. Either callback may be empty.
+    ///
+    /// Throws nlohmann::json::parse_error on malformed input and
+    /// std::runtime_error if the document is not an object.
+    void for_each_json_member(
+        std::istream& in,
+        std::initializer_list<std::string_view> element_keys,
+        const std::function<void(const std::string& key, nlohmann::json&& value)>& on_member,
+        const std::function<void(const std::string& key, nlohmann::json&& element)>& on_element);
+}
+
+#endif // JSONSTREAM_HPP
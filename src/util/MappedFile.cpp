@@ -0,0 +1,133 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace eeng
+{
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("Failed to open file for mapping: " + path.string());
+
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size))
+        {
+            CloseHandle(file);
+            throw std::runtime_error("Failed to query file size: " + path.string());
+        }
+        size_ = static_cast<size_t>(file_size.QuadPart);
+
+        // Zero-length files cannot be mapped
+        if (size_ > 0)
+        {
+            mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_)
+                data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        }
+        CloseHandle(file); // The mapping keeps the file open
+
+        if (size_ > 0 && !data_)
+        {
+            unmap();
+            throw std::runtime_error("Failed to map file: " + path.string());
+        }
+    }
+
+    void MappedFile::unmap() noexcept
+    {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        size_ = 0;
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::filesystem::path& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("Failed to open file for mapping: " + path.string());
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Failed to query file size: " + path.string());
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        // Zero-length files cannot be mapped
+        void* data = MAP_FAILED;
+        if (size_ > 0)
+        {
+            data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+                ::madvise(data, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd); // The mapping keeps the file open
+
+        if (size_ > 0 && data == MAP_FAILED)
+            throw std::runtime_error("Failed to map file: " + path.string());
+        if (size_ > 0)
+            data_ = static_cast<const std::byte*>(data);
+    }
+
+    void MappedFile::unmap() noexcept
+    {
+        if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+#ifdef _WIN32
+        , mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+            mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+        }
+        return *this;
+    }
+}
@@ -0,0 +1,43 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace eeng
+{
+    /// Read-only memory map of a whole file (mmap, or MapViewOfFile on
+    /// Windows). Pages are loaded by the OS as they are touched, so reading a
+    /// large binary file costs no up-front copy into a heap buffer.
+    ///
+    /// Throws std::runtime_error if the file cannot be opened or mapped.
+    /// Move-only; the mapping is released on destruction.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::span<const std::byte> bytes() const { return { data_, size_ }; }
+        size_t size() const { return size_; }
+
+    private:
+        void unmap() noexcept;
+
+        const std::byte* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* mapping_ = nullptr;   // HANDLE of the file mapping object
+#endif
+    };
+}
+
+#endif // MAPPEDFILE_HPP
@@ -0,0 +1,133 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef NODEPOOL_HPP
+#define NODEPOOL_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/// Lock-free pool of fixed-size nodes, e.g. queue nodes for executors.
+///
+/// Nodes live in slabs of `SlabSize` that are allocated on demand and kept
+/// until the pool is destroyed; released nodes go on a free-list, so after
+/// warm-up acquire()/release() do not allocate. Any thread may acquire and
+/// release. When all `MaxSlabs` slabs are in use, nodes are heap-allocated
+/// one by one instead.
+///
+/// Node must be default-constructible and have the members
+/// `uint32_t pool_index` and `std::atomic<uint32_t> pool_next`, which belong
+/// to the pool. acquire() hands out nodes in whatever state they were
+/// released in.
+///
+/// The free-list head packs {tag, index} so that a slot popped and pushed
+/// back concurrently cannot be mistaken for an unchanged list (ABA).
+template <typename Node, uint32_t SlabSize = 256, uint32_t MaxSlabs = 1024>
+class NodePool
+{
+public:
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /// All nodes must have been released
+    ~NodePool()
+    {
+        for (auto& slab : slabs)
+            delete[] slab.load(std::memory_order_relaxed);
+    }
+
+    Node* acquire()
+    {
+        for (;;)
+        {
+            uint64_t head = free_head.load(std::memory_order_acquire);
+            while (index_of(head) != end_index)
+            {
+                Node* node = slot(index_of(head));
+                const uint32_t next = node->pool_next.load(std::memory_order_relaxed);
+                if (free_head.compare_exchange_weak(
+                    head, pack(tag_of(head) + 1, next),
+                    std::memory_order_acquire,
+                    std::memory_order_acquire))
+                {
+                    return node;
+                }
+            }
+            if (!grow())
+            {
+                Node* node = new Node();
+                node->pool_index = heap_index;
+                return node;
+            }
+        }
+    }
+
+    void release(Node* node)
+    {
+        if (node->pool_index == heap_index)
+        {
+            delete node;
+            return;
+        }
+
+        uint64_t head = free_head.load(std::memory_order_relaxed);
+        do
+        {
+            node->pool_next.store(index_of(head), std::memory_order_relaxed);
+        } while (!free_head.compare_exchange_weak(
+            head, pack(tag_of(head) + 1, node->pool_index),
+            std::memory_order_release,
+            std::memory_order_relaxed));
+    }
+
+    /// Nodes currently held in slabs (in use or free)
+    size_t capacity() const
+    {
+        return static_cast<size_t>(slab_count.load(std::memory_order_relaxed)) * SlabSize;
+    }
+
+private:
+    static constexpr uint32_t heap_index = UINT32_MAX;
+    static constexpr uint32_t end_index = UINT32_MAX;
+
+    static uint64_t pack(uint32_t tag, uint32_t index) { return (uint64_t(tag) << 32) | index; }
+    static uint32_t index_of(uint64_t packed) { return static_cast<uint32_t>(packed); }
+    static uint32_t tag_of(uint64_t packed) { return static_cast<uint32_t>(packed >> 32); }
+
+    Node* slot(uint32_t index) const
+    {
+        return slabs[index / SlabSize].load(std::memory_order_acquire) + index % SlabSize;
+    }
+
+    // Add a slab and put its nodes on the free-list. Returns false when out of slabs.
+    bool grow()
+    {
+        std::lock_guard<std::mutex> lock(grow_mutex);
+
+        // Another thread may have refilled the list while we waited
+        if (index_of(free_head.load(std::memory_order_acquire)) != end_index)
+            return true;
+
+        const uint32_t s = slab_count.load(std::memory_order_relaxed);
+        if (s == MaxSlabs) return false;
+
+        Node* slab = new Node[SlabSize];
+        for (uint32_t i = 0; i < SlabSize; ++i)
+            slab[i].pool_index = s * SlabSize + i;
+        slabs[s].store(slab, std::memory_order_release);
+        slab_count.store(s + 1, std::memory_order_relaxed);
+
+        for (uint32_t i = 0; i < SlabSize; ++i)
+            release(&slab[i]);
+        return true;
+    }
+
+    alignas(64) std::atomic<uint64_t> free_head{ pack(0, end_index) };
+    std::array<std::atomic<Node*>, MaxSlabs> slabs{};
+    std::atomic<uint32_t> slab_count{ 0 };
+    std::mutex grow_mutex;
+};
+
+#endif // NODEPOOL_HPP
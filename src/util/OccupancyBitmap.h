@@ -0,0 +1,145 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef OccupancyBitmap_h
+#define OccupancyBitmap_h
+
+#include <atomic>
+#include <bit> // std::countr_zero
+#include <cassert>
+#include <cstdint>
+#include "AppendOnlyTable.h"
+
+namespace eeng {
+
+    // --- OccupancyBitmap -----------------------------------------------------
+
+    // One bit per pool slot, set while the slot holds a live element
+    // * O(1) set / reset / test and live count
+    // * Live slots are visited a 64-bit word at a time: empty words are
+    //   skipped and set bits are found with countr_zero
+    // * Words live in blocks that never move, so set / reset / test are safe
+    //   from any thread, also while the owner grows the bitmap under its lock.
+    //   resize, clear and for_each_set are guarded by the owning pool's lock
+
+    class OccupancyBitmap
+    {
+        static constexpr size_t block_words = 64;   // 4096 slots per block
+
+        AppendOnlyTable<std::atomic<uint64_t>*> m_blocks;
+        std::atomic<size_t> m_words{ 0 };
+        std::atomic<size_t> m_count{ 0 };
+
+        std::atomic<uint64_t>& word(size_t w) const
+        {
+            return m_blocks[w / block_words][w % block_words];
+        }
+
+        void release_blocks(size_t keep)
+        {
+            while (m_blocks.size() > keep)
+            {
+                delete[] m_blocks.back();
+                m_blocks.pop_back();
+            }
+        }
+
+    public:
+        OccupancyBitmap() = default;
+        OccupancyBitmap(const OccupancyBitmap&) = delete;
+        OccupancyBitmap& operator=(const OccupancyBitmap&) = delete;
+
+        OccupancyBitmap(OccupancyBitmap&& rhs) noexcept
+        {
+            *this = std::move(rhs);
+        }
+
+        OccupancyBitmap& operator=(OccupancyBitmap&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                release_blocks(0);
+                m_blocks = std::move(rhs.m_blocks);
+                m_words.store(rhs.m_words.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+                m_count.store(rhs.m_count.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        ~OccupancyBitmap()
+        {
+            release_blocks(0);
+        }
+
+        /// @brief Hold at least `slots` bits. New bits are clear; when shrinking,
+        ///        bits past `slots` must already be clear.
+        void resize(size_t slots)
+        {
+            const size_t words = (slots + 63) / 64;
+            const size_t blocks = (words + block_words - 1) / block_words;
+            while (m_blocks.size() < blocks)
+                m_blocks.push_back(new std::atomic<uint64_t>[block_words]());
+            release_blocks(blocks);
+            m_words.store(words, std::memory_order_release);
+        }
+
+        void clear()
+        {
+            release_blocks(0);
+            m_blocks.clear();
+            m_words.store(0, std::memory_order_relaxed);
+            m_count.store(0, std::memory_order_relaxed);
+        }
+
+        bool test(size_t slot) const
+        {
+            return (slot >> 6) < m_words.load(std::memory_order_acquire)
+                && (word(slot >> 6).load(std::memory_order_acquire) >> (slot & 63)) & 1u;
+        }
+
+        /// @brief Set a clear bit. Release: an element constructed before is
+        ///        visible to whoever sees the bit.
+        void set(size_t slot)
+        {
+            assert(!test(slot) && "Slot is already occupied");
+            word(slot >> 6).fetch_or(uint64_t{ 1 } << (slot & 63), std::memory_order_release);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void reset(size_t slot)
+        {
+            assert(test(slot) && "Slot is not occupied");
+            word(slot >> 6).fetch_and(~(uint64_t{ 1 } << (slot & 63)), std::memory_order_acq_rel);
+            m_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /// @brief Number of set bits
+        size_t count() const
+        {
+            return m_count.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Call f(slot) for every set bit, in ascending order.
+        template<class F>
+        void for_each_set(F&& f) const
+        {
+            const size_t words = m_words.load(std::memory_order_acquire);
+            for (size_t b = 0; b * block_words < words; ++b)
+            {
+                const std::atomic<uint64_t>* block = m_blocks[b];
+                const size_t end = std::min(block_words, words - b * block_words);
+                for (size_t w = 0; w < end; ++w)
+                {
+                    uint64_t bits = block[w].load(std::memory_order_acquire);
+                    while (bits)
+                    {
+                        f((b * block_words + w) * 64 + std::countr_zero(bits));
+                        bits &= bits - 1; // Clear lowest set bit
+                    }
+                }
+            }
+        }
+    };
+
+} // namespace eeng
+
+#endif /* OccupancyBitmap_h */
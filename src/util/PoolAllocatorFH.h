@@ -15,7 +15,12 @@
 #include <sstream> // std::ostringstream
 #include <stdexcept> // std::bad_alloc
 #include <mutex> // std::mutex
+#include <atomic> // std::atomic
+#include <vector> // std::vector
+#include <bit> // std::countr_zero
 #include "memaux.h"
+#include "AppendOnlyTable.h"
+#include "OccupancyBitmap.h"
 #include "Handle.h"
 
 namespace eeng {
@@ -29,8 +34,10 @@ namespace eeng {
     //   No type template - type is provided separately to create / destroy / get
     //      It is the responsibility of the user to always use the same type
     // * Embedded singly-linked free-list
-    // * Can expand & reallocate
-    // * Can reset but not shrink
+    // * Occupancy bitmap: O(1) liveness, used elements visited by bit scanning
+    // * Can expand & reallocate, or expand in chunks that are never moved
+    //   (PoolGrowth::Chunked, for stable references, and a lock-free get)
+    // * Can reset, and compact(): live elements move down and the free tail is released
 
     struct TypeInfo
     {
@@ -52,8 +59,12 @@ namespace eeng {
         const size_t        m_pool_alignment = 0ul;
         const index_type    m_index_null = -1;
 
-        void* m_pool = nullptr;
-        size_t      m_capacity = 0;     // Capacity in bytes
+        void* m_pool = nullptr;          // Pool base address (Relocate)
+        std::atomic<size_t> m_capacity = 0; // Capacity in bytes
+        const PoolGrowth m_growth = PoolGrowth::Relocate;
+        const size_t m_chunk_shift = 0;         // log2 of elements per chunk (Chunked)
+        AppendOnlyTable<void*> m_chunks;        // Chunk base addresses (Chunked)
+        OccupancyBitmap m_occupancy;            // One bit per slot, set while live
         index_type  m_free_first = m_index_null;
         index_type  m_free_last = m_index_null;
 
@@ -66,6 +77,7 @@ namespace eeng {
             assert(index % m_type_info.size == 0);
         }
 
+        // Address of the element at byte offset `index` in a relocating buffer
         template<class T>
         inline T* ptr_at(void* ptr, index_type index)
         {
@@ -73,20 +85,33 @@ namespace eeng {
             return reinterpret_cast<T*>(static_cast<char*>(ptr) + index);
         }
 
+        // Address of the element at byte offset `index`, in either growth mode
         template<class T>
-        inline const T* ptr_at(void* ptr, index_type index) const
+        inline T* ptr_at(index_type index) const
         {
             assert_index(index);
-            return reinterpret_cast<const T*>(static_cast<char*>(ptr) + index);
+            if (m_growth == PoolGrowth::Relocate)
+                return reinterpret_cast<T*>(static_cast<char*>(m_pool) + index);
+
+            const size_t element = index / m_type_info.size;
+            const size_t in_chunk = element & ((size_t{ 1 } << m_chunk_shift) - 1);
+            return reinterpret_cast<T*>(
+                static_cast<char*>(m_chunks[element >> m_chunk_shift]) + in_chunk * m_type_info.size);
         }
 
     public:
 
+        /// @param growth Relocate (contiguous) or Chunked (stable addresses)
+        /// @param chunk_elements Elements per chunk in Chunked mode, rounded up to a power of two
         PoolAllocatorFH(
             const TypeInfo type_info,
-            size_t pool_alignment = PoolMinAlignment) :
+            size_t pool_alignment = PoolMinAlignment,
+            PoolGrowth growth = PoolGrowth::Relocate,
+            size_t chunk_elements = PoolDefaultChunkElements) :
             m_type_info(type_info),
-            m_pool_alignment(align_up(pool_alignment, PoolMinAlignment))
+            m_pool_alignment(align_up(pool_alignment, PoolMinAlignment)),
+            m_growth(growth),
+            m_chunk_shift(std::countr_zero(next_power_of_two(std::max<size_t>(chunk_elements, 1))))
         {
             assert(type_info.size >= sizeof(index_type));
         }
@@ -107,6 +132,11 @@ namespace eeng {
 
             if (m_pool)
                 aligned_free(&m_pool);
+            for (size_t i = 0; i < m_chunks.size(); ++i)
+            {
+                void* chunk = m_chunks[i];
+                aligned_free(&chunk);
+            }
         }
 
     public:
@@ -115,6 +145,11 @@ namespace eeng {
             return m_capacity;
         }
 
+        PoolGrowth growth() const
+        {
+            return m_growth;
+        }
+
         template<class T, class... Args>
         Handle<T> create(Args&&... args)
         {
@@ -127,19 +162,20 @@ namespace eeng {
 
             // Next free element
             size_t elem_offset = m_free_first;
-            void* ptr = ptr_at<void>(m_pool, elem_offset);
+            void* ptr = ptr_at<void>(elem_offset);
 
             // Unlink next free element from free-list
             if (m_free_first == m_free_last)
                 m_free_first = m_free_last = m_index_null;
             else
-                m_free_first = *ptr_at<index_type>(m_pool, m_free_first);
+                m_free_first = *ptr_at<index_type>(m_free_first);
 
             // Construct
             if constexpr (std::is_aggregate_v<T>)
                 ::new(ptr) T{ std::forward<Args>(args)... };
             else
                 ::new(ptr) T(std::forward<Args>(args)...);
+            m_occupancy.set(elem_offset / sizeof(T));
 
             return Handle<T> { elem_offset / sizeof(T) };
         }
@@ -151,51 +187,73 @@ namespace eeng {
             assert(handle);
             assert(m_type_info.index == std::type_index(typeid(T)));
             auto elem_offset = handle.idx * sizeof(T);
+            m_occupancy.reset(handle.idx);
 
             if constexpr (!std::is_trivially_destructible_v<T>)
-                ptr_at<T>(m_pool, elem_offset)->~T();
+                ptr_at<T>(elem_offset)->~T();
 
             // Link element to free-list
             if (m_free_first == m_index_null)
             {
                 // Free-list is empty
-                *ptr_at<index_type>(m_pool, elem_offset) = m_index_null;
+                *ptr_at<index_type>(elem_offset) = m_index_null;
                 m_free_first = m_free_last = elem_offset;
             }
             else
             {
-                *ptr_at<index_type>(m_pool, elem_offset) = m_free_first;
+                *ptr_at<index_type>(elem_offset) = m_free_first;
                 m_free_first = elem_offset;
             }
         }
 
+        /// @note Lock-free in Chunked mode, where elements never move
         template<class T>
         T& get(Handle<T> handle)
         {
-            std::lock_guard lock(m_mutex);
             assert(m_type_info.index == std::type_index(typeid(T)));
+            if (m_growth == PoolGrowth::Chunked)
+                return *ptr_at<T>(handle.idx * sizeof(T));
 
-            return *ptr_at<T>(m_pool, handle.idx * sizeof(T));
+            std::lock_guard lock(m_mutex);
+
+            return *ptr_at<T>(handle.idx * sizeof(T));
         }
 
         template<class T>
         T& get(Handle<T> handle) const
+        {
+            assert(m_type_info.index == std::type_index(typeid(T)));
+            if (m_growth == PoolGrowth::Chunked)
+                return *ptr_at<T>(handle.idx * sizeof(T));
+
+            std::lock_guard lock(m_mutex);
+
+            return *ptr_at<T>(handle.idx * sizeof(T));
+        }
+
+        /// @brief True if the handle's slot holds a live element. O(1).
+        template<class T>
+        bool is_used(Handle<T> handle) const
         {
             std::lock_guard lock(m_mutex);
             assert(m_type_info.index == std::type_index(typeid(T)));
 
-            return *ptr_at<T>(m_pool, handle.idx * sizeof(T));
+            return handle && m_occupancy.test(handle.idx);
+        }
+
+        /// @brief Number of live elements. O(1).
+        index_type count_used() const
+        {
+            std::lock_guard lock(m_mutex);
+
+            return m_occupancy.count();
         }
 
         index_type count_free() const
         {
             std::lock_guard lock(m_mutex);
 
-            index_type index_count = 0;
-            freelist_visitor([&](index_type i) {
-                index_count++;
-                });
-            return index_count;
+            return m_capacity / m_type_info.size - m_occupancy.count();
         }
 
         /// @brief Convert the pool state to a string representation.
@@ -217,7 +275,7 @@ namespace eeng {
             while (cur != m_index_null)
             {
                 oss << cur / m_type_info.size << " -> ";
-                cur = *ptr_at<index_type>(m_pool, cur);
+                cur = *ptr_at<index_type>(cur);
             }
             oss << "null\n";
 
@@ -225,9 +283,7 @@ namespace eeng {
             oss << "  layout: ";
             for (index_type idx = 0; idx < m_capacity; idx += m_type_info.size)
             {
-                bool isFree = false;
-                freelist_visitor([&](index_type i) { if (i == idx) isFree = true; });
-                if (isFree) oss << "[F]";
+                if (!m_occupancy.test(idx / m_type_info.size)) oss << "[F]";
                 else       oss << "[U]";
             }
             oss << "\n";
@@ -236,36 +292,118 @@ namespace eeng {
         }
 
         // Traverse used elements in order
-        // O(2N). Uses dynamic allocation. Mainly intended for debug use.
+        // Visits live slots only, skipping 64 free slots per empty bitmap word
         template<class T, class F>
         void used_visitor(F&& f)
         {
             std::lock_guard lock(m_mutex);
 
-            std::vector<bool> used(m_capacity / m_type_info.size, true);
-            freelist_visitor([&](index_type i) {
-                used[i / m_type_info.size] = false;
+            m_occupancy.for_each_set([&](size_t slot)
+                {
+                    f(*ptr_at<T>(slot * m_type_info.size));
                 });
+        }
 
-            for (index_type index = 0;
-                index < m_capacity;
-                index += m_type_info.size)
+        /// @brief Move live elements into the lowest free slots, then release the
+        ///        free tail (the buffer is reallocated, or trailing chunks freed).
+        /// @tparam T The type of elements in the pool.
+        /// @return The moved elements. Handles and references to them are invalidated:
+        ///         a handle to slot `from` should become one to slot `to`.
+        /// @note O(capacity). Moves at most one element per free slot below the live count.
+        template<class T>
+        std::vector<PoolMove> compact()
+        {
+            assert(sizeof(T) == m_type_info.size);
+            std::lock_guard lock(m_mutex);
+
+            std::vector<PoolMove> moves;
+            const size_t live = m_occupancy.count();
+            size_t hole = 0;
+            size_t source = m_capacity / m_type_info.size;
+            for (;;)
             {
-                if (used[index / m_type_info.size])
-                    f(*ptr_at<T>(m_pool, index));
+                // Lowest free slot below `live` and highest used slot above it
+                while (hole < live && m_occupancy.test(hole)) ++hole;
+                if (hole == live) break;
+                do --source; while (!m_occupancy.test(source));
+
+                T* from = ptr_at<T>(source * m_type_info.size);
+                ::new(ptr_at<void>(hole * m_type_info.size)) T(std::move(*from));
+                from->~T();
+                m_occupancy.reset(source);
+                m_occupancy.set(hole);
+                moves.push_back({ source, hole });
             }
+
+            shrink<T>(live);
+            return moves;
         }
 
     private:
 
+        // Release capacity past the first `slots` slots, which hold every live
+        // element, and rebuild the free-list from what remains
+        template<class T>
+        void shrink(size_t slots)
+        {
+            const size_t used_bytes = slots * m_type_info.size;
+
+            if (m_growth == PoolGrowth::Chunked)
+            {
+                const size_t chunk_elements = size_t{ 1 } << m_chunk_shift;
+                const size_t keep = (slots + chunk_elements - 1) >> m_chunk_shift;
+                while (m_chunks.size() > keep)
+                {
+                    void* chunk = m_chunks.back();
+                    aligned_free(&chunk);
+                    m_chunks.pop_back();
+                }
+                m_capacity = keep * chunk_elements * m_type_info.size;
+            }
+            else if (used_bytes < m_capacity)
+            {
+                void* prev_pool = m_pool; m_pool = nullptr;
+                if (used_bytes)
+                {
+                    aligned_alloc(&m_pool, used_bytes, m_pool_alignment);
+                    for (size_t offset = 0; offset < used_bytes; offset += m_type_info.size)
+                    {
+                        T* src_elem_ptr = reinterpret_cast<T*>(static_cast<char*>(prev_pool) + offset);
+                        ::new(static_cast<char*>(m_pool) + offset) T(std::move(*src_elem_ptr));
+                        src_elem_ptr->~T();
+                    }
+                }
+                aligned_free(&prev_pool);
+                m_capacity = used_bytes;
+            }
+
+            m_occupancy.resize(m_capacity / m_type_info.size);
+            m_free_first = m_free_last = m_index_null;
+            if (m_capacity > used_bytes)
+                expand_freelist(used_bytes, m_capacity);
+        }
+
         template<class T>
         void expand()
         {
             size_t prev_capacity = m_capacity;
-            size_t new_capacity = next_power_of_two(m_capacity / m_type_info.size + 1ull) * m_type_info.size;
 
-            resize<T>(new_capacity);
+            if (m_growth == PoolGrowth::Chunked)
+            {
+                // Add one chunk; nothing already allocated moves
+                const size_t chunk_size = (size_t{ 1 } << m_chunk_shift) * m_type_info.size;
+                void* chunk = nullptr;
+                aligned_alloc(&chunk, chunk_size, m_pool_alignment);
+                m_chunks.push_back(chunk);
+                m_capacity += chunk_size;
+            }
+            else
+            {
+                size_t new_capacity = next_power_of_two(m_capacity / m_type_info.size + 1ull) * m_type_info.size;
+                resize<T>(new_capacity);
+            }
             expand_freelist(prev_capacity, m_capacity);
+            m_occupancy.resize(m_capacity / m_type_info.size);
         }
 
         /// @brief Expand the freelist to a new capacity.
@@ -288,17 +426,17 @@ namespace eeng {
                 i += m_type_info.size)
             {
                 if (m_free_last != m_index_null)
-                    *ptr_at<index_type>(m_pool, m_free_last) = i;
+                    *ptr_at<index_type>(m_free_last) = i;
                 m_free_last = i;
             }
             // The last free element links to null
-            *ptr_at<index_type>(m_pool, m_free_last) = m_index_null;
+            *ptr_at<index_type>(m_free_last) = m_index_null;
         }
 
         /// @brief Resize to a new capacity larger than the current one.
         /// @tparam T The type of elements in the pool.
         /// @param size The new size in bytes.
-        /// @details All elements are moved to the new buffer.
+        /// @details All elements are moved to the new buffer. Relocate mode only.
         //          The freelist is preserved but not expanded:
         //          new elements must be linked via expand_freelist().
         //          Shrinking the pool is not supported
@@ -306,6 +444,7 @@ namespace eeng {
         void resize(size_t size)
         {
             assert(size >= m_capacity && "Shrinking the pool is not supported");
+            assert(m_growth == PoolGrowth::Relocate);
             if (size == m_capacity) return;
 
             void* prev_pool = m_pool; m_pool = nullptr;
@@ -318,23 +457,18 @@ namespace eeng {
             // Copy data to new location
             if (prev_pool && m_pool)
             {
-                std::vector<bool> used(prev_capacity / m_type_info.size, true);
-                freelist_visitor([&](index_type i) {
-                    used[i / m_type_info.size] = false;
-                    });
-
                 for (index_type index = 0; index < prev_capacity; index += m_type_info.size)
                 {
-                    if (used[index / m_type_info.size])
+                    if (m_occupancy.test(index / m_type_info.size))
                     {
                         T* src_elem_ptr = ptr_at<T>(prev_pool, index);
-                        void* dest_elem_ptr = ptr_at<void>(m_pool, index);
+                        void* dest_elem_ptr = ptr_at<void>(index);
 
                         ::new(dest_elem_ptr) T(std::move(*src_elem_ptr));
                         src_elem_ptr->~T();
                     }
                     else
-                        *ptr_at<index_type>(m_pool, index) = *ptr_at<index_type>(prev_pool, index);
+                        *ptr_at<index_type>(index) = *ptr_at<index_type>(prev_pool, index);
                 }
             }
 
@@ -351,7 +485,7 @@ namespace eeng {
             while (cur_index != m_index_null)
             {
                 f(cur_index);
-                cur_index = *ptr_at<index_type>(m_pool, cur_index);
+                cur_index = *ptr_at<index_type>(cur_index);
             }
         }
     };
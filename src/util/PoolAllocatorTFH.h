@@ -15,7 +15,12 @@
 #include <sstream> // std::ostringstream
 #include <stdexcept> // std::bad_alloc
 #include <mutex> // std::mutex
+#include <atomic> // std::atomic
+#include <vector> // std::vector
+#include <bit> // std::countr_zero
 #include "memaux.h"
+#include "AppendOnlyTable.h"
+#include "OccupancyBitmap.h"
 #include "Handle.h"
 
 namespace eeng {
@@ -25,8 +30,16 @@ namespace eeng {
     // * Raw memory allocator with alignment
     // * Compile-time type-safe
     // * Embedded singly-linked free-list
-    // * Can expand & reallocate
-    // * Can reset but not shrink
+    // * Occupancy bitmap: O(1) liveness, used elements visited by bit scanning
+    // * Can expand & reallocate, or expand in chunks that are never moved
+    //   (PoolGrowth::Chunked, for stable references)
+    // * Chunked: get is lock-free, and create / destroy are lock-free unless a
+    //   chunk is added. Free slots form a Treiber stack whose head is tagged
+    //   against ABA; links are kept beside each chunk, not in the elements.
+    //   clear, compact and moves must not overlap other calls
+    // * Chunked: each slot has a generation, kept beside the links. Handles carry
+    //   it, and is_current() validates one with a single lock-free load
+    // * Can reset, and compact(): live elements move down and the free tail is released
 
     template<
         class T,
@@ -57,14 +70,35 @@ namespace eeng {
         const size_t element_size = std::max(sizeof(T), sizeof(index_type));
         const index_type index_null = -1;
 
-        void* m_pool = nullptr;   // Pool base address
-        size_t m_capacity = 0;     // Capacity in bytes
+        void* m_pool = nullptr;   // Pool base address (Relocate)
+        std::atomic<size_t> m_capacity = 0; // Capacity in bytes
+
+        PoolGrowth m_growth = PoolGrowth::Relocate;
+        size_t m_chunk_shift = 0;           // log2 of elements per chunk (Chunked)
+        AppendOnlyTable<void*> m_chunks;    // Chunk base addresses (Chunked)
+
+        OccupancyBitmap m_occupancy;        // One bit per slot, set while live
+
+        // Chunked: generation of the slots of a new chunk, past every generation
+        // of the chunks released so far, so stale handles into them stay stale
+        uint32_t m_first_generation = 0;
 
         mutable std::recursive_mutex m_mutex;
 
+        // Free-list (Relocate): byte offsets, linked through the free elements
         index_type free_first = index_null;
         index_type free_last = index_null;
 
+        // Free-list (Chunked): slot index in the low half of the head, a tag
+        // bumped by every push and pop in the high half
+        static constexpr uint32_t slot_null = std::numeric_limits<uint32_t>::max();
+        std::atomic<uint64_t> m_free_head{ slot_null };
+
+        static constexpr uint64_t free_head(uint32_t slot, uint64_t prev_head)
+        {
+            return ((prev_head >> 32) + 1) << 32 | slot;
+        }
+
         inline void assert_index(index_type index) const
         {
             assert(index != index_null);
@@ -72,6 +106,7 @@ namespace eeng {
             assert(index % sizeof(T) == 0);
         }
 
+        // Address of the element at byte offset `index` in a relocating buffer
         template<class Type>
         inline Type* ptr_at(void* ptr, index_type index)
         {
@@ -79,20 +114,83 @@ namespace eeng {
             return reinterpret_cast<Type*>(static_cast<char*>(ptr) + index);
         }
 
+        // Address of the element at byte offset `index`, in either growth mode
+        template<class Type>
+        inline Type* ptr_at(index_type index)
+        {
+            return const_cast<Type*>(std::as_const(*this).template ptr_at<Type>(index));
+        }
+
         template<class Type>
-        inline const Type* ptr_at(void* ptr, index_type index) const
+        inline const Type* ptr_at(index_type index) const
         {
             assert_index(index);
-            return reinterpret_cast<const Type*>(static_cast<char*>(ptr) + index);
+            if (m_growth == PoolGrowth::Relocate)
+                return reinterpret_cast<const Type*>(static_cast<const char*>(m_pool) + index);
+
+            const size_t element = index / sizeof(T);
+            const size_t in_chunk = element & ((size_t{ 1 } << m_chunk_shift) - 1);
+            return reinterpret_cast<const Type*>(
+                static_cast<const char*>(m_chunks[element >> m_chunk_shift]) + in_chunk * sizeof(T));
+        }
+
+        // Chunked: links of the free slots follow the elements of each chunk
+        size_t links_offset() const
+        {
+            return align_up((size_t{ 1 } << m_chunk_shift) * sizeof(T), alignof(std::atomic<uint32_t>));
+        }
+
+        std::atomic<uint32_t>& link(size_t slot) const
+        {
+            const size_t in_chunk = slot & ((size_t{ 1 } << m_chunk_shift) - 1);
+            char* chunk = static_cast<char*>(m_chunks[slot >> m_chunk_shift]);
+            return reinterpret_cast<std::atomic<uint32_t>*>(chunk + links_offset())[in_chunk];
+        }
+
+        // Chunked: slot generations follow the links
+        size_t generations_offset() const
+        {
+            return links_offset() + (size_t{ 1 } << m_chunk_shift) * sizeof(std::atomic<uint32_t>);
+        }
+
+        std::atomic<handle_ver_type>& generation(size_t slot) const
+        {
+            const size_t in_chunk = slot & ((size_t{ 1 } << m_chunk_shift) - 1);
+            char* chunk = static_cast<char*>(m_chunks[slot >> m_chunk_shift]);
+            return reinterpret_cast<std::atomic<handle_ver_type>*>(chunk + generations_offset())[in_chunk];
+        }
+
+        // Invalidate handles to the element in a slot, which is destroyed or moved away
+        void bump_generation(size_t slot)
+        {
+            auto& gen = generation(slot);
+            handle_ver_type next = gen.load(std::memory_order_relaxed) + 1;
+            if (next == handle_ver_null) next = 0;
+            gen.store(next, std::memory_order_release);
         }
 
     public:
-        explicit PoolAllocatorTFH(size_t count = 0)
+        /// @param count Initial capacity in elements
+        /// @param growth Relocate (contiguous) or Chunked (stable addresses)
+        /// @param chunk_elements Elements per chunk in Chunked mode, rounded up to a power of two
+        explicit PoolAllocatorTFH(
+            size_t count = 0,
+            PoolGrowth growth = PoolGrowth::Relocate,
+            size_t chunk_elements = PoolDefaultChunkElements)
+            : m_growth(growth)
+            , m_chunk_shift(std::countr_zero(next_power_of_two(std::max<size_t>(chunk_elements, 1))))
         {
-            if (count)
+            if (!count) return;
+            if (m_growth == PoolGrowth::Relocate)
             {
                 resize(count * element_size);
                 expand_freelist(0, m_capacity);
+                m_occupancy.resize(count);
+            }
+            else
+            {
+                while (m_capacity < count * element_size)
+                    expand();
             }
         }
 
@@ -106,9 +204,17 @@ namespace eeng {
             std::lock_guard lock(rhs.m_mutex);
 
             m_pool = std::exchange(rhs.m_pool, nullptr);
-            m_capacity = std::exchange(rhs.m_capacity, 0);
+            m_capacity = rhs.m_capacity.exchange(0);
+            m_growth = rhs.m_growth;
+            m_chunk_shift = rhs.m_chunk_shift;
+            m_chunks = std::move(rhs.m_chunks);
+            rhs.m_chunks.clear();
+            m_occupancy = std::move(rhs.m_occupancy);
+            rhs.m_occupancy.clear();
+            m_first_generation = rhs.m_first_generation;
             free_first = std::exchange(rhs.free_first, index_null);
             free_last = std::exchange(rhs.free_last, index_null);
+            m_free_head = rhs.m_free_head.exchange(slot_null);
         }
 
         // Move-assg
@@ -123,13 +229,21 @@ namespace eeng {
                     used_visitor([&](T& elem) { elem.~T(); });
 
                 // free our current storage
-                if (m_pool) aligned_free(&m_pool);
+                free_storage();
 
                 // steal theirs
                 m_pool = std::exchange(rhs.m_pool, nullptr);
-                m_capacity = std::exchange(rhs.m_capacity, 0);
+                m_capacity = rhs.m_capacity.exchange(0);
+                m_growth = rhs.m_growth;
+                m_chunk_shift = rhs.m_chunk_shift;
+                m_chunks = std::move(rhs.m_chunks);
+                rhs.m_chunks.clear();
+                m_occupancy = std::move(rhs.m_occupancy);
+                rhs.m_occupancy.clear();
+                m_first_generation = rhs.m_first_generation;
                 free_first = std::exchange(rhs.free_first, index_null);
                 free_last = std::exchange(rhs.free_last, index_null);
+                m_free_head = rhs.m_free_head.exchange(slot_null);
             }
             return *this;
         }
@@ -140,8 +254,7 @@ namespace eeng {
             if constexpr (!std::is_trivially_destructible_v<T>)
                 used_visitor([&](T& elem) { elem.~T(); });
 
-            if (m_pool)
-                aligned_free(&m_pool);
+            free_storage();
         }
 
         void clear()
@@ -154,9 +267,10 @@ namespace eeng {
 
             free_first = index_null;
             free_last = index_null;
+            m_free_head = slot_null;
 
-            m_pool = nullptr;
-            m_capacity = 0;
+            m_occupancy.clear();
+            free_storage();
         }
 
         size_t capacity() const
@@ -164,77 +278,130 @@ namespace eeng {
             return m_capacity / sizeof(T);
         }
 
+        PoolGrowth growth() const
+        {
+            return m_growth;
+        }
+
         template<class... Args>
         Handle<value_type> create(Args&&... args)
         {
+            if (m_growth == PoolGrowth::Chunked)
+            {
+                // Lock-free unless a chunk is added
+                const size_t slot = pop_free_slot();
+                construct(slot, std::forward<Args>(args)...);
+                return Handle<value_type> { slot, generation(slot).load(std::memory_order_acquire) };
+            }
+
             std::lock_guard lock(m_mutex);
 
             // Resize if free-list is empty
             if (free_first == index_null) expand();
 
             size_t offset = free_first;
-            void* ptr = (void*)((char*)m_pool + offset);
 
             // Unlink first_free
             if (free_first == free_last)
                 // No free elements left
                 free_first = free_last = index_null;
             else
-                free_first = *ptr_at<index_type>(m_pool, free_first);
+                free_first = *ptr_at<index_type>(free_first);
 
-            if constexpr (std::is_aggregate_v<value_type>)
-                ::new(ptr) value_type{ std::forward<Args>(args)... };
-            else
-                ::new(ptr) value_type(std::forward<Args>(args)...);
+            construct(offset / sizeof(T), std::forward<Args>(args)...);
 
             return Handle<value_type> { offset / sizeof(T) };
         }
 
         void destroy(Handle<value_type> handle)
         {
-            std::lock_guard lock(m_mutex);
             assert(handle);
             auto elem_offset = handle.idx * sizeof(T);
 
+            if (m_growth == PoolGrowth::Chunked)
+            {
+                // Lock-free
+                m_occupancy.reset(handle.idx);
+                if constexpr (!std::is_trivially_destructible_v<T>)
+                    ptr_at<value_type>(elem_offset)->~value_type();
+                bump_generation(handle.idx);
+                push_free_slots(handle.idx, handle.idx + 1);
+                return;
+            }
+
+            std::lock_guard lock(m_mutex);
+            m_occupancy.reset(handle.idx);
+
             if constexpr (!std::is_trivially_destructible_v<T>)
-                ptr_at<value_type>(m_pool, elem_offset)->~value_type();
+                ptr_at<value_type>(elem_offset)->~value_type();
 
             if (free_first == index_null)
             {
                 // Free-list is empty
-                *ptr_at<index_type>(m_pool, elem_offset) = index_null;
+                *ptr_at<index_type>(elem_offset) = index_null;
                 free_first = free_last = elem_offset;
             }
             else
             {
-                *ptr_at<index_type>(m_pool, elem_offset) = free_first;
+                *ptr_at<index_type>(elem_offset) = free_first;
                 free_first = elem_offset;
             }
         }
 
+        /// @note Lock-free in Chunked mode, where elements never move
         value_type& get(Handle<value_type> handle)
         {
+            if (m_growth == PoolGrowth::Chunked)
+                return *ptr_at<value_type>(handle.idx * sizeof(T));
+
             std::lock_guard lock(m_mutex);
 
-            return *ptr_at<value_type>(m_pool, handle.idx * sizeof(T));
+            return *ptr_at<value_type>(handle.idx * sizeof(T));
         }
 
         cvalue_type& get(Handle<value_type> handle) const
         {
+            if (m_growth == PoolGrowth::Chunked)
+                return *ptr_at<value_type>(handle.idx * sizeof(T));
+
             std::lock_guard lock(m_mutex);
 
-            return *ptr_at<value_type>(m_pool, handle.idx * sizeof(T));
+            return *ptr_at<value_type>(handle.idx * sizeof(T));
+        }
+
+        /// @brief True if the handle is of its slot's current generation: the
+        ///        element it was created for is still there. Chunked only.
+        /// @note Lock-free, and safe while other threads create and destroy
+        ///       elements, since chunks never move
+        bool is_current(Handle<value_type> handle) const
+        {
+            assert(m_growth == PoolGrowth::Chunked);
+            return handle
+                && handle.idx < capacity()
+                && generation(handle.idx).load(std::memory_order_acquire) == handle.ver;
+        }
+
+        /// @brief True if the handle's slot holds a live element. O(1).
+        bool is_used(Handle<value_type> handle) const
+        {
+            std::lock_guard lock(m_mutex);
+
+            return handle && m_occupancy.test(handle.idx);
+        }
+
+        /// @brief Number of live elements. O(1).
+        index_type count_used() const
+        {
+            std::lock_guard lock(m_mutex);
+
+            return m_occupancy.count();
         }
 
         index_type count_free() const
         {
             std::lock_guard lock(m_mutex);
 
-            index_type index_count = 0;
-            freelist_visitor([&](index_type i) {
-                index_count++;
-                });
-            return index_count;
+            return m_capacity / sizeof(T) - m_occupancy.count();
         }
 
         /// @brief Convert the pool state to a string representation.
@@ -245,18 +412,29 @@ namespace eeng {
             std::ostringstream oss;
 
             // 1) Summary line
+            const bool chunked = m_growth == PoolGrowth::Chunked;
             oss << "PoolAllocatorTFH: capacity=" << (m_capacity / sizeof(T))
                 << ", free=" << count_free()
-                << ", head=" << free_first
-                << "\n";
+                << ", head=";
+            if (chunked) oss << uint32_t(m_free_head.load()) << " (slot)";
+            else oss << free_first;
+            oss << "\n";
 
             // 2) Free-list chain
             oss << "  free-list: ";
-            index_type cur = free_first;
-            while (cur != index_null)
+            if (chunked)
             {
-                oss << cur / sizeof(T) << " -> ";
-                cur = *ptr_at<index_type>(m_pool, cur);
+                for (uint32_t slot = uint32_t(m_free_head.load()); slot != slot_null; slot = link(slot).load())
+                    oss << slot << " -> ";
+            }
+            else
+            {
+                index_type cur = free_first;
+                while (cur != index_null)
+                {
+                    oss << cur / sizeof(T) << " -> ";
+                    cur = *ptr_at<index_type>(cur);
+                }
             }
             oss << "null\n";
 
@@ -264,11 +442,9 @@ namespace eeng {
             oss << "  layout: ";
             for (index_type idx = 0; idx < m_capacity; idx += sizeof(T))
             {
-                bool isFree = false;
-                freelist_visitor([&](index_type i) { if (i == idx) isFree = true; });
-                if (isFree) oss << "[F]";
+                if (!m_occupancy.test(idx / sizeof(T))) oss << "[F]";
                 else {
-                    const auto& value = *ptr_at<T>(m_pool, idx);
+                    const auto& value = *ptr_at<T>(idx);
                     if constexpr (requires { oss << value; })
                         oss << "[" << value << "]";
                     else
@@ -283,60 +459,232 @@ namespace eeng {
         /// @brief Visit all used elements in the pool (const).
         /// @tparam F The function type.
         /// @param f The function to call for each used element.
-        /// @note O(2N). Uses dynamic allocation. Mainly intended for debug use.
+        /// @note Visits live slots only, skipping 64 free slots per empty bitmap word.
         template<class F>
         void used_visitor(F&& f) const
         {
             std::lock_guard lock(m_mutex);
 
-            std::vector<bool> used(m_capacity / sizeof(T), true);
-            freelist_visitor([&](index_type i)
+            m_occupancy.for_each_set([&](size_t slot)
                 {
-                    used[i / sizeof(T)] = false;
+                    f(*ptr_at<T>(slot * sizeof(T)));
                 });
-
-            for (index_type index = 0;
-                index < m_capacity;
-                index += sizeof(T))
-            {
-                if (used[index / sizeof(T)])
-                    f(*ptr_at<T>(m_pool, index));
-            }
         }
 
         /// @brief Visit all used elements in the pool (non-const).
         /// @tparam F The function type.
         /// @param f The function to call for each used element.
-        /// @note O(2N). Uses dynamic allocation. Mainly intended for debug use.
+        /// @note Visits live slots only, skipping 64 free slots per empty bitmap word.
         template<class F>
         void used_visitor(F&& f)
         {
             std::lock_guard lock(m_mutex);
 
-            std::vector<bool> used(m_capacity / sizeof(T), true);
-            freelist_visitor([&](index_type i)
+            m_occupancy.for_each_set([&](size_t slot)
                 {
-                    used[i / sizeof(T)] = false;
+                    f(*ptr_at<T>(slot * sizeof(T)));
                 });
+        }
 
-            for (index_type index = 0;
-                index < m_capacity;
-                index += sizeof(T))
+        /// @brief Move live elements into the lowest free slots, then release the
+        ///        free tail (the buffer is reallocated, or trailing chunks freed).
+        /// @return The moved elements. Handles and references to them are invalidated:
+        ///         a handle to slot `from` should become one to slot `to`. In Chunked
+        ///         mode, `from_ver` and `to_ver` give the generations of both handles.
+        /// @note O(capacity). Moves at most one element per free slot below the live count.
+        std::vector<PoolMove> compact()
+        {
+            std::lock_guard lock(m_mutex);
+
+            std::vector<PoolMove> moves;
+            const size_t live = m_occupancy.count();
+            size_t hole = 0;
+            size_t source = m_capacity / sizeof(T);
+            for (;;)
             {
-                if (used[index / sizeof(T)])
-                    f(*ptr_at<T>(m_pool, index));
+                // Lowest free slot below `live` and highest used slot above it
+                while (hole < live && m_occupancy.test(hole)) ++hole;
+                if (hole == live) break;
+                do --source; while (!m_occupancy.test(source));
+
+                T* from = ptr_at<T>(source * sizeof(T));
+                ::new(ptr_at<void>(hole * sizeof(T))) T(std::move(*from));
+                from->~T();
+                m_occupancy.reset(source);
+                m_occupancy.set(hole);
+                if (m_growth == PoolGrowth::Chunked)
+                {
+                    const handle_ver_type from_ver = generation(source).load(std::memory_order_relaxed);
+                    bump_generation(source);
+                    moves.push_back({ source, hole, from_ver, generation(hole).load(std::memory_order_relaxed) });
+                }
+                else
+                    moves.push_back({ source, hole });
             }
+
+            shrink(live);
+            return moves;
         }
 
     private:
 
+        // Release capacity past the first `slots` slots, which hold every live
+        // element, and rebuild the free-list from what remains
+        void shrink(size_t slots)
+        {
+            const size_t used_bytes = slots * sizeof(T);
+
+            if (m_growth == PoolGrowth::Chunked)
+            {
+                const size_t chunk_elements = size_t{ 1 } << m_chunk_shift;
+                const size_t keep = (slots + chunk_elements - 1) >> m_chunk_shift;
+                retire_generations(keep * chunk_elements);
+                while (m_chunks.size() > keep)
+                {
+                    void* chunk = m_chunks.back();
+                    aligned_free(&chunk);
+                    m_chunks.pop_back();
+                }
+                m_capacity = keep * chunk_elements * sizeof(T);
+
+                m_occupancy.resize(m_capacity / sizeof(T));
+                m_free_head = slot_null;
+                if (m_capacity > used_bytes)
+                    push_free_slots(slots, m_capacity / sizeof(T));
+                return;
+            }
+            else if (used_bytes < m_capacity)
+            {
+                void* prev_pool = m_pool; m_pool = nullptr;
+                if (used_bytes)
+                {
+                    aligned_alloc(&m_pool, used_bytes, Alignment);
+                    for (size_t slot = 0; slot < slots; ++slot)
+                    {
+                        T* src_elem_ptr = reinterpret_cast<T*>(static_cast<char*>(prev_pool) + slot * sizeof(T));
+                        ::new(static_cast<char*>(m_pool) + slot * sizeof(T)) T(std::move(*src_elem_ptr));
+                        src_elem_ptr->~T();
+                    }
+                }
+                aligned_free(&prev_pool);
+                m_capacity = used_bytes;
+            }
+
+            m_occupancy.resize(m_capacity / sizeof(T));
+            free_first = free_last = index_null;
+            if (m_capacity > used_bytes)
+                expand_freelist(used_bytes, m_capacity);
+        }
+
         void expand()
         {
             size_t prev_capacity = m_capacity;
-            size_t new_capacity = next_power_of_two(m_capacity / sizeof(T) + 1ull) * sizeof(T);
 
+            if (m_growth == PoolGrowth::Chunked)
+            {
+                // Add one chunk; nothing already allocated moves
+                const size_t chunk_elements = size_t{ 1 } << m_chunk_shift;
+                const size_t first = prev_capacity / sizeof(T);
+                if (first + chunk_elements > slot_null) throw std::bad_alloc();
+
+                void* chunk = nullptr;
+                aligned_alloc(&chunk, generations_offset() + chunk_elements * sizeof(std::atomic<handle_ver_type>), Alignment);
+                for (size_t i = 0; i < chunk_elements; ++i)
+                {
+                    ::new(static_cast<char*>(chunk) + links_offset() + i * sizeof(std::atomic<uint32_t>)) std::atomic<uint32_t>(slot_null);
+                    ::new(static_cast<char*>(chunk) + generations_offset() + i * sizeof(std::atomic<handle_ver_type>))
+                        std::atomic<handle_ver_type>(m_first_generation);
+                }
+
+                m_chunks.push_back(chunk);
+                m_occupancy.resize(first + chunk_elements);
+                m_capacity += chunk_elements * sizeof(T);
+                push_free_slots(first, first + chunk_elements);
+                return;
+            }
+
+            size_t new_capacity = next_power_of_two(m_capacity / sizeof(T) + 1ull) * sizeof(T);
             resize(new_capacity);
             expand_freelist(prev_capacity, m_capacity);
+            m_occupancy.resize(m_capacity / sizeof(T));
+        }
+
+        template<class... Args>
+        void construct(size_t slot, Args&&... args)
+        {
+            void* ptr = ptr_at<void>(slot * sizeof(T));
+            if constexpr (std::is_aggregate_v<value_type>)
+                ::new(ptr) value_type{ std::forward<Args>(args)... };
+            else
+                ::new(ptr) value_type(std::forward<Args>(args)...);
+            m_occupancy.set(slot);
+        }
+
+        // Chunked: pop a free slot, adding a chunk under the lock when there is none
+        size_t pop_free_slot()
+        {
+            uint64_t head = m_free_head.load(std::memory_order_acquire);
+            for (;;)
+            {
+                const uint32_t slot = uint32_t(head);
+                if (slot == slot_null)
+                {
+                    std::lock_guard lock(m_mutex);
+                    if (uint32_t(m_free_head.load(std::memory_order_acquire)) == slot_null)
+                        expand();
+                    head = m_free_head.load(std::memory_order_acquire);
+                    continue;
+                }
+
+                // The link may be stale if the slot was popped meanwhile; the tag
+                // then differs and the exchange fails
+                const uint32_t next = link(slot).load(std::memory_order_relaxed);
+                if (m_free_head.compare_exchange_weak(head, free_head(next, head),
+                    std::memory_order_acquire, std::memory_order_acquire))
+                    return slot;
+            }
+        }
+
+        // Chunked: push slots [first, last) as one run, in order
+        void push_free_slots(size_t first, size_t last)
+        {
+            assert(first < last);
+            for (size_t slot = first; slot + 1 < last; ++slot)
+                link(slot).store(uint32_t(slot + 1), std::memory_order_relaxed);
+
+            uint64_t head = m_free_head.load(std::memory_order_relaxed);
+            do link(last - 1).store(uint32_t(head), std::memory_order_relaxed);
+            while (!m_free_head.compare_exchange_weak(head, free_head(uint32_t(first), head),
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Chunked: raise the generation of new chunks past that of every slot
+        // from `first` on, before those chunks are released
+        void retire_generations(size_t first)
+        {
+            const size_t slots = m_capacity / sizeof(T);
+            for (size_t slot = first; slot < slots; ++slot)
+            {
+                handle_ver_type next = generation(slot).load(std::memory_order_relaxed) + 1;
+                if (next == handle_ver_null) next = 0;
+                m_first_generation = std::max(m_first_generation, next);
+            }
+        }
+
+        // Release the buffer or chunks. Elements must already be destroyed.
+        void free_storage()
+        {
+            if (m_growth == PoolGrowth::Chunked)
+                retire_generations(0);
+            if (m_pool)
+                aligned_free(&m_pool);
+            for (size_t i = 0; i < m_chunks.size(); ++i)
+            {
+                void* chunk = m_chunks[i];
+                aligned_free(&chunk);
+            }
+            m_chunks.clear();
+            m_capacity = 0;
         }
 
         /// @brief Expand the freelist to a new capacity.
@@ -360,23 +708,24 @@ namespace eeng {
                 i += sizeof(T))
             {
                 if (free_last != index_null)
-                    *ptr_at<index_type>(m_pool, free_last) = i;
+                    *ptr_at<index_type>(free_last) = i;
                 free_last = i;
             }
             // The last free element links to null
-            *ptr_at<index_type>(m_pool, free_last) = index_null;
+            *ptr_at<index_type>(free_last) = index_null;
         }
 
         /// @brief Resize to a new capacity larger than the current one.
         /// @tparam T The type of elements in the pool.
         /// @param size The new size in bytes.
-        /// @details All elements are moved to the new buffer.
+        /// @details All elements are moved to the new buffer. Relocate mode only.
         //          The freelist is preserved but not expanded:
         //          new elements must be linked via expand_freelist().
         //          Shrinking the pool is not supported
         void resize(size_t size)
         {
             assert(size >= m_capacity && "Shrinking the pool is not supported");
+            assert(m_growth == PoolGrowth::Relocate);
             if (size == m_capacity) return;
 
             void* prev_pool = m_pool; m_pool = nullptr;
@@ -389,23 +738,18 @@ namespace eeng {
             // Copy data to new location
             if (prev_pool && m_pool)
             {
-                std::vector<bool> used(prev_capacity / sizeof(T), true);
-                freelist_visitor([&](index_type i) {
-                    used[i / sizeof(T)] = false;
-                    });
-
                 for (index_type index = 0; index < prev_capacity; index += sizeof(T))
                 {
-                    if (used[index / sizeof(T)])
+                    if (m_occupancy.test(index / sizeof(T)))
                     {
                         T* src_elem_ptr = ptr_at<T>(prev_pool, index);
-                        void* dest_elem_ptr = ptr_at<void>(m_pool, index);
+                        void* dest_elem_ptr = ptr_at<void>(index);
 
                         ::new(dest_elem_ptr) T(std::move(*src_elem_ptr));
                         src_elem_ptr->~T();
                     }
                     else
-                        *ptr_at<index_type>(m_pool, index) = *ptr_at<index_type>(prev_pool, index);
+                        *ptr_at<index_type>(index) = *ptr_at<index_type>(prev_pool, index);
                 }
             }
 
@@ -420,7 +764,7 @@ namespace eeng {
             while (cur_index != index_null)
             {
                 f(cur_index);
-                cur_index = *ptr_at<index_type>(m_pool, cur_index);
+                cur_index = *ptr_at<index_type>(cur_index);
             }
         }
     };
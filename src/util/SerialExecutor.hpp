@@ -3,8 +3,10 @@
 
 #pragma once
 #include "IExecutor.hpp"
+#include "ExecutorStats.hpp"
 #include <functional>
-#include <queue>
+#include <vector>
+#include <ranges>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -13,13 +15,22 @@ namespace eeng
 {
     /// A strand/serializing adapter that runs posted tasks one-at-a-time in FIFO order,
     /// using an *upstream* executor for actual execution. Thread-safe.
+    ///
+    /// Tasks run inside a single drain task posted upstream. The drain is tagged
+    /// with the strand's priority, or with the priority passed to the post() that
+    /// schedules it; tasks keep their FIFO order regardless.
+    ///
+    /// instrumentation() records queue latency, run time, queue depth and how
+    /// long each drain holds an upstream worker (StrandHold). Off by default.
     class SerialExecutor : public IExecutor
     {
     public:
-        using Fn = std::function<void()>;
+        using Fn = UniqueTask;
 
-        explicit SerialExecutor(IExecutor& upstream) noexcept
+        explicit SerialExecutor(IExecutor& upstream, TaskPriority priority = TaskPriority::Interactive) noexcept
             : upstream_(upstream)
+            , priority_(static_cast<uint8_t>(priority))
+            , stats_("strand")
         {
         }
 
@@ -30,33 +41,121 @@ namespace eeng
         // Fire-and-forget (returns void)
         void post(Fn fn) override
         {
+            post(std::move(fn), priority());
+        }
+
+        /// Fire-and-forget; `priority` tags the drain if this post schedules one
+        void post(Fn fn, TaskPriority priority) override
+        {
+            const uint64_t enqueued_ns = stats_.now_if_enabled();
+            size_t depth;
             {
                 std::lock_guard<std::mutex> lk(mutex_);
-                task_queue_.push(std::move(fn));
-                queued_count_.fetch_add(1, std::memory_order_relaxed);
+                task_queue_.push(std::move(fn), enqueued_ns);
+                depth = queued_count_.fetch_add(1, std::memory_order_relaxed) + 1;
             }
-            schedule_worker_once();
+            if (enqueued_ns)
+                record_enqueue(enqueued_ns, depth);
+            schedule_worker_once(priority);
+        }
+
+        /// Fire-and-forget fn(element) for every element of `range`, in order, as
+        /// one task each (with a copy of the element and of fn). Takes the queue
+        /// lock once and schedules at most one drain.
+        template<class Range, class F>
+        void post_bulk(Range&& range, F fn)
+        {
+            post_bulk(std::forward<Range>(range), std::move(fn), priority());
+        }
+
+        template<class Range, class F>
+        void post_bulk(Range&& range, F fn, TaskPriority priority)
+        {
+            using Element = std::ranges::range_value_t<Range>;
+            std::vector<Fn> tasks;
+            if constexpr (std::ranges::sized_range<Range>)
+                tasks.reserve(std::ranges::size(range));
+            for (auto&& element : range)
+                tasks.emplace_back([fn, element = Element(element)]() mutable { fn(element); });
+            push_bulk(tasks, priority);
+        }
+
+        /// submit() for every element of `range`, like post_bulk()
+        /// @return One future per element, in range order
+        template<class Range, class F>
+        auto submit_bulk(Range&& range, F fn)
+            -> std::vector<std::shared_future<std::invoke_result_t<F&, std::ranges::range_value_t<Range>&>>>
+        {
+            return submit_bulk(std::forward<Range>(range), std::move(fn), priority());
+        }
+
+        template<class Range, class F>
+        auto submit_bulk(Range&& range, F fn, TaskPriority priority)
+            -> std::vector<std::shared_future<std::invoke_result_t<F&, std::ranges::range_value_t<Range>&>>>
+        {
+            using Element = std::ranges::range_value_t<Range>;
+            using R = std::invoke_result_t<F&, Element&>;
+
+            std::vector<std::shared_future<R>> futures;
+            std::vector<Fn> tasks;
+            if constexpr (std::ranges::sized_range<Range>)
+            {
+                futures.reserve(std::ranges::size(range));
+                tasks.reserve(std::ranges::size(range));
+            }
+            for (auto&& element : range)
+            {
+                std::promise<R> prom;
+                futures.push_back(prom.get_future().share());
+                tasks.emplace_back([p = std::move(prom), fn, element = Element(element)]() mutable {
+                    try {
+                        if constexpr (std::is_void_v<R>) { fn(element); p.set_value(); }
+                        else { p.set_value(fn(element)); }
+                    }
+                    catch (...) { p.set_exception(std::current_exception()); }
+                    });
+            }
+            push_bulk(tasks, priority);
+            return futures;
         }
 
         // Returns shared_future<R>
         template<class F>
         auto submit(F&& f) -> std::shared_future<std::invoke_result_t<F&>>
+        {
+            return submit(std::forward<F>(f), priority());
+        }
+
+        // Returns shared_future<R>; `priority` tags the drain if this submit schedules one
+        template<class F>
+        auto submit(F&& f, TaskPriority priority) -> std::shared_future<std::invoke_result_t<F&>>
         {
             using R = std::invoke_result_t<F&>;
-            auto prom = std::make_shared<std::promise<R>>();
-            auto fut = prom->get_future().share();
+            std::promise<R> prom;
+            auto fut = prom.get_future().share();
 
             post([p = std::move(prom), fn = std::forward<F>(f)]() mutable {
                 try {
-                    if constexpr (std::is_void_v<R>) { fn(); p->set_value(); }
-                    else { p->set_value(fn()); }
+                    if constexpr (std::is_void_v<R>) { fn(); p.set_value(); }
+                    else { p.set_value(fn()); }
                 }
-                catch (...) { p->set_exception(std::current_exception()); }
-                });
+                catch (...) { p.set_exception(std::current_exception()); }
+                }, priority);
 
             return fut;
         }
 
+        /// Default priority for drains scheduled by post()/submit()
+        void set_priority(TaskPriority priority) noexcept
+        {
+            priority_.store(static_cast<uint8_t>(priority), std::memory_order_relaxed);
+        }
+
+        TaskPriority priority() const noexcept
+        {
+            return static_cast<TaskPriority>(priority_.load(std::memory_order_relaxed));
+        }
+
         // --- Introspection (thread-safe) -------------------------------------
 
         /// True while the strand's worker loop is executing tasks
@@ -87,24 +186,52 @@ namespace eeng
                 });
         }
 
+        /// Latency, run-time, depth and strand-hold histograms. Off by default.
+        ExecutorStats& instrumentation() noexcept { return stats_; }
+        const ExecutorStats& instrumentation() const noexcept { return stats_; }
+
     private:
-        void schedule_worker_once()
+        void push_bulk(std::vector<Fn>& tasks, TaskPriority priority)
+        {
+            if (tasks.empty()) return;
+            const uint64_t enqueued_ns = stats_.now_if_enabled();
+            size_t depth;
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                for (auto& task : tasks)
+                    task_queue_.push(std::move(task), enqueued_ns);
+                depth = queued_count_.fetch_add(tasks.size(), std::memory_order_relaxed) + tasks.size();
+            }
+            if (enqueued_ns)
+                record_enqueue(enqueued_ns, depth);
+            schedule_worker_once(priority);
+        }
+
+        void record_enqueue(uint64_t now_ns, size_t depth)
+        {
+            stats_.record(ExecutorMetric::QueueDepth, depth);
+            stats_.trace_counter("strand_depth", now_ns, depth);
+        }
+
+        void schedule_worker_once(TaskPriority priority)
         {
             bool expect = false;
             if (worker_scheduled_.compare_exchange_strong(expect, true, std::memory_order_acq_rel))
             {
                 // Schedule a single drain on the upstream executor
-                upstream_.post([this] { this->drain(); });
+                upstream_.post([this] { this->drain(); }, priority);
             }
         }
 
         void drain()
         {
             running_.store(true, std::memory_order_relaxed);
+            const uint64_t hold_from = stats_.now_if_enabled();
 
             for (;;)
             {
                 Fn f;
+                uint64_t enqueued_ns = 0;
                 {
                     std::lock_guard<std::mutex> lk(mutex_);
                     if (task_queue_.empty())
@@ -124,13 +251,23 @@ namespace eeng
                                 continue; // re-enter loop and keep draining
                             }
                         }
+                        if (hold_from)
+                        {
+                            // Still under the lock, so a wait_idle() caller cannot have returned yet
+                            const uint64_t hold_to = ExecutorStats::now();
+                            stats_.record(ExecutorMetric::StrandHold, hold_to - hold_from);
+                            stats_.trace_span("strand_hold", hold_from, hold_to);
+                        }
                         return;
                     }
-                    f = std::move(task_queue_.front());
-                    task_queue_.pop();
+                    f = task_queue_.pop(enqueued_ns);
                     queued_count_.fetch_sub(1, std::memory_order_relaxed);
                 }
 
+                const uint64_t started_ns = enqueued_ns ? ExecutorStats::now() : 0;
+                if (started_ns)
+                    stats_.record(ExecutorMetric::QueueLatency, started_ns - enqueued_ns);
+
                 // Execute task outside the lock so new tasks can be enqueued
                 try {
                     f();
@@ -138,16 +275,73 @@ namespace eeng
                 catch (...) {
                     // Swallow exceptions ...
                 }
+
+                if (started_ns)
+                {
+                    const uint64_t finished_ns = ExecutorStats::now();
+                    stats_.record(ExecutorMetric::RunTime, finished_ns - started_ns);
+                    stats_.trace_span("strand_task", started_ns, finished_ns);
+                }
             }
         }
 
     private:
+        /// FIFO ring of tasks. Grows but never shrinks, so a strand in steady
+        /// use does not allocate per task.
+        class TaskRing
+        {
+        public:
+            bool empty() const noexcept { return count_ == 0; }
+
+            void push(Fn&& fn, uint64_t enqueued_ns)
+            {
+                if (count_ == slots_.size())
+                    grow();
+                Entry& entry = slots_[(head_ + count_) & (slots_.size() - 1)];
+                entry.fn = std::move(fn);
+                entry.enqueued_ns = enqueued_ns;
+                ++count_;
+            }
+
+            Fn pop(uint64_t& enqueued_ns) noexcept
+            {
+                Entry& entry = slots_[head_];
+                enqueued_ns = entry.enqueued_ns;
+                Fn fn = std::move(entry.fn);
+                head_ = (head_ + 1) & (slots_.size() - 1);
+                --count_;
+                return fn;
+            }
+
+        private:
+            struct Entry
+            {
+                Fn fn;
+                uint64_t enqueued_ns = 0; // Set when instrumentation is enabled
+            };
+
+            void grow()
+            {
+                std::vector<Entry> bigger(slots_.empty() ? 16 : slots_.size() * 2);
+                for (size_t i = 0; i < count_; ++i)
+                    bigger[i] = std::move(slots_[(head_ + i) & (slots_.size() - 1)]);
+                slots_.swap(bigger);
+                head_ = 0;
+            }
+
+            std::vector<Entry> slots_; // Size is zero or a power of two
+            size_t head_ = 0;
+            size_t count_ = 0;
+        };
+
         IExecutor& upstream_;
+        std::atomic<uint8_t> priority_;
 
         // Queue & coordination
         mutable std::mutex mutex_;
         std::condition_variable cv_idle_;
-        std::queue<Fn> task_queue_;
+        TaskRing task_queue_;
+        ExecutorStats stats_;
 
         // State flags / counters
         std::atomic<bool>   worker_scheduled_{ false }; // ensures only one drain() is posted
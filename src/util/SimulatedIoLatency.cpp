@@ -0,0 +1,97 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "SimulatedIoLatency.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace eeng
+{
+    IoLatencyModel IoLatencyModel::fixed(float latency_ms)
+    {
+        return IoLatencyModel{ .kind = Kind::Fixed, .latency_ms = latency_ms };
+    }
+
+    IoLatencyModel IoLatencyModel::jittered(float latency_ms, float jitter_ms)
+    {
+        return IoLatencyModel{ .kind = Kind::Jittered, .latency_ms = latency_ms, .jitter_ms = jitter_ms };
+    }
+
+    IoLatencyModel IoLatencyModel::bandwidth(float mb_per_s, float latency_ms)
+    {
+        return IoLatencyModel{ .kind = Kind::Bandwidth, .latency_ms = latency_ms, .bandwidth_mb_per_s = mb_per_s };
+    }
+
+    void SimulatedIoLatency::set_default(const IoLatencyModel& model)
+    {
+        std::lock_guard lock(mutex_);
+        default_ = model;
+        update_enabled_no_lock();
+    }
+
+    void SimulatedIoLatency::set_for_type(const std::string& type_id, const IoLatencyModel& model)
+    {
+        std::lock_guard lock(mutex_);
+        by_type_[type_id] = model;
+        update_enabled_no_lock();
+    }
+
+    void SimulatedIoLatency::clear()
+    {
+        std::lock_guard lock(mutex_);
+        default_ = IoLatencyModel{};
+        by_type_.clear();
+        update_enabled_no_lock();
+    }
+
+    IoLatencyModel SimulatedIoLatency::model_for(std::string_view type_id) const
+    {
+        std::lock_guard lock(mutex_);
+        auto it = by_type_.find(std::string{ type_id });
+        return it != by_type_.end() ? it->second : default_;
+    }
+
+    std::chrono::microseconds SimulatedIoLatency::delay_for(std::string_view type_id, uintmax_t bytes) const
+    {
+        if (!enabled())
+            return {};
+
+        const IoLatencyModel model = model_for(type_id);
+        double ms = std::max(model.latency_ms, 0.0f);
+        switch (model.kind)
+        {
+        case IoLatencyModel::Kind::Off:
+            return {};
+        case IoLatencyModel::Kind::Fixed:
+            break;
+        case IoLatencyModel::Kind::Jittered:
+            if (model.jitter_ms > 0.0f)
+            {
+                thread_local std::mt19937 rng{ std::random_device{}() };
+                ms += std::uniform_real_distribution<double>(0.0, model.jitter_ms)(rng);
+            }
+            break;
+        case IoLatencyModel::Kind::Bandwidth:
+            if (model.bandwidth_mb_per_s > 0.0f)
+                ms += static_cast<double>(bytes) / (model.bandwidth_mb_per_s * 1e6) * 1e3;
+            break;
+        }
+        return std::chrono::microseconds{ static_cast<int64_t>(ms * 1e3) };
+    }
+
+    void SimulatedIoLatency::simulate(std::string_view type_id, uintmax_t bytes) const
+    {
+        const auto delay = delay_for(type_id, bytes);
+        if (delay.count() > 0)
+            std::this_thread::sleep_for(delay);
+    }
+
+    void SimulatedIoLatency::update_enabled_no_lock()
+    {
+        bool any = default_.kind != IoLatencyModel::Kind::Off;
+        for (const auto& [type_id, model] : by_type_)
+            any = any || model.kind != IoLatencyModel::Kind::Off;
+        enabled_.store(any, std::memory_order_release);
+    }
+}
@@ -0,0 +1,75 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef SIMULATEDIOLATENCY_HPP
+#define SIMULATEDIOLATENCY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace eeng
+{
+    /// How long a simulated read of one asset takes
+    struct IoLatencyModel
+    {
+        enum class Kind : uint8_t
+        {
+            Off,        // No delay
+            Fixed,      // latency_ms per read
+            Jittered,   // latency_ms plus a uniformly random 0..jitter_ms
+            Bandwidth   // latency_ms plus file size / bandwidth_mb_per_s
+        };
+
+        Kind kind = Kind::Off;
+        float latency_ms = 0.0f;
+        float jitter_ms = 0.0f;
+        float bandwidth_mb_per_s = 0.0f;
+
+        static IoLatencyModel fixed(float latency_ms);
+        static IoLatencyModel jittered(float latency_ms, float jitter_ms);
+        static IoLatencyModel bandwidth(float mb_per_s, float latency_ms = 0.0f);
+    };
+
+    /// Artificial read latency for asset loads, to stress-test the asynchronous
+    /// load paths. Holds a default model and optional per-type models keyed by
+    /// meta type id string (AssetMetaData::type_id). Off until a model is set.
+    ///
+    /// Thread-safe: loads query it from worker threads while the main thread
+    /// may change it.
+    class SimulatedIoLatency
+    {
+    public:
+        /// Model for asset types without a model of their own
+        void set_default(const IoLatencyModel& model);
+
+        void set_for_type(const std::string& type_id, const IoLatencyModel& model);
+
+        /// Turns the simulation off for all types
+        void clear();
+
+        IoLatencyModel model_for(std::string_view type_id) const;
+
+        /// False while no model is set, so callers can skip gathering inputs
+        bool enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+        /// Delay for one read of `bytes` bytes of an asset of type type_id
+        std::chrono::microseconds delay_for(std::string_view type_id, uintmax_t bytes) const;
+
+        /// Blocks the calling thread for delay_for(type_id, bytes)
+        void simulate(std::string_view type_id, uintmax_t bytes) const;
+
+    private:
+        void update_enabled_no_lock();
+
+        mutable std::mutex mutex_;
+        IoLatencyModel default_;
+        std::unordered_map<std::string, IoLatencyModel> by_type_;
+        std::atomic<bool> enabled_{ false };
+    };
+}
+
+#endif // SIMULATEDIOLATENCY_HPP
@@ -0,0 +1,227 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef TASKGRAPH_HPP
+#define TASKGRAPH_HPP
+
+#include "IExecutor.hpp"
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+/// A small dependency graph of tasks, run on any IExecutor.
+///
+/// Build the graph with emplace() and order tasks with precede()/succeed();
+/// run() then posts every task as soon as all of its predecessors have
+/// finished. A graph can be run any number of times, but not concurrently.
+///
+/// @code
+/// TaskGraph graph;
+/// auto load = graph.emplace([] { ... });
+/// auto skin = graph.emplace([] { ... });
+/// auto draw = graph.emplace([] { ... });
+/// load.precede(skin, draw);
+/// draw.succeed(skin);
+/// pool.get(graph.run(pool));
+/// @endcode
+class TaskGraph
+{
+    struct Node
+    {
+        std::function<void()> fn;
+        std::vector<Node*> successors;
+        size_t nbr_predecessors = 0;
+        std::atomic<size_t> pending{ 0 };
+    };
+
+public:
+    /// Lightweight handle to a task in a graph
+    class Task
+    {
+    public:
+        Task() = default;
+
+        /// This task runs before all of `others`
+        template <typename... Tasks>
+        Task& precede(Tasks... others)
+        {
+            (link(node, others.node), ...);
+            return *this;
+        }
+
+        /// This task runs after all of `others`
+        template <typename... Tasks>
+        Task& succeed(Tasks... others)
+        {
+            (link(others.node, node), ...);
+            return *this;
+        }
+
+        bool valid() const { return node != nullptr; }
+
+    private:
+        friend class TaskGraph;
+        explicit Task(Node* node) : node(node) {}
+
+        static void link(Node* from, Node* to)
+        {
+            if (!from || !to)
+                throw std::invalid_argument("TaskGraph: invalid task");
+            from->successors.push_back(to);
+            to->nbr_predecessors++;
+        }
+
+        Node* node = nullptr;
+    };
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /// Add a task. Not thread-safe, and not while the graph is running.
+    template <typename Func>
+    Task emplace(Func&& fn)
+    {
+        auto& node = nodes.emplace_back();
+        node.fn = std::forward<Func>(fn);
+        return Task(&node);
+    }
+
+    size_t size() const { return nodes.size(); }
+    bool empty() const { return nodes.empty(); }
+
+    /// @brief Post all tasks to `executor` in dependency order, in lane `priority`.
+    /// @return A future that becomes ready when every task has finished. It
+    ///         holds the first exception thrown by a task, if any; tasks not
+    ///         yet started when it was thrown are skipped.
+    /// @note The graph must outlive the run. Waiting from inside a ThreadPool
+    ///       task should go through ThreadPool::get().
+    /// @throws std::logic_error if the graph has a cycle or is already running
+    std::future<void> run(IExecutor& executor, TaskPriority priority = TaskPriority::Interactive)
+    {
+        auto run_state = std::make_shared<RunState>(executor, priority, nodes.size());
+        auto future = run_state->promise.get_future();
+
+        if (nodes.empty())
+        {
+            run_state->promise.set_value();
+            return future;
+        }
+        if (running.exchange(true))
+            throw std::logic_error("TaskGraph: already running");
+        if (has_cycle())
+        {
+            running = false;
+            throw std::logic_error("TaskGraph: dependency cycle");
+        }
+
+        run_state->on_done = [this]() { running = false; };
+
+        for (auto& node : nodes)
+            node.pending.store(node.nbr_predecessors, std::memory_order_relaxed);
+
+        for (auto& node : nodes)
+        {
+            if (node.nbr_predecessors == 0)
+                schedule(run_state, &node);
+        }
+        return future;
+    }
+
+private:
+    struct RunState
+    {
+        RunState(IExecutor& executor, TaskPriority priority, size_t count)
+            : executor(executor), priority(priority), remaining(count)
+        {
+        }
+
+        IExecutor& executor;
+        const TaskPriority priority;
+        std::atomic<size_t> remaining;
+        std::atomic<bool> failed{ false };
+        std::exception_ptr error;
+        std::promise<void> promise;
+        std::function<void()> on_done;
+    };
+
+    static void schedule(const std::shared_ptr<RunState>& run_state, Node* node)
+    {
+        run_state->executor.post([run_state, node]() { execute(run_state, node); }, run_state->priority);
+    }
+
+    static void execute(const std::shared_ptr<RunState>& run_state, Node* node)
+    {
+        // Run ready successors inline, one at a time, to skip a queue round-trip
+        while (node)
+        {
+            if (!run_state->failed.load(std::memory_order_acquire))
+            {
+                try
+                {
+                    if (node->fn) node->fn();
+                }
+                catch (...)
+                {
+                    if (!run_state->failed.exchange(true))
+                        run_state->error = std::current_exception();
+                }
+            }
+
+            Node* next = nullptr;
+            for (Node* succ : node->successors)
+            {
+                if (succ->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    continue;
+                if (next)
+                    schedule(run_state, next);
+                next = succ;
+            }
+
+            if (run_state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                run_state->on_done();
+                if (run_state->error)
+                    run_state->promise.set_exception(run_state->error);
+                else
+                    run_state->promise.set_value();
+            }
+            node = next;
+        }
+    }
+
+    // Kahn's algorithm: a cycle leaves some nodes that never become ready
+    bool has_cycle() const
+    {
+        std::vector<const Node*> ready;
+        std::unordered_map<const Node*, size_t> indegree;
+        for (const auto& node : nodes)
+        {
+            indegree[&node] = node.nbr_predecessors;
+            if (node.nbr_predecessors == 0) ready.push_back(&node);
+        }
+
+        size_t visited = 0;
+        while (!ready.empty())
+        {
+            const Node* node = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (const Node* succ : node->successors)
+            {
+                if (--indegree[succ] == 0) ready.push_back(succ);
+            }
+        }
+        return visited != nodes.size();
+    }
+
+    std::deque<Node> nodes; // Stable addresses for Task handles and successor links
+    std::atomic<bool> running{ false };
+};
+
+#endif // TASKGRAPH_HPP
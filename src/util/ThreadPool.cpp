@@ -1,46 +1,240 @@
 #include "ThreadPool.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace
+{
+    // Identifies the pool & worker the calling thread belongs to, if any
+    thread_local const ThreadPool* tls_pool = nullptr;
+    thread_local size_t tls_worker_index = 0;
+
+    // Bottom of each of the worker's deques when its current task started.
+    // Entries above were queued by that task and may be run by try_help().
+    thread_local std::array<int64_t, TaskPriorityCount> tls_task_floors{};
+
+    // Max number of tasks a worker moves from the injection queue to its own deque per visit
+    constexpr size_t injection_batch_max = 32;
+
+    // Acquire attempts before an idle worker goes to sleep
+    constexpr int idle_spin_count = 64;
+
+    // Starvation protection: how often an acquisition starts at a lower lane
+    constexpr uint32_t interactive_interval = 4;
+    constexpr uint32_t background_interval = 16;
+
+    size_t lane_of(TaskPriority priority)
+    {
+        return static_cast<size_t>(priority);
+    }
+
+    size_t starting_lane(uint32_t tick)
+    {
+        if (tick % background_interval == 0) return lane_of(TaskPriority::Background);
+        if (tick % interactive_interval == 0) return lane_of(TaskPriority::Interactive);
+        return lane_of(TaskPriority::FrameCritical);
+    }
+
+    // Spinning only pays off when every worker has a core of its own
+    int spin_limit_for(size_t thread_count)
+    {
+        const size_t cores = std::thread::hardware_concurrency();
+        return (cores == 0 || thread_count <= cores) ? idle_spin_count : 0;
+    }
+
+    // --- Platform ------------------------------------------------------------
+
+    // CPUs the process may run on
+    std::vector<int> available_cpus()
+    {
+        std::vector<int> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+        }
+#endif
+        if (cpus.empty())
+        {
+            const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            for (int cpu = 0; cpu < cores; ++cpu) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+#if defined(__linux__)
+    // Parse a sysfs CPU list such as "0-3,8-11"
+    std::vector<int> parse_cpu_list(const std::string& text)
+    {
+        std::vector<int> cpus;
+        std::stringstream ss(text);
+        std::string range;
+        while (std::getline(ss, range, ','))
+        {
+            int first = 0, last = 0;
+            const auto dash = range.find('-');
+            try
+            {
+                first = std::stoi(range.substr(0, dash));
+                last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            }
+            catch (const std::exception&)
+            {
+                continue;
+            }
+            for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+#endif
+
+    // Available CPUs grouped by NUMA node. Always at least one group.
+    std::vector<std::vector<int>> numa_topology()
+    {
+        const std::vector<int> available = available_cpus();
+        auto is_available = [&](int cpu)
+            {
+                return std::find(available.begin(), available.end(), cpu) != available.end();
+            };
+
+        std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+        for (int node = 0;; ++node)
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file) break;
+            std::string text;
+            std::getline(file, text);
+
+            std::vector<int> cpus;
+            for (int cpu : parse_cpu_list(text))
+                if (is_available(cpu)) cpus.push_back(cpu);
+            if (!cpus.empty()) nodes.push_back(std::move(cpus));
+        }
+#elif defined(_WIN32)
+        ULONG highest = 0;
+        if (GetNumaHighestNodeNumber(&highest))
+        {
+            for (ULONG node = 0; node <= highest; ++node)
+            {
+                ULONGLONG mask = 0;
+                if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask)) continue;
+
+                std::vector<int> cpus;
+                for (int cpu = 0; cpu < 64; ++cpu)
+                    if ((mask >> cpu) & 1 && is_available(cpu)) cpus.push_back(cpu);
+                if (!cpus.empty()) nodes.push_back(std::move(cpus));
+            }
+        }
+#else
+        (void)is_available;
+#endif
+        if (nodes.empty())
+            nodes.push_back(available);
+        return nodes;
+    }
+
+    // Name the calling thread
+    void set_current_thread_name(const std::string& name)
+    {
+#if defined(_WIN32)
+        std::wstring wide(name.begin(), name.end());
+        SetThreadDescription(GetCurrentThread(), wide.c_str());
+#elif defined(__linux__)
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+        pthread_setname_np(name.c_str());
+#else
+        (void)name;
+#endif
+    }
+
+    // Restrict the calling thread to `cpus`. Best effort: failures are ignored.
+    void set_current_thread_affinity(const std::vector<int>& cpus)
+    {
+        if (cpus.empty()) return;
+#if defined(_WIN32)
+        DWORD_PTR mask = 0;
+        for (int cpu : cpus)
+            if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) mask |= DWORD_PTR(1) << cpu;
+        if (mask) SetThreadAffinityMask(GetCurrentThread(), mask);
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+    }
+}
 
 ThreadPool::ThreadPool(size_t thread_count)
-    : thread_count(thread_count)
+    : ThreadPool(ThreadPoolConfig{ thread_count })
+{
+}
+
+ThreadPool::ThreadPool(const ThreadPoolConfig& config)
+    : executor_stats(config.name)
+    , thread_count(config.thread_count)
+    , spin_limit(spin_limit_for(config.thread_count))
 {
+    // Placement: workers are split into contiguous groups, one per NUMA node
+    // when numa_aware, and pinned round-robin to the CPUs of their group
+    auto nodes = numa_topology();
+    if (!config.numa_aware && nodes.size() > 1)
+    {
+        std::vector<int> all;
+        for (const auto& cpus : nodes) all.insert(all.end(), cpus.begin(), cpus.end());
+        std::sort(all.begin(), all.end());
+        nodes = { std::move(all) };
+    }
+    numa_node_count = std::max<size_t>(1, std::min(nodes.size(), thread_count));
+
+    workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; ++i)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->name = config.name + "-" + std::to_string(i);
+        worker->numa_node = i * numa_node_count / thread_count;
+
+        const auto& cpus = nodes[worker->numa_node];
+        const size_t group_first = (worker->numa_node * thread_count + numa_node_count - 1) / numa_node_count;
+        if (config.pin_threads)
+        {
+            worker->cpu = cpus[(i - group_first) % cpus.size()];
+            worker->affinity = { worker->cpu };
+        }
+        else if (numa_node_count > 1)
+        {
+            worker->affinity = cpus;
+        }
+        workers.push_back(std::move(worker));
+    }
+
+    // Start threads only after all deques exist, since workers steal from each other
     for (size_t i = 0; i < thread_count; ++i)
     {
-        workers.emplace_back([this]()
+        workers[i]->thread = std::thread([this, i]()
             {
-                while (true)
-                {
-                    std::function<void()> task;
-                    {
-                        std::unique_lock<std::mutex> lock(queue_mutex);
-                        cv.wait(lock, [this]()
-                            {
-                                return !task_queue.empty() || stop;
-                            });
-
-                        if (stop && task_queue.empty())
-                        {
-                            return;
-                        }
-
-                        task = std::move(task_queue.front());
-                        task_queue.pop();
-                    }
-
-                    working_count++;
-                    try
-                    {
-                        task();
-                    }
-                    catch (const std::exception& e)
-                    {
-                        std::cerr << "Exception in thread: " << e.what() << std::endl;
-                    }
-                    catch (...)
-                    {
-                        std::cerr << "Unknown exception in thread." << std::endl;
-                    }
-                    working_count--;
-                }
+                worker_loop(i);
             });
     }
 }
@@ -48,19 +242,376 @@ ThreadPool::ThreadPool(size_t thread_count)
 ThreadPool::~ThreadPool()
 {
     {
-        std::lock_guard<std::mutex> lock(queue_mutex);
+        std::lock_guard<std::mutex> lock(sleep_mutex);
         stop = true;
     }
     cv.notify_all();
     for (auto& worker : workers)
     {
-        worker.join();
+        worker->thread.join();
+    }
+
+    // Workers drain all queues before exiting, but be defensive
+    for (auto& queue : injection_queues)
+    {
+        while (Task* task = queue.pop())
+        {
+            task->fn.reset();
+            task_pool.release(task);
+        }
+    }
+}
+
+void ThreadPool::TaskList::push(Task* task)
+{
+    task->next = nullptr;
+    if (tail) tail->next = task;
+    else head = task;
+    tail = task;
+    ++size;
+}
+
+void ThreadPool::TaskList::append(Task* first, Task* last, size_t count)
+{
+    last->next = nullptr;
+    if (tail) tail->next = first;
+    else head = first;
+    tail = last;
+    size += count;
+}
+
+ThreadPool::Task* ThreadPool::TaskList::pop()
+{
+    Task* task = head;
+    if (task)
+    {
+        head = task->next;
+        if (!head) tail = nullptr;
+        --size;
+    }
+    return task;
+}
+
+void ThreadPool::post(UniqueTask fn)
+{
+    post(std::move(fn), TaskPriority::Interactive);
+}
+
+void ThreadPool::post(UniqueTask fn, TaskPriority priority)
+{
+    enqueue(std::move(fn), priority);
+}
+
+void ThreadPool::enqueue(UniqueTask fn, TaskPriority priority)
+{
+    const size_t lane = lane_of(priority);
+
+    const uint64_t enqueued_ns = executor_stats.now_if_enabled();
+    Task* task = task_pool.acquire();
+    task->fn = std::move(fn);
+    task->enqueued_ns = enqueued_ns;
+
+    // Count before publishing, so a worker never takes a task it isn't yet counted for
+    pending_counts[lane].fetch_add(1);
+    if (enqueued_ns)
+        record_enqueue(enqueued_ns);
+
+    if (tls_pool == this)
+    {
+        // Fan-out from a worker: no locking
+        workers[tls_worker_index]->deques[lane].push(task);
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(injection_mutex);
+        injection_queues[lane].push(task);
+        injection_counts[lane].store(injection_queues[lane].size, std::memory_order_relaxed);
+    }
+
+    wake_workers(1);
+}
+
+void ThreadPool::enqueue_bulk(std::vector<UniqueTask>& fns, TaskPriority priority)
+{
+    if (fns.empty()) return;
+    const size_t lane = lane_of(priority);
+    const size_t count = fns.size();
+
+    // Chain the nodes before taking any lock
+    const uint64_t enqueued_ns = executor_stats.now_if_enabled();
+    Task* first = nullptr;
+    Task* last = nullptr;
+    for (auto& fn : fns)
+    {
+        Task* task = task_pool.acquire();
+        task->fn = std::move(fn);
+        task->enqueued_ns = enqueued_ns;
+        task->next = nullptr;
+        if (last) last->next = task;
+        else first = task;
+        last = task;
+    }
+    fns.clear();
+
+    pending_counts[lane].fetch_add(count);
+    if (enqueued_ns)
+        record_enqueue(enqueued_ns);
+
+    if (tls_pool == this)
+    {
+        auto& own = workers[tls_worker_index]->deques[lane];
+        for (Task* task = first; task;)
+        {
+            Task* next = task->next; // Read before publishing: a thief may run the task at once
+            own.push(task);
+            task = next;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(injection_mutex);
+        injection_queues[lane].append(first, last, count);
+        injection_counts[lane].store(injection_queues[lane].size, std::memory_order_relaxed);
+    }
+
+    wake_workers(count);
+}
+
+void ThreadPool::record_enqueue(uint64_t now_ns)
+{
+    const size_t depth = pending_total();
+    executor_stats.record(ExecutorMetric::QueueDepth, depth);
+    executor_stats.trace_counter("queue_depth", now_ns, depth);
+}
+
+void ThreadPool::wake_workers(size_t count)
+{
+    // A worker increments sleeping_count before it re-checks the pending
+    // counts under sleep_mutex, so either it sees the new tasks or we see it.
+    const size_t sleeping = sleeping_count.load();
+    if (sleeping == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+    }
+    if (count >= sleeping)
+    {
+        cv.notify_all();
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+            cv.notify_one();
+    }
+}
+
+ThreadPool::Task* ThreadPool::try_acquire(size_t index)
+{
+    // Usually highest lane first; every few tasks a lower lane gets first pick
+    auto& worker = *workers[index];
+    const size_t first = starting_lane(worker.acquire_tick + 1);
+
+    Task* task = try_acquire_lane(index, first);
+    for (size_t lane = 0; !task && lane < TaskPriorityCount; ++lane)
+    {
+        if (lane != first)
+            task = try_acquire_lane(index, lane);
     }
+    if (task)
+        ++worker.acquire_tick;
+    return task;
 }
 
-void ThreadPool::post(std::function<void()> fn)
+ThreadPool::Task* ThreadPool::try_acquire_lane(size_t index, size_t lane)
 {
-    queue_task(std::move(fn));
+    // Most of the time only one lane is in use
+    if (pending_counts[lane].load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    Task* task = nullptr;
+    auto& own = workers[index]->deques[lane];
+
+    // 1) Own deque
+    if (!own.pop(task))
+    {
+        // 2) Injection queue: take one to run and move a batch to the own deque
+        if (injection_counts[lane].load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> lock(injection_mutex);
+            auto& queue = injection_queues[lane];
+            task = queue.pop();
+            if (task)
+            {
+                const size_t share = queue.size / thread_count;
+                const size_t batch = std::min(share, injection_batch_max);
+                for (size_t i = 0; i < batch; ++i)
+                    own.push(queue.pop());
+                injection_counts[lane].store(queue.size, std::memory_order_relaxed);
+            }
+        }
+
+        // 3) Steal from other workers
+        if (!task)
+            task = try_steal(index, lane);
+    }
+
+    if (task)
+    {
+        pending_counts[lane].fetch_sub(1);
+    }
+    return task;
+}
+
+ThreadPool::Task* ThreadPool::try_steal(size_t index, size_t lane)
+{
+    if (thread_count < 2) return nullptr;
+
+    // Stay on the own NUMA node when possible
+    if (numa_node_count > 1)
+    {
+        if (Task* task = try_steal_from(index, lane, true))
+            return task;
+    }
+    return try_steal_from(index, lane, false);
+}
+
+ThreadPool::Task* ThreadPool::try_steal_from(size_t index, size_t lane, bool same_node)
+{
+    const size_t node = workers[index]->numa_node;
+
+    // Start at a pseudo-random victim to spread thieves out
+    thread_local uint32_t seed = static_cast<uint32_t>(index * 2654435761u + 1u);
+    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+
+    const size_t start = seed % thread_count;
+    for (size_t k = 0; k < thread_count; ++k)
+    {
+        const size_t victim = (start + k) % thread_count;
+        if (victim == index) continue;
+        if (same_node && workers[victim]->numa_node != node) continue;
+
+        Task* task = nullptr;
+        if (workers[victim]->deques[lane].steal(task))
+            return task;
+    }
+    return nullptr;
+}
+
+void ThreadPool::worker_loop(size_t index)
+{
+    tls_pool = this;
+    tls_worker_index = index;
+
+    auto& worker = *workers[index];
+    set_current_thread_name(worker.name);
+    set_current_thread_affinity(worker.affinity);
+
+    while (true)
+    {
+        Task* task = try_acquire(index);
+
+        for (int spin = 0; !task && spin < spin_limit && pending_total() > 0; ++spin)
+        {
+            std::this_thread::yield();
+            task = try_acquire(index);
+        }
+
+        if (!task)
+        {
+            std::unique_lock<std::mutex> lock(sleep_mutex);
+            sleeping_count.fetch_add(1);
+            cv.wait(lock, [this]()
+                {
+                    return pending_total() > 0 || stop;
+                });
+            sleeping_count.fetch_sub(1);
+
+            if (stop && pending_total() == 0)
+            {
+                return;
+            }
+            continue;
+        }
+
+        working_count++;
+        const auto start = std::chrono::steady_clock::now();
+        execute(task);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        worker.busy_ns.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+            std::memory_order_relaxed);
+        working_count--;
+    }
+}
+
+bool ThreadPool::try_help()
+{
+    if (tls_pool != this) return false;
+
+    // Only work queued by the current task, most urgent lane first
+    auto& worker = *workers[tls_worker_index];
+    for (size_t lane = 0; lane < TaskPriorityCount; ++lane)
+    {
+        Task* task = nullptr;
+        if (worker.deques[lane].pop_above(tls_task_floors[lane], task))
+        {
+            pending_counts[lane].fetch_sub(1);
+            execute(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task* task)
+{
+    // Nested tasks (run via try_help) get their own floors
+    const auto outer_floors = tls_task_floors;
+    auto& worker = *workers[tls_worker_index];
+    for (size_t lane = 0; lane < TaskPriorityCount; ++lane)
+        tls_task_floors[lane] = worker.deques[lane].bottom_index();
+
+    const uint64_t started_ns = task->enqueued_ns ? ExecutorStats::now() : 0;
+    if (started_ns)
+        executor_stats.record(ExecutorMetric::QueueLatency, started_ns - task->enqueued_ns);
+
+    try
+    {
+        task->fn();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Exception in thread: " << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception in thread." << std::endl;
+    }
+
+    tls_task_floors = outer_floors;
+    worker.executed_count.fetch_add(1, std::memory_order_relaxed);
+
+    if (started_ns)
+    {
+        const uint64_t finished_ns = ExecutorStats::now();
+        executor_stats.record(ExecutorMetric::RunTime, finished_ns - started_ns);
+        executor_stats.trace_span("task", started_ns, finished_ns);
+    }
+
+    task->fn.reset();
+    task_pool.release(task);
+}
+
+size_t ThreadPool::pending_total() const
+{
+    size_t total = 0;
+    for (const auto& count : pending_counts)
+        total += count.load();
+    return total;
+}
+
+bool ThreadPool::is_worker_thread() const
+{
+    return tls_pool == this;
 }
 
 size_t ThreadPool::nbr_threads() const
@@ -80,12 +631,53 @@ size_t ThreadPool::nbr_idle_threads() const
 
 size_t ThreadPool::task_queue_size() const
 {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    return task_queue.size();
+    return pending_total();
+}
+
+size_t ThreadPool::task_queue_size(TaskPriority priority) const
+{
+    return pending_counts[lane_of(priority)].load();
 }
 
 bool ThreadPool::is_task_queue_empty() const
 {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    return task_queue.empty();
+    return pending_total() == 0;
+}
+
+const std::string& ThreadPool::worker_name(size_t worker) const
+{
+    return workers.at(worker)->name;
+}
+
+int ThreadPool::worker_cpu(size_t worker) const
+{
+    return workers.at(worker)->cpu;
+}
+
+size_t ThreadPool::worker_numa_node(size_t worker) const
+{
+    return workers.at(worker)->numa_node;
+}
+
+size_t ThreadPool::nbr_numa_nodes() const
+{
+    return numa_node_count;
+}
+
+size_t ThreadPool::nbr_executed_tasks(size_t worker) const
+{
+    return workers.at(worker)->executed_count.load(std::memory_order_relaxed);
+}
+
+size_t ThreadPool::nbr_executed_tasks() const
+{
+    size_t total = 0;
+    for (const auto& worker : workers)
+        total += worker->executed_count.load(std::memory_order_relaxed);
+    return total;
+}
+
+std::chrono::nanoseconds ThreadPool::busy_time(size_t worker) const
+{
+    return std::chrono::nanoseconds(workers.at(worker)->busy_ns.load(std::memory_order_relaxed));
 }
@@ -2,68 +2,408 @@
 #define THREADPOOL_HPP
 
 #include "IExecutor.hpp"
+#include "WorkStealingDeque.hpp"
+#include "NodePool.hpp"
+#include "ExecutorStats.hpp"
 #include <future>
-#include <queue>
+#include <chrono>
 #include <functional>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <algorithm>
+#include <array>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <ranges>
+#include <string>
 #include <type_traits>
 #include <utility>
 
+/// Worker placement and naming for a ThreadPool
+struct ThreadPoolConfig
+{
+    size_t thread_count = std::thread::hardware_concurrency();
+
+    /// Workers are named "<name>-<index>", as shown by top, perf and debuggers.
+    /// Linux truncates thread names to 15 characters.
+    std::string name = "pool";
+
+    /// Pin each worker to a single CPU. Ignored where unsupported (macOS).
+    bool pin_threads = false;
+
+    /// Split workers into one group per NUMA node, keep each group on its
+    /// node's CPUs and let idle workers steal within their group first.
+    bool numa_aware = false;
+};
+
+/// Work-stealing thread pool.
+///
+/// Each worker owns a lock-free deque. Tasks queued from a worker thread go
+/// to that worker's deque (LIFO for the owner, good cache locality for fan-out),
+/// while tasks queued from other threads go to a shared injection queue that
+/// workers drain in batches. Idle workers steal from the top of other workers'
+/// deques before going to sleep.
+///
+/// Tasks that block on sub-tasks should wait via wait()/get() rather than on
+/// the future directly: the waiting worker then runs the sub-tasks itself
+/// instead of idling, so nested waits cannot starve or deadlock the pool.
+///
+/// Every task belongs to a priority lane (see TaskPriority), and workers look
+/// for work in higher lanes first. To keep lower lanes from starving, every
+/// 4th acquisition starts with the interactive lane and every 16th with the
+/// background lane.
+///
+/// See ThreadPoolConfig for worker naming, CPU pinning and NUMA placement,
+/// and instrumentation() for latency/run-time histograms and traces.
 class ThreadPool : public IExecutor
 {
 public:
     explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+    explicit ThreadPool(const ThreadPoolConfig& config);
     ~ThreadPool();
 
     // IExecutor
-    void post(std::function<void()> fn) override;
+    void post(UniqueTask fn) override;
+    void post(UniqueTask fn, TaskPriority priority) override;
 
     template <typename Func>
-    auto queue_task(Func task) -> std::future<std::invoke_result_t<Func>>;
+    auto queue_task(Func task, TaskPriority priority = TaskPriority::Interactive)
+        -> std::future<std::invoke_result_t<Func>>;
+
+    /// @brief queue_task() for every element of `range`: fn(element) runs as
+    /// its own task, with a copy of the element and of fn. The tasks are
+    /// enqueued under a single lock, and at most as many sleeping workers are
+    /// woken as there are tasks.
+    /// @return One future per element, in range order
+    template <typename Range, typename Func>
+    auto queue_bulk(Range&& range, Func fn, TaskPriority priority = TaskPriority::Interactive)
+        -> std::vector<std::future<std::invoke_result_t<Func&, std::ranges::range_value_t<Range>&>>>;
+
+    /// @brief Block until a future is ready, helping out while waiting.
+    /// When called from a worker of this pool, the calling thread runs tasks
+    /// queued by its current task (typically the sub-tasks being waited on)
+    /// until the future is ready. Other threads simply block.
+    /// @param future A std::future or std::shared_future, e.g. a
+    ///        queue_task() or SerialExecutor::submit() result.
+    template <typename Future>
+    void wait(const Future& future);
+
+    /// @brief wait() for a future, then return its get()
+    /// @note For a std::shared_future the result is a reference into the shared
+    ///       state, so keep the future alive if binding the result by reference.
+    template <typename Future>
+    decltype(auto) get(Future&& future);
+
+    /// @brief Run fn over [begin, end) on the pool's workers and the calling thread.
+    /// Blocks until every index has been processed. The range is handed out in
+    /// chunks that shrink as it drains (no smaller than grain), so early chunks
+    /// amortize scheduling and late ones balance the load.
+    /// @param grain Minimum chunk size; 0 picks one from the range and thread count.
+    /// @param fn Either fn(Index i) or fn(Index first, Index last).
+    /// @param priority Lane for the helper tasks posted to the workers.
+    /// @note The first exception thrown by fn is rethrown here; indices not yet
+    ///       started when it was thrown are skipped.
+    template <typename Index, typename Func>
+    void parallel_for(
+        Index begin,
+        std::type_identity_t<Index> end,
+        size_t grain,
+        Func&& fn,
+        TaskPriority priority = TaskPriority::Interactive);
+
+    /// True if the calling thread is one of this pool's workers
+    bool is_worker_thread() const;
 
     size_t nbr_threads() const;
     size_t nbr_working_threads() const;
     size_t nbr_idle_threads() const;
     size_t task_queue_size() const;
+    size_t task_queue_size(TaskPriority priority) const;
     bool is_task_queue_empty() const;
 
+    // Per worker, for worker in [0, nbr_threads())
+    const std::string& worker_name(size_t worker) const;
+    int worker_cpu(size_t worker) const; // CPU the worker is pinned to, -1 if none
+    size_t worker_numa_node(size_t worker) const;
+    size_t nbr_numa_nodes() const;
+    size_t nbr_executed_tasks(size_t worker) const;
+    size_t nbr_executed_tasks() const; // All workers
+    std::chrono::nanoseconds busy_time(size_t worker) const; // Time spent running tasks
+
+    /// Queue latency, run time, queue depth and blocked-wait histograms. Off by default.
+    ExecutorStats& instrumentation() { return executor_stats; }
+    const ExecutorStats& instrumentation() const { return executor_stats; }
+
 private:
+    // Pooled queue node; deques and the injection lists hold these
+    struct Task
+    {
+        UniqueTask fn;
+        Task* next = nullptr; // Injection list link
+        uint64_t enqueued_ns = 0; // Set when instrumentation is enabled
+        uint32_t pool_index = 0;
+        std::atomic<uint32_t> pool_next{ 0 };
+    };
 
-    std::vector<std::thread> workers;
-    std::condition_variable cv;
+    // Intrusive FIFO, guarded by injection_mutex
+    struct TaskList
+    {
+        Task* head = nullptr;
+        Task* tail = nullptr;
+        size_t size = 0;
+
+        void push(Task* task);
+        void append(Task* first, Task* last, size_t count); // Chain linked via next
+        Task* pop();
+    };
+
+    struct Worker
+    {
+        std::array<WorkStealingDeque<Task*>, TaskPriorityCount> deques; // One per lane
+        uint32_t acquire_tick = 0; // Tasks acquired; owner only, drives lane aging
+        std::thread thread;
 
-    std::queue<std::function<void()>> task_queue;
-    mutable std::mutex queue_mutex;
+        // Placement, fixed at construction
+        std::string name;
+        std::vector<int> affinity; // CPUs the thread may run on, empty = any
+        int cpu = -1;
+        size_t numa_node = 0;
 
+        // Written by the owner only
+        std::atomic<uint64_t> executed_count{ 0 };
+        std::atomic<uint64_t> busy_ns{ 0 };
+    };
+
+    template <typename Index, typename Func>
+    struct ParallelForState;
+
+    void enqueue(UniqueTask fn, TaskPriority priority);
+    void enqueue_bulk(std::vector<UniqueTask>& fns, TaskPriority priority);
+    void wake_workers(size_t count);
+    void record_enqueue(uint64_t now_ns);
+    Task* try_acquire(size_t index);
+    Task* try_acquire_lane(size_t index, size_t lane);
+    Task* try_steal(size_t index, size_t lane);
+    Task* try_steal_from(size_t index, size_t lane, bool same_node);
+    bool try_help();
+    void execute(Task* task);
+    void worker_loop(size_t index);
+    size_t pending_total() const;
+
+    ExecutorStats executor_stats;
+    NodePool<Task> task_pool;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Tasks submitted from threads outside the pool, per lane
+    std::array<TaskList, TaskPriorityCount> injection_queues;
+    std::mutex injection_mutex;
+    std::array<std::atomic<size_t>, TaskPriorityCount> injection_counts{}; // Hints, let idle workers skip the lock
+
+    // Sleep/wake coordination
+    std::mutex sleep_mutex;
+    std::condition_variable cv;
+    std::atomic<size_t> sleeping_count{ 0 };
+
+    std::array<std::atomic<size_t>, TaskPriorityCount> pending_counts{}; // Queued, not yet started, per lane
     std::atomic<bool> stop{ false };
     std::atomic<size_t> working_count{ 0 };
 
     const size_t thread_count;
+    const int spin_limit;
+    size_t numa_node_count = 1;
 };
 
 // Template definition remains in the header
 template <typename Func>
-auto ThreadPool::queue_task(Func task) -> std::future<std::invoke_result_t<Func>>
+auto ThreadPool::queue_task(Func task, TaskPriority priority) -> std::future<std::invoke_result_t<Func>>
 {
     using ResultType = std::invoke_result_t<Func>;
 
-    auto packaged_task = std::make_shared<std::packaged_task<ResultType()>>(std::move(task));
-    auto future = packaged_task->get_future();
+    // packaged_task is move-only, which UniqueTask allows, and small enough to store inline
+    std::packaged_task<ResultType()> packaged_task(std::move(task));
+    auto future = packaged_task.get_future();
+
+    enqueue(UniqueTask(std::move(packaged_task)), priority);
+    return future;
+}
+
+template <typename Range, typename Func>
+auto ThreadPool::queue_bulk(Range&& range, Func fn, TaskPriority priority)
+    -> std::vector<std::future<std::invoke_result_t<Func&, std::ranges::range_value_t<Range>&>>>
+{
+    using Element = std::ranges::range_value_t<Range>;
+    using ResultType = std::invoke_result_t<Func&, Element&>;
+
+    std::vector<std::future<ResultType>> futures;
+    std::vector<UniqueTask> tasks;
+    if constexpr (std::ranges::sized_range<Range>)
+    {
+        futures.reserve(std::ranges::size(range));
+        tasks.reserve(std::ranges::size(range));
+    }
+
+    for (auto&& element : range)
+    {
+        std::packaged_task<ResultType()> packaged_task(
+            [fn, element = Element(element)]() mutable { return fn(element); });
+        futures.push_back(packaged_task.get_future());
+        tasks.emplace_back(std::move(packaged_task));
+    }
+
+    enqueue_bulk(tasks, priority);
+    return futures;
+}
 
+template <typename Future>
+void ThreadPool::wait(const Future& future)
+{
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
     {
-        std::lock_guard<std::mutex> lock(queue_mutex);
-        task_queue.emplace([packaged_task]()
+        // Nothing left that the current task queued (or not a worker):
+        // no new local work can appear while we block, so just wait.
+        if (!try_help())
+        {
+            // A blocked worker is a thread lost to the pool: worth measuring
+            const uint64_t blocked_from = is_worker_thread() ? executor_stats.now_if_enabled() : 0;
+            future.wait();
+            if (blocked_from)
             {
-                std::invoke(*packaged_task);
-            });
+                const uint64_t blocked_to = ExecutorStats::now();
+                executor_stats.record(ExecutorMetric::BlockedWait, blocked_to - blocked_from);
+                executor_stats.trace_span("blocked_wait", blocked_from, blocked_to);
+            }
+            return;
+        }
     }
-    cv.notify_one();
-    return future;
 }
 
-#endif // THREAD_POOL_HPP
+template <typename Future>
+decltype(auto) ThreadPool::get(Future&& future)
+{
+    wait(future);
+    return future.get();
+}
+
+template <typename Index, typename Func>
+struct ThreadPool::ParallelForState
+{
+    Index begin;
+    size_t count;
+    size_t grain;
+    size_t parts;
+    Func* fn;
+
+    std::atomic<size_t> next{ 0 };
+    std::atomic<size_t> done{ 0 };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+
+    // Claim and run chunks until the range is exhausted
+    void run()
+    {
+        size_t first = next.load(std::memory_order_relaxed);
+        while (first < count)
+        {
+            const size_t remaining = count - first;
+            const size_t chunk = std::min(remaining, std::max(grain, remaining / (2 * parts)));
+            if (!next.compare_exchange_weak(first, first + chunk, std::memory_order_relaxed))
+                continue;
+
+            try
+            {
+                const Index lo = static_cast<Index>(begin + static_cast<Index>(first));
+                const Index hi = static_cast<Index>(begin + static_cast<Index>(first + chunk));
+                if constexpr (std::is_invocable_v<Func&, Index, Index>)
+                    (*fn)(lo, hi);
+                else
+                    for (Index i = lo; i != hi; ++i) (*fn)(i);
+            }
+            catch (...)
+            {
+                fail(std::current_exception());
+            }
+            complete(chunk);
+            first = next.load(std::memory_order_relaxed);
+        }
+    }
+
+    void fail(std::exception_ptr e)
+    {
+        if (failed.exchange(true)) return;
+        error = e;
+
+        // Give up on everything not yet claimed
+        const size_t unclaimed_from = next.exchange(count);
+        if (unclaimed_from < count)
+            complete(count - unclaimed_from);
+    }
+
+    void complete(size_t n)
+    {
+        if (done.fetch_add(n, std::memory_order_acq_rel) + n == count)
+            done.notify_all();
+    }
+
+    void wait()
+    {
+        size_t d = done.load(std::memory_order_acquire);
+        while (d < count)
+        {
+            done.wait(d, std::memory_order_acquire);
+            d = done.load(std::memory_order_acquire);
+        }
+    }
+};
+
+template <typename Index, typename Func>
+void ThreadPool::parallel_for(
+    Index begin,
+    std::type_identity_t<Index> end,
+    size_t grain,
+    Func&& fn,
+    TaskPriority priority)
+{
+    static_assert(std::is_integral_v<Index>, "parallel_for requires an integral index type");
+
+    if (!(begin < end)) return;
+    const size_t count = static_cast<size_t>(end - begin);
+
+    // The calling thread takes part unless it already occupies one of our workers
+    const size_t max_parts = thread_count + (is_worker_thread() ? 0 : 1);
+    if (grain == 0)
+        grain = std::max<size_t>(1, count / (max_parts * 8));
+    const size_t parts = std::min(max_parts, (count + grain - 1) / grain);
+
+    using Body = std::remove_reference_t<Func>;
+    if (parts <= 1)
+    {
+        if constexpr (std::is_invocable_v<Body&, Index, Index>)
+            fn(begin, end);
+        else
+            for (Index i = begin; i != end; ++i) fn(i);
+        return;
+    }
+
+    // Shared, since helpers may start after the loop is done (they then find nothing to claim)
+    auto state = std::make_shared<ParallelForState<Index, Body>>();
+    state->begin = begin;
+    state->count = count;
+    state->grain = grain;
+    state->parts = parts;
+    state->fn = &fn;
+
+    for (size_t i = 1; i < parts; ++i)
+        post([state]() { state->run(); }, priority);
+
+    state->run();
+    state->wait();
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
+
+#endif // THREADPOOL_HPP
@@ -0,0 +1,160 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef UNIQUETASK_HPP
+#define UNIQUETASK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// Move-only, type-erased `void()` callable with inline storage.
+///
+/// Callables of up to `inline_size` bytes that are nothrow move-constructible
+/// are stored in the object itself, so wrapping a typical lambda (a handful of
+/// captured pointers, a shared_ptr, a std::promise or std::packaged_task)
+/// does not allocate. Larger callables are moved to the heap. Unlike
+/// std::function the target need not be copyable.
+class UniqueTask
+{
+public:
+    static constexpr size_t inline_size = 64;
+
+    /// True if a callable of type F is stored without a heap allocation
+    template <typename F>
+    static constexpr bool stores_inline()
+    {
+        using Fn = std::decay_t<F>;
+        return sizeof(Fn) <= inline_size
+            && alignof(Fn) <= alignof(std::max_align_t)
+            && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    UniqueTask() noexcept = default;
+    UniqueTask(std::nullptr_t) noexcept {}
+
+    template <typename F,
+        typename Fn = std::decay_t<F>,
+        typename = std::enable_if_t<!std::is_same_v<Fn, UniqueTask> && std::is_invocable_v<Fn&>>>
+    UniqueTask(F&& fn)
+    {
+        // (A function reference, decaying to a pointer, is never null)
+        if constexpr ((std::is_pointer_v<Fn> && !std::is_function_v<std::remove_reference_t<F>>)
+            || std::is_member_pointer_v<Fn> || is_std_function<Fn>::value)
+        {
+            if (!fn) return; // Empty target: stay empty
+        }
+
+        if constexpr (stores_inline<Fn>())
+        {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+            vtable_ = &inline_vtable<Fn>;
+        }
+        else
+        {
+            ::new (static_cast<void*>(storage_)) Fn* (new Fn(std::forward<F>(fn)));
+            vtable_ = &heap_vtable<Fn>;
+        }
+    }
+
+    UniqueTask(UniqueTask&& other) noexcept
+    {
+        move_from(other);
+    }
+
+    UniqueTask& operator=(UniqueTask&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    UniqueTask& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    UniqueTask(const UniqueTask&) = delete;
+    UniqueTask& operator=(const UniqueTask&) = delete;
+
+    ~UniqueTask()
+    {
+        reset();
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return vtable_ != nullptr;
+    }
+
+    /// @throws std::bad_function_call if empty
+    void operator()()
+    {
+        if (!vtable_) throw std::bad_function_call();
+        vtable_->invoke(storage_);
+    }
+
+    void reset() noexcept
+    {
+        if (vtable_)
+        {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+private:
+    struct VTable
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept; // Move-construct dst from src, then destroy src
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename T> struct is_std_function : std::false_type {};
+    template <typename R, typename... Args> struct is_std_function<std::function<R(Args...)>> : std::true_type {};
+
+    template <typename Fn>
+    static Fn* target(void* storage) noexcept
+    {
+        return std::launder(reinterpret_cast<Fn*>(storage));
+    }
+
+    template <typename Fn>
+    static constexpr VTable inline_vtable{
+        [](void* s) { std::invoke(*target<Fn>(s)); },
+        [](void* dst, void* src) noexcept
+        {
+            ::new (dst) Fn(std::move(*target<Fn>(src)));
+            target<Fn>(src)->~Fn();
+        },
+        [](void* s) noexcept { target<Fn>(s)->~Fn(); }
+    };
+
+    template <typename Fn>
+    static constexpr VTable heap_vtable{
+        [](void* s) { std::invoke(**target<Fn*>(s)); },
+        [](void* dst, void* src) noexcept { ::new (dst) Fn* (*target<Fn*>(src)); },
+        [](void* s) noexcept { delete *target<Fn*>(s); }
+    };
+
+    void move_from(UniqueTask& other) noexcept
+    {
+        if (other.vtable_)
+        {
+            other.vtable_->move(storage_, other.storage_);
+            vtable_ = other.vtable_;
+            other.vtable_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) std::byte storage_[inline_size];
+    const VTable* vtable_ = nullptr;
+};
+
+#endif // UNIQUETASK_HPP
@@ -0,0 +1,183 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef WORKSTEALINGDEQUE_HPP
+#define WORKSTEALINGDEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <type_traits>
+
+/// Lock-free single-owner, multi-thief deque (Chase-Lev).
+///
+/// The owning thread pushes and pops at the bottom (LIFO); any other thread
+/// may steal from the top (FIFO). Elements must be trivially copyable, in
+/// practice a pointer to a heap- or pool-allocated task.
+///
+/// Based on Le, Pop, Cohen & Zappa Nardelli, "Correct and Efficient
+/// Work-Stealing for Weak Memory Models", PPoPP 2013.
+///
+/// @note Ring buffers replaced during growth are retained until destruction,
+///       since a concurrent thief may still be reading from them.
+template<class T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires trivially copyable elements");
+
+    struct Ring
+    {
+        const int64_t capacity;
+        const int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Ring(int64_t capacity)
+            : capacity(capacity)
+            , mask(capacity - 1)
+            , slots(std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)))
+        {
+        }
+
+        void put(int64_t i, T value) noexcept
+        {
+            slots[i & mask].store(value, std::memory_order_relaxed);
+        }
+
+        T get(int64_t i) const noexcept
+        {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+    };
+
+public:
+    explicit WorkStealingDeque(int64_t initial_capacity = 256)
+    {
+        int64_t capacity = 1;
+        while (capacity < initial_capacity) capacity <<= 1;
+
+        rings_.push_back(std::make_unique<Ring>(capacity));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// Push at the bottom. Owner thread only.
+    void push(T value)
+    {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+
+        if (b - t > ring->capacity - 1)
+            ring = grow(ring, t, b);
+
+        ring->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /// Pop from the bottom. Owner thread only.
+    /// @return True and sets `out` if an element was taken
+    bool pop(T& out)
+    {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // Empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = ring->get(b);
+        if (t == b)
+        {
+            // Last element: race against thieves for it
+            const bool won = top_.compare_exchange_strong(
+                t, t + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// Pop from the bottom, but only elements at index `floor` or above.
+    /// Owner thread only. Lets the owner take back work it pushed after a
+    /// given point (see bottom_index()) without touching older elements.
+    bool pop_above(int64_t floor, T& out)
+    {
+        if (bottom_.load(std::memory_order_relaxed) <= floor) return false;
+        return pop(out);
+    }
+
+    /// Current bottom index. Owner thread only.
+    int64_t bottom_index() const noexcept
+    {
+        return bottom_.load(std::memory_order_relaxed);
+    }
+
+    /// Steal from the top. Any thread.
+    /// @return True and sets `out` if an element was taken
+    bool steal(T& out)
+    {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) return false;
+
+        Ring* ring = ring_.load(std::memory_order_acquire);
+        T value = ring->get(t);
+        if (!top_.compare_exchange_strong(
+            t, t + 1,
+            std::memory_order_seq_cst,
+            std::memory_order_relaxed))
+        {
+            // Lost the race to another thief or the owner
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    /// Approximate number of elements (exact when called by the owner with no thieves active)
+    size_t size() const noexcept
+    {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+private:
+    Ring* grow(Ring* ring, int64_t t, int64_t b)
+    {
+        auto bigger = std::make_unique<Ring>(ring->capacity * 2);
+        for (int64_t i = t; i < b; ++i)
+            bigger->put(i, ring->get(i));
+
+        Ring* raw = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{ 0 };
+    alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    alignas(64) std::atomic<Ring*> ring_{ nullptr };
+
+    std::vector<std::unique_ptr<Ring>> rings_; // Owner-only; keeps retired rings alive
+};
+
+#endif // WORKSTEALINGDEQUE_HPP
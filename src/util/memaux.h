@@ -4,9 +4,36 @@
 #ifndef memaux_h
 #define memaux_h
 
+#include <cstdint>
+
 // std::max_align_t is the maximum alignment required for any type in the C++ standard library.
 #define PoolMinAlignment 4 // alignof(std::max_align_t)
 
+// How a pool allocator grows when its free-list runs out
+// * Relocate: one contiguous buffer, doubled on growth. Every live element is
+//             moved, so growth is O(N) and invalidates references.
+// * Chunked:  fixed-size chunks that are never moved. Growth is O(chunk) and
+//             references stay valid until the element is destroyed.
+enum class PoolGrowth
+{
+    Relocate,
+    Chunked
+};
+
+// Elements per chunk in PoolGrowth::Chunked mode, unless specified
+inline constexpr size_t PoolDefaultChunkElements = 256;
+
+// An element moved by a pool allocator's compact(), as slot indices
+struct PoolMove
+{
+    size_t from;
+    size_t to;
+    // Slot generations of the element's handle before and after the move
+    // (Chunked PoolAllocatorTFH, 0 otherwise)
+    uint32_t from_ver = 0;
+    uint32_t to_ver = 0;
+};
+
 inline void aligned_alloc(void** ptr,
                           size_t size,
                           size_t alignment)
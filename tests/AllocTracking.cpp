@@ -0,0 +1,50 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include "AllocTracking.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+    // The size of each block is stored in front of it; this keeps the returned
+    // pointer aligned for any fundamental type
+    constexpr std::size_t header_size = alignof(std::max_align_t);
+
+    thread_local size_t tls_allocations = 0;
+    thread_local int64_t tls_live_bytes = 0;
+    thread_local int64_t tls_peak_bytes = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    ++tls_allocations;
+    auto* block = static_cast<unsigned char*>(std::malloc(size + header_size));
+    if (!block) throw std::bad_alloc();
+    std::memcpy(block, &size, sizeof(size));
+
+    tls_live_bytes += static_cast<int64_t>(size);
+    tls_peak_bytes = std::max(tls_peak_bytes, tls_live_bytes);
+    return block + header_size;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (!p) return;
+    auto* block = static_cast<unsigned char*>(p) - header_size;
+    std::size_t size;
+    std::memcpy(&size, block, sizeof(size));
+    tls_live_bytes -= static_cast<int64_t>(size);
+    std::free(block);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+namespace alloc_tracking
+{
+    size_t allocations() { return tls_allocations; }
+    int64_t live_bytes() { return tls_live_bytes; }
+    int64_t peak_bytes() { return tls_peak_bytes; }
+    void reset_peak() { tls_peak_bytes = tls_live_bytes; }
+}
@@ -0,0 +1,27 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#ifndef ALLOCTRACKING_HPP
+#define ALLOCTRACKING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap counters for the calling thread, kept by the global operator new/delete
+// replacements in AllocTracking.cpp. Replacing the global operators affects the
+// whole test binary, but only adds a few thread-local updates per call.
+namespace alloc_tracking
+{
+    // Allocations made so far
+    size_t allocations();
+
+    // Bytes allocated minus bytes freed. Memory freed by another thread than
+    // the one that allocated it is counted against the freeing thread.
+    int64_t live_bytes();
+
+    // Highest live_bytes() since the last reset_peak()
+    int64_t peak_bytes();
+
+    void reset_peak();
+}
+
+#endif // ALLOCTRACKING_HPP
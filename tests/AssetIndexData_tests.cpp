@@ -0,0 +1,86 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AssetIndexData.hpp"
+
+using namespace eeng;
+
+namespace {
+
+    AssetIndexData make_index(size_t count)
+    {
+        AssetIndexData data;
+        data.entries.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            AssetMetaData meta{ Guid::generate(), Guid::invalid(), "asset_" + std::to_string(i), "eeng.assets.ModelDataAsset" };
+            const std::string file = "models/model_" + std::to_string(i) + ".json";
+            data.entries.push_back(AssetEntry{ std::move(meta), file, "/content/" + file });
+        }
+        data.build_maps();
+        return data;
+    }
+
+} // namespace
+
+TEST(AssetIndexData, FindByGuid)
+{
+    const auto data = make_index(100);
+    for (const auto& entry : data.entries)
+        EXPECT_EQ(data.find(entry.meta.guid), &entry);
+    EXPECT_EQ(data.find(Guid::generate()), nullptr);
+
+    ASSERT_EQ(data.by_type.size(), 1u);
+    EXPECT_EQ(data.by_type.at("eeng.assets.ModelDataAsset").size(), 100u);
+}
+
+// Entry lookup per asset load in a 50k-entry index: copy of the entry table
+// and a linear search (the former load path) vs the by_guid map
+TEST(AssetIndexDataBenchmark, DISABLED_GuidLookup50k)
+{
+    constexpr size_t N = 50'000;
+    const auto data = make_index(N);
+
+    std::vector<Guid> lookups;
+    for (const auto& entry : data.entries) lookups.push_back(entry.meta.guid);
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(1));
+
+    auto us_per = [](auto t0, size_t n) {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / n;
+        };
+
+    constexpr size_t CopyLookups = 20;
+    size_t found = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < CopyLookups; ++i)
+    {
+        auto entries = data.entries;
+        auto it = std::find_if(entries.begin(), entries.end(), [&](const AssetEntry& entry)
+            {
+                return entry.meta.guid == lookups[i];
+            });
+        found += it != entries.end();
+    }
+    const double copy_us = us_per(t0, CopyLookups);
+    EXPECT_EQ(found, CopyLookups);
+
+    found = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (const auto& guid : lookups)
+        found += data.find(guid) != nullptr;
+    const double map_us = us_per(t0, N);
+    EXPECT_EQ(found, N);
+
+    std::cout << "[AssetIndexDataBenchmark] " << N << " entries, us per lookup\n"
+        << std::fixed << std::setprecision(3)
+        << "  copy + linear search : " << copy_us << "\n"
+        << "  by_guid              : " << map_us << "\n"
+        << "  loading all " << N << " assets: " << copy_us * N / 1e6 << " s vs " << map_us * N / 1e6 << " s\n";
+}
@@ -0,0 +1,322 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "entt/entt.hpp"
+#include "MetaInfo.h"
+#include "MetaAux.h"
+#include "MetaSerialize.hpp"
+#include "AssetIndex.hpp"
+
+using namespace eeng;
+
+namespace {
+
+    class NullLogManager : public ILogManager
+    {
+    public:
+        void log(const char*, ...) override {}
+        void clear() override {}
+    };
+
+    // Only the fields the tests check; the engine registers the full type in AssetMetaReg
+    void register_asset_meta_data()
+    {
+        static bool registered = false;
+        if (registered)
+            return;
+        registered = true;
+
+        entt::meta_factory<AssetMetaData>()
+            .custom<TypeMetaInfo>(TypeMetaInfo{ .id = "eeng.AssetMetaData", .name = "AssetMetaData", .tooltip = "" })
+            .data<&AssetMetaData::name>("name"_hs)
+            .custom<DataMetaInfo>(DataMetaInfo{ "name", "Name", "" })
+            .data<&AssetMetaData::type_id>("type_id"_hs)
+            .custom<DataMetaInfo>(DataMetaInfo{ "type_id", "Type ID", "" })
+            ;
+        meta::register_type<AssetMetaData>();
+    }
+
+    // Records the format strings logged
+    class RecordingLogManager : public ILogManager
+    {
+    public:
+        std::vector<std::string> formats;
+        void log(const char* format, ...) override { formats.push_back(format); }
+        void clear() override { formats.clear(); }
+    };
+
+    // Asset type with a cook hook that, like the real ones, throws if the cooked file can't be written
+    struct CookedTestAsset
+    {
+        std::string name;
+    };
+
+    void cook_CookedTestAsset(const entt::meta_any&, const std::filesystem::path& path, const std::filesystem::path&)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            throw std::runtime_error("Failed to open cooked file for writing: " + path.string());
+        out << "cooked";
+    }
+
+    void register_cooked_test_asset()
+    {
+        static bool registered = false;
+        if (registered)
+            return;
+        registered = true;
+
+        entt::meta_factory<CookedTestAsset>()
+            .custom<TypeMetaInfo>(TypeMetaInfo{ .id = "test.CookedTestAsset", .name = "CookedTestAsset", .tooltip = "" })
+            .data<&CookedTestAsset::name>("name"_hs)
+            .custom<DataMetaInfo>(DataMetaInfo{ "name", "Name", "" })
+            .func<&cook_CookedTestAsset>(literals::cook_hs)
+            ;
+        meta::register_type<CookedTestAsset>();
+    }
+
+    class AssetIndexScanCache : public ::testing::Test
+    {
+    protected:
+        const std::filesystem::path root = std::filesystem::temp_directory_path() / "eeng_scan_cache_test";
+        const std::filesystem::path cache_file = std::filesystem::temp_directory_path() / "eeng_scan_cache_test.json";
+        EngineContext ctx{ nullptr, nullptr, nullptr, nullptr, nullptr, std::make_shared<NullLogManager>() };
+
+        void SetUp() override
+        {
+            register_asset_meta_data();
+            TearDown();
+            std::filesystem::create_directories(root / "sub");
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(root);
+            std::filesystem::remove(cache_file);
+            std::filesystem::remove(AssetIndex::default_scan_cache_path(root));
+        }
+
+        std::filesystem::path meta_path(const std::string& file) const
+        {
+            return root / (file + ".meta.json");
+        }
+
+        void write_meta(const std::string& file, const std::string& name)
+        {
+            const AssetMetaData meta{ Guid::generate(), Guid::invalid(), name, "test.ScanAsset" };
+            std::ofstream(meta_path(file)) << meta::serialize_any(entt::forward_as_meta(meta), meta::SerializationPurpose::file).dump();
+        }
+
+        // Scan with an index, returning the asset names found
+        std::vector<std::string> scan(AssetIndex& index)
+        {
+            std::vector<std::string> names;
+            for (const auto& entry : index.scan_assets(root, ctx)->entries)
+                names.push_back(entry.meta.name);
+            std::sort(names.begin(), names.end());
+            return names;
+        }
+    };
+
+    void expect_stats(const AssetIndex& index, size_t meta_files, size_t parsed, size_t cached)
+    {
+        const auto stats = index.last_scan_stats();
+        EXPECT_EQ(stats.meta_files, meta_files);
+        EXPECT_EQ(stats.parsed, parsed);
+        EXPECT_EQ(stats.cached, cached);
+    }
+
+    using Names = std::vector<std::string>;
+
+} // namespace
+
+TEST_F(AssetIndexScanCache, UnchangedFilesAreCached)
+{
+    write_meta("a", "A");
+    write_meta("sub/b", "B");
+    write_meta("sub/c", "C");
+
+    AssetIndex index;
+    index.set_scan_cache_path(cache_file);
+    EXPECT_EQ(scan(index), (Names{ "A", "B", "C" }));
+    expect_stats(index, 3, 3, 0);
+
+    EXPECT_EQ(scan(index), (Names{ "A", "B", "C" }));
+    expect_stats(index, 3, 0, 3);
+}
+
+TEST_F(AssetIndexScanCache, SizeOrWriteTimeChangeIsParsed)
+{
+    write_meta("a", "A");
+    write_meta("b", "B");
+    write_meta("c", "C");
+
+    AssetIndex index;
+    index.set_scan_cache_path(cache_file);
+    scan(index);
+
+    // Same content, newer write time
+    std::filesystem::last_write_time(meta_path("b"), std::filesystem::last_write_time(meta_path("b")) + std::chrono::hours(1));
+    EXPECT_EQ(scan(index), (Names{ "A", "B", "C" }));
+    expect_stats(index, 3, 1, 2);
+
+    // New content of another size, with the old write time restored
+    const auto time = std::filesystem::last_write_time(meta_path("c"));
+    write_meta("c", "C renamed");
+    std::filesystem::last_write_time(meta_path("c"), time);
+    EXPECT_EQ(scan(index), (Names{ "A", "B", "C renamed" }));
+    expect_stats(index, 3, 1, 2);
+}
+
+TEST_F(AssetIndexScanCache, PersistsAcrossInstances)
+{
+    write_meta("a", "A");
+    write_meta("sub/b", "B");
+    {
+        AssetIndex index;
+        index.set_scan_cache_path(cache_file);
+        scan(index);
+        expect_stats(index, 2, 2, 0);
+    }
+    ASSERT_TRUE(std::filesystem::exists(cache_file));
+
+    AssetIndex index;
+    index.set_scan_cache_path(cache_file);
+    EXPECT_EQ(scan(index), (Names{ "A", "B" }));
+    expect_stats(index, 2, 0, 2);
+}
+
+TEST_F(AssetIndexScanCache, DefaultCacheIsOutsideTheContentTree)
+{
+    write_meta("a", "A");
+    {
+        AssetIndex index;
+        scan(index);
+    }
+
+    // Nothing but the meta file is written to the scanned root
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
+        files += entry.is_regular_file();
+    EXPECT_EQ(files, 1u);
+
+    const auto default_cache = AssetIndex::default_scan_cache_path(root);
+    EXPECT_TRUE(std::filesystem::exists(default_cache));
+    EXPECT_FALSE(std::filesystem::exists(std::filesystem::path{ default_cache } += ".tmp"));
+    EXPECT_TRUE(default_cache.lexically_relative(root).string().starts_with(".."));
+
+    AssetIndex index;
+    EXPECT_EQ(scan(index), (Names{ "A" }));
+    expect_stats(index, 1, 0, 1);
+}
+
+TEST_F(AssetIndexScanCache, DamagedCacheIsIgnored)
+{
+    write_meta("a", "A");
+    write_meta("b", "B");
+    {
+        AssetIndex index;
+        index.set_scan_cache_path(cache_file);
+        scan(index);
+    }
+    std::ofstream(cache_file) << "{ \"version\": 1, \"entries\": { \"a.meta.json\": ";
+
+    {
+        AssetIndex index;
+        index.set_scan_cache_path(cache_file);
+        EXPECT_EQ(scan(index), (Names{ "A", "B" }));
+        expect_stats(index, 2, 2, 0);
+    }
+
+    // The full parse rewrote the cache
+    AssetIndex index;
+    index.set_scan_cache_path(cache_file);
+    scan(index);
+    expect_stats(index, 2, 0, 2);
+}
+
+TEST_F(AssetIndexScanCache, OtherVersionCacheIsIgnored)
+{
+    write_meta("a", "A");
+    write_meta("b", "B");
+    {
+        AssetIndex index;
+        index.set_scan_cache_path(cache_file);
+        scan(index);
+    }
+
+    // Valid entries under another version number
+    nlohmann::json json;
+    std::ifstream(cache_file) >> json;
+    json["version"] = json.at("version").get<int>() + 1;
+    std::ofstream(cache_file) << json.dump();
+
+    AssetIndex index;
+    index.set_scan_cache_path(cache_file);
+    EXPECT_EQ(scan(index), (Names{ "A", "B" }));
+    expect_stats(index, 2, 2, 0);
+}
+
+TEST_F(AssetIndexScanCache, DeletedFilesAreRemoved)
+{
+    write_meta("a", "A");
+    write_meta("sub/b", "B");
+    write_meta("sub/c", "C");
+
+    AssetIndex index;
+    index.set_scan_cache_path(cache_file);
+    scan(index);
+
+    std::filesystem::remove(meta_path("sub/b"));
+    EXPECT_EQ(scan(index), (Names{ "A", "C" }));
+    expect_stats(index, 2, 0, 2);
+
+    // Also from the persisted cache
+    nlohmann::json json;
+    std::ifstream(cache_file) >> json;
+    EXPECT_EQ(json.at("entries").size(), 2u);
+    EXPECT_FALSE(json.at("entries").contains("sub/b.meta.json"));
+
+    AssetIndex reloaded;
+    reloaded.set_scan_cache_path(cache_file);
+    EXPECT_EQ(scan(reloaded), (Names{ "A", "C" }));
+    expect_stats(reloaded, 2, 0, 2);
+}
+
+TEST(AssetIndexSerialize, CookFailureStillWritesMeta)
+{
+    register_asset_meta_data();
+    register_cooked_test_asset();
+
+    const auto dir = std::filesystem::temp_directory_path() / "eeng_cook_failure_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    const auto asset_path = dir / "asset.json";
+    const auto meta_path = dir / "asset.meta.json";
+
+    // A directory in place of the cooked file, which can't be opened for writing
+    std::filesystem::create_directory(AssetIndex::cooked_path(asset_path));
+
+    auto log = std::make_shared<RecordingLogManager>();
+    EngineContext ctx{ nullptr, nullptr, nullptr, nullptr, nullptr, log };
+    const AssetMetaData meta{ Guid::generate(), Guid::invalid(), "Cooked", "test.CookedTestAsset" };
+
+    AssetIndex index;
+    EXPECT_NO_THROW(index.serialize_to_file(CookedTestAsset{ "asset" }, meta, asset_path, meta_path, ctx));
+
+    EXPECT_TRUE(std::filesystem::exists(asset_path));
+    EXPECT_TRUE(std::filesystem::exists(meta_path));
+    ASSERT_EQ(log->formats.size(), 1u);
+    EXPECT_TRUE(log->formats[0].starts_with("[WARN]"));
+
+    std::filesystem::remove_all(dir);
+}
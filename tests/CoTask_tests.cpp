@@ -0,0 +1,312 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "CoTask.hpp"
+#include "AsyncMutex.hpp"
+#include "ThreadPool.hpp"
+#include "SerialExecutor.hpp"
+#include "MainThreadQueue.hpp"
+
+namespace {
+
+    CoTask<int> add(int a, int b)
+    {
+        co_return a + b;
+    }
+
+    CoTask<int> sum_on(IExecutor& executor, int n)
+    {
+        co_await executor.schedule();
+        int total = 0;
+        for (int i = 1; i <= n; ++i)
+            total += co_await add(i, 0);
+        co_return total;
+    }
+
+    CoTask<void> fail_on(IExecutor& executor)
+    {
+        co_await executor.schedule();
+        throw std::runtime_error("boom");
+    }
+
+    // Pump the main thread queue until the future is ready
+    template <typename Future>
+    void pump_until_ready(MainThreadQueue& mtq, const Future& future)
+    {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            mtq.execute_all();
+            std::this_thread::yield();
+        }
+    }
+
+} // namespace
+
+TEST(CoTask, IsLazyAndReturnsValues)
+{
+    bool started = false;
+    auto make = [&]() -> CoTask<int>
+        {
+            started = true;
+            co_return 5;
+        };
+
+    CoTask<int> task = make();
+    EXPECT_FALSE(started);
+    EXPECT_EQ(spawn(std::move(task)).get(), 5);
+    EXPECT_TRUE(started);
+}
+
+TEST(CoTask, ResumesOnThreadPool)
+{
+    ThreadPool pool(2);
+    auto outer = [&]() -> CoTask<bool>
+        {
+            co_await pool.schedule(TaskPriority::FrameCritical);
+            co_return pool.is_worker_thread();
+        };
+    EXPECT_TRUE(spawn(outer()).get());
+    EXPECT_EQ(spawn(sum_on(pool, 100)).get(), 5050);
+}
+
+TEST(CoTask, ExceptionsReachTheAwaiter)
+{
+    ThreadPool pool(2);
+    auto outer = [&]() -> CoTask<int>
+        {
+            try
+            {
+                co_await fail_on(pool);
+            }
+            catch (const std::runtime_error&)
+            {
+                co_return 1;
+            }
+            co_return 0;
+        };
+    EXPECT_EQ(spawn(outer()).get(), 1);
+
+    auto future = spawn(fail_on(pool));
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(CoTask, SerialExecutorKeepsStrandOrder)
+{
+    ThreadPool pool(4);
+    eeng::SerialExecutor strand(pool);
+
+    // Coroutines that hop onto the strand never run their strand segments concurrently
+    std::atomic<int> inside{ 0 };
+    std::atomic<bool> overlapped{ false };
+    auto segment = [&]() -> CoTask<void>
+        {
+            for (int i = 0; i < 10; ++i)
+            {
+                co_await strand.schedule();
+                if (inside.fetch_add(1) != 0) overlapped = true;
+                std::this_thread::yield();
+                inside.fetch_sub(1);
+                co_await pool.schedule();
+            }
+        };
+
+    std::vector<std::shared_future<void>> futures;
+    for (int i = 0; i < 8; ++i)
+        futures.push_back(spawn(segment()));
+    for (auto& f : futures) f.get();
+    strand.wait_idle();
+
+    EXPECT_FALSE(overlapped.load());
+}
+
+TEST(CoTask, HopsBetweenWorkersAndMainThread)
+{
+    ThreadPool pool(2);
+    MainThreadQueue mtq;
+    const auto main_id = std::this_thread::get_id();
+
+    auto pipeline = [&]() -> CoTask<int>
+        {
+            int hops = 0;
+            for (int i = 0; i < 5; ++i)
+            {
+                co_await pool.schedule();
+                if (std::this_thread::get_id() != main_id) ++hops;
+                co_await mtq.schedule();
+                if (std::this_thread::get_id() == main_id) ++hops;
+            }
+            co_return hops;
+        };
+
+    auto future = spawn(pipeline());
+    pump_until_ready(mtq, future);
+    EXPECT_EQ(future.get(), 10);
+
+    // Already on the main thread: no suspension, no queued task
+    auto inline_hop = [&]() -> CoTask<bool>
+        {
+            co_await mtq.schedule();
+            co_return true;
+        };
+    EXPECT_TRUE(spawn(inline_hop()).get());
+    EXPECT_TRUE(mtq.empty());
+}
+
+// yield() requeues even on the main thread, one step per execute call
+TEST(CoTask, YieldSplitsMainThreadWork)
+{
+    MainThreadQueue mtq;
+    int steps = 0;
+
+    auto chunks = [&]() -> CoTask<int>
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                if (i > 0)
+                    co_await mtq.yield();
+                ++steps;
+            }
+            co_return steps;
+        };
+
+    auto future = spawn(chunks());
+    EXPECT_EQ(steps, 1);
+    EXPECT_EQ(mtq.execute_all(), 1u);
+    EXPECT_EQ(steps, 2);
+    EXPECT_EQ(mtq.execute_all(), 1u);
+    EXPECT_EQ(future.get(), 3);
+    EXPECT_TRUE(mtq.empty());
+}
+
+// Many pipelines waiting on each other do not need a thread each
+TEST(CoTask, WaitingHoldsNoThread)
+{
+    ThreadPool pool(1);
+    constexpr int N = 64;
+
+    auto gate = std::make_shared<std::atomic<bool>>(false);
+    auto waiter = [&](int i) -> CoTask<int>
+        {
+            // Re-post until the gate opens; each wait is a queued continuation, not a blocked worker
+            while (!gate->load())
+                co_await pool.schedule(TaskPriority::Background);
+            co_return i;
+        };
+
+    std::vector<std::shared_future<int>> futures;
+    for (int i = 0; i < N; ++i)
+        futures.push_back(spawn(waiter(i)));
+
+    // The single worker is still free for other work
+    auto probe = pool.queue_task([]() { return 42; });
+    EXPECT_EQ(probe.get(), 42);
+
+    gate->store(true);
+    int total = 0;
+    for (auto& f : futures) total += f.get();
+    EXPECT_EQ(total, N * (N - 1) / 2);
+}
+
+TEST(CoTask, WhenAllReturnsResultsInOrder)
+{
+    ThreadPool pool(4);
+    constexpr int N = 16;
+
+    // Finishing order varies; results follow task order
+    auto task = [&](int i) -> CoTask<int>
+        {
+            co_await pool.schedule();
+            std::this_thread::sleep_for(std::chrono::microseconds((N - i) * 100));
+            co_return i * i;
+        };
+
+    auto all = [&]() -> CoTask<std::vector<int>>
+        {
+            std::vector<CoTask<int>> tasks;
+            for (int i = 0; i < N; ++i)
+                tasks.push_back(task(i));
+            co_return co_await when_all(std::move(tasks));
+        };
+
+    const auto results = spawn(all()).get();
+    ASSERT_EQ(results.size(), size_t(N));
+    for (int i = 0; i < N; ++i)
+        EXPECT_EQ(results[i], i * i);
+
+    // No tasks: resumes at once
+    auto none = []() -> CoTask<size_t>
+        {
+            co_return (co_await when_all(std::vector<CoTask<int>>{})).size();
+        };
+    EXPECT_EQ(spawn(none()).get(), 0u);
+}
+
+TEST(CoTask, WhenAllRethrowsAfterAllFinish)
+{
+    ThreadPool pool(2);
+    std::atomic<int> finished{ 0 };
+    auto task = [&](bool fail) -> CoTask<int>
+        {
+            co_await pool.schedule();
+            finished.fetch_add(1);
+            if (fail) throw std::runtime_error("boom");
+            co_return 1;
+        };
+
+    auto all = [&]() -> CoTask<int>
+        {
+            std::vector<CoTask<int>> tasks;
+            for (int i = 0; i < 8; ++i)
+                tasks.push_back(task(i == 3));
+            co_await when_all(std::move(tasks));
+            co_return 0;
+        };
+
+    auto future = spawn(all());
+    EXPECT_THROW(future.get(), std::runtime_error);
+    EXPECT_EQ(finished.load(), 8);
+}
+
+TEST(AsyncMutex, KeepsSectionsExclusiveAcrossSuspensions)
+{
+    ThreadPool pool(4);
+    eeng::SerialExecutor strand(pool);
+    AsyncMutex gate;
+
+    // Each section hops off the strand midway; sections still never overlap
+    std::atomic<int> inside{ 0 };
+    std::atomic<bool> overlapped{ false };
+    std::vector<int> order;
+    auto section = [&](int i) -> CoTask<void>
+        {
+            auto lock = co_await gate.lock(strand);
+            if (inside.fetch_add(1) != 0) overlapped = true;
+            order.push_back(i);
+            co_await pool.schedule();
+            std::this_thread::yield();
+            co_await strand.schedule();
+            inside.fetch_sub(1);
+        };
+
+    std::vector<std::shared_future<void>> futures;
+    for (int i = 0; i < 16; ++i)
+        futures.push_back(spawn(section(i)));
+    for (auto& f : futures) f.get();
+    gate.wait_idle();
+    strand.wait_idle();
+
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_FALSE(gate.is_locked());
+
+    // Served in request order
+    ASSERT_EQ(order.size(), 16u);
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(order[i], i);
+}
@@ -0,0 +1,263 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+#include "ExecutorStats.hpp"
+#include "ThreadPool.hpp"
+#include "SerialExecutor.hpp"
+#include "MainThreadQueue.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+    void sleep_briefly()
+    {
+        std::this_thread::sleep_for(2ms);
+    }
+
+} // namespace
+
+TEST(ExecutorStats, HistogramBucketsAndPercentiles)
+{
+    EXPECT_EQ(Histogram::bucket_of(0), 0u);
+    EXPECT_EQ(Histogram::bucket_of(1), 0u);
+    EXPECT_EQ(Histogram::bucket_of(2), 1u);
+    EXPECT_EQ(Histogram::bucket_of(3), 1u);
+    EXPECT_EQ(Histogram::bucket_of(1024), 10u);
+    EXPECT_EQ(Histogram::bucket_of(~uint64_t(0)), Histogram::bucket_count - 1);
+
+    ExecutorStats stats("test");
+    stats.record(ExecutorMetric::RunTime, 5); // Ignored: never enabled
+    EXPECT_EQ(stats.histogram(ExecutorMetric::RunTime).count, 0u);
+
+    stats.enable(true);
+    for (uint64_t v = 1; v <= 100; ++v)
+        stats.record(ExecutorMetric::RunTime, v);
+    stats.record(ExecutorMetric::RunTime, 10000);
+
+    const Histogram h = stats.histogram(ExecutorMetric::RunTime);
+    EXPECT_EQ(h.count, 101u);
+    EXPECT_EQ(h.sum, 5050u + 10000u);
+    EXPECT_EQ(h.max, 10000u);
+    EXPECT_EQ(h.percentile(0.5), 63u);     // 51st sample lies in [32, 64)
+    EXPECT_EQ(h.percentile(1.0), 10000u);  // Capped at the max
+    EXPECT_EQ(stats.histogram(ExecutorMetric::QueueLatency).count, 0u);
+
+    stats.reset();
+    EXPECT_EQ(stats.histogram(ExecutorMetric::RunTime).count, 0u);
+}
+
+TEST(ExecutorStats, RecordsFromManyThreads)
+{
+    ExecutorStats stats("test");
+    stats.enable(true);
+
+    constexpr int Threads = 8;
+    constexpr int PerThread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; ++t)
+        threads.emplace_back([&]()
+            {
+                for (int i = 0; i < PerThread; ++i)
+                    stats.record(ExecutorMetric::QueueDepth, i);
+            });
+    for (auto& t : threads) t.join();
+
+    const Histogram h = stats.histogram(ExecutorMetric::QueueDepth);
+    EXPECT_EQ(h.count, uint64_t(Threads) * PerThread);
+    EXPECT_EQ(h.max, uint64_t(PerThread - 1));
+}
+
+TEST(ExecutorStats, JsonAndChromeTraceExport)
+{
+    ExecutorStats stats("exporter");
+    stats.enable(true);
+    stats.enable_trace(true);
+    stats.record(ExecutorMetric::QueueLatency, 1000);
+    stats.trace_span("task", 2000, 5000);
+    stats.trace_counter("queue_depth", 1000, 3);
+
+    const auto json = nlohmann::json::parse(stats.to_json());
+    EXPECT_EQ(json["name"], "exporter");
+    EXPECT_EQ(json["metrics"]["queue_latency_ns"]["count"], 1);
+    EXPECT_EQ(json["metrics"]["queue_latency_ns"]["max"], 1000);
+    EXPECT_EQ(json["metrics"]["blocked_wait_ns"]["count"], 0);
+
+    const auto trace = nlohmann::json::parse(stats.to_chrome_trace());
+    const auto& events = trace["traceEvents"];
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0]["ph"], "C"); // Sorted by timestamp
+    EXPECT_EQ(events[0]["args"]["value"], 3);
+    EXPECT_EQ(events[1]["name"], "task");
+    EXPECT_EQ(events[1]["ph"], "X");
+    EXPECT_DOUBLE_EQ(events[1]["ts"].get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ(events[1]["dur"].get<double>(), 3.0);
+    EXPECT_EQ(events[1]["cat"], "exporter");
+}
+
+TEST(ExecutorStats, TraceRingKeepsTheMostRecentEvents)
+{
+    ExecutorStats stats("ring");
+    stats.enable(true);
+    stats.enable_trace(true);
+    const uint64_t total = ExecutorStats::trace_capacity + 100;
+    for (uint64_t i = 0; i < total; ++i)
+        stats.trace_counter("n", i, i);
+
+    const auto events = nlohmann::json::parse(stats.to_chrome_trace())["traceEvents"];
+    ASSERT_EQ(events.size(), ExecutorStats::trace_capacity);
+    EXPECT_EQ(events.back()["args"]["value"], total - 1);
+    EXPECT_EQ(events.front()["args"]["value"], total - ExecutorStats::trace_capacity);
+}
+
+TEST(ExecutorStats, DisabledByDefault)
+{
+    ThreadPool pool(2);
+    pool.queue_task([]() {}).get();
+    EXPECT_FALSE(pool.instrumentation().enabled());
+    EXPECT_EQ(pool.instrumentation().histogram(ExecutorMetric::RunTime).count, 0u);
+    EXPECT_EQ(pool.instrumentation().to_chrome_trace(), "{\"traceEvents\":[]}");
+}
+
+TEST(ExecutorStats, ThreadPoolLatencyRunTimeAndDepth)
+{
+    ThreadPool pool(ThreadPoolConfig{ 2, "stats-pool" });
+    auto& stats = pool.instrumentation();
+    stats.enable(true);
+    stats.enable_trace(true);
+    EXPECT_EQ(stats.name(), "stats-pool");
+
+    constexpr int N = 20;
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < N; ++i)
+        futures.push_back(pool.queue_task(sleep_briefly));
+    for (auto& f : futures) f.get();
+    // The run time is recorded just after the task (and its future) completes
+    while (stats.histogram(ExecutorMetric::RunTime).count < uint64_t(N))
+        std::this_thread::yield();
+
+    const Histogram latency = stats.histogram(ExecutorMetric::QueueLatency);
+    const Histogram run = stats.histogram(ExecutorMetric::RunTime);
+    EXPECT_EQ(latency.count, uint64_t(N));
+    EXPECT_EQ(run.count, uint64_t(N));
+    EXPECT_GE(run.percentile(0.5), 1'000'000u); // Each task sleeps 2 ms
+    EXPECT_GE(latency.max, 1'000'000u);         // Later tasks queue behind earlier ones
+    EXPECT_EQ(stats.histogram(ExecutorMetric::QueueDepth).count, uint64_t(N));
+
+    size_t spans = 0;
+    const auto trace = nlohmann::json::parse(stats.to_chrome_trace());
+    for (const auto& e : trace["traceEvents"])
+        if (e["name"] == "task") ++spans;
+    EXPECT_EQ(spans, size_t(N));
+}
+
+// A worker that blocks in wait() on work it cannot help with is reported
+TEST(ExecutorStats, DetectsBlockedWaitOnWorker)
+{
+    ThreadPool pool(2);
+    auto& stats = pool.instrumentation();
+    stats.enable(true);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    auto blocked = pool.queue_task([&]()
+        {
+            // Not queued by this task, so there is nothing to help with
+            pool.wait(released);
+        });
+    std::this_thread::sleep_for(20ms);
+    release.set_value();
+    blocked.get();
+
+    const Histogram h = stats.histogram(ExecutorMetric::BlockedWait);
+    EXPECT_EQ(h.count, 1u);
+    EXPECT_GE(h.max, 10'000'000u);
+
+    // Waiting from a non-worker thread is not a lost worker
+    auto ready = pool.queue_task([]() { return 1; });
+    EXPECT_EQ(pool.get(ready), 1);
+    EXPECT_EQ(stats.histogram(ExecutorMetric::BlockedWait).count, 1u);
+}
+
+TEST(ExecutorStats, StrandHoldAndLatency)
+{
+    ThreadPool pool(2);
+    eeng::SerialExecutor strand(pool);
+    auto& stats = strand.instrumentation();
+    stats.enable(true);
+
+    constexpr int N = 5;
+    for (int i = 0; i < N; ++i)
+        strand.post(sleep_briefly);
+    strand.wait_idle();
+
+    EXPECT_EQ(stats.histogram(ExecutorMetric::QueueLatency).count, uint64_t(N));
+    EXPECT_EQ(stats.histogram(ExecutorMetric::RunTime).count, uint64_t(N));
+    EXPECT_EQ(stats.histogram(ExecutorMetric::QueueDepth).count, uint64_t(N));
+
+    // At least one drain, together holding a worker for every task
+    const Histogram hold = stats.histogram(ExecutorMetric::StrandHold);
+    EXPECT_GE(hold.count, 1u);
+    EXPECT_GE(hold.sum, uint64_t(N) * 1'000'000u);
+}
+
+TEST(ExecutorStats, MainThreadQueueLatency)
+{
+    MainThreadQueue mtq;
+    auto& stats = mtq.instrumentation();
+    stats.enable(true);
+
+    mtq.push([]() {});
+    mtq.push(sleep_briefly);
+    std::this_thread::sleep_for(5ms);
+    EXPECT_EQ(mtq.execute_all(), 2u);
+
+    const Histogram latency = stats.histogram(ExecutorMetric::QueueLatency);
+    EXPECT_EQ(latency.count, 2u);
+    EXPECT_GE(latency.max, 5'000'000u);
+    EXPECT_EQ(stats.histogram(ExecutorMetric::RunTime).count, 2u);
+    EXPECT_EQ(stats.histogram(ExecutorMetric::QueueDepth).max, 2u);
+}
+
+// Cost per task of the instrumentation hooks, off / histograms / histograms + trace
+TEST(ExecutorStatsBenchmark, DISABLED_HookOverhead)
+{
+    constexpr int N = 20000;
+    ThreadPool pool(2);
+    auto& stats = pool.instrumentation();
+
+    auto run = [&]()
+        {
+            std::atomic<int> counter{ 0 };
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < N; ++i)
+                pool.post([&counter]() { counter.fetch_add(1); });
+            while (counter.load() < N)
+                std::this_thread::yield();
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / N;
+        };
+
+    run(); // Warm-up
+    const double off = run();
+    stats.enable(true);
+    const double histograms = run();
+    stats.enable_trace(true);
+    const double traced = run();
+
+    std::cout << "[ExecutorStatsBenchmark] ns per posted task, " << N << " tasks\n"
+        << std::fixed << std::setprecision(1)
+        << "  disabled            : " << off << "\n"
+        << "  histograms          : " << histograms << "\n"
+        << "  histograms + trace  : " << traced << "\n";
+    EXPECT_EQ(stats.histogram(ExecutorMetric::RunTime).count, uint64_t(2 * N));
+}
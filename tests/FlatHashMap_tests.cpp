@@ -0,0 +1,134 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "FlatHashMap.h"
+#include "Guid.h"
+#include "Handle.h"
+
+using eeng::FlatHashMap;
+
+TEST(FlatHashMap, InsertFindErase)
+{
+    FlatHashMap<uint32_t, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), nullptr);
+    EXPECT_FALSE(map.erase(1));
+
+    EXPECT_TRUE(map.insert_or_assign(1, 10));
+    EXPECT_FALSE(map.insert_or_assign(1, 11)); // Replaced
+    map[2] = 20;
+    EXPECT_EQ(map[3], 0); // Inserted default
+    EXPECT_EQ(map.size(), 3u);
+    ASSERT_NE(map.find(1), nullptr);
+    EXPECT_EQ(*map.find(1), 11);
+    EXPECT_TRUE(map.contains(2));
+
+    EXPECT_TRUE(map.erase(2));
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_EQ(map.size(), 2u);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(1));
+    map[5] = 50; // Usable after clear
+    EXPECT_EQ(*map.find(5), 50);
+}
+
+// Sequential keys share probe runs: erasing in the middle of a run must keep
+// every later key reachable
+TEST(FlatHashMap, EraseKeepsProbeRunsIntact)
+{
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(7);
+
+    for (int round = 0; round < 20000; ++round)
+    {
+        const uint64_t key = rng() % 2000;
+        if (rng() % 3 == 0)
+            EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+        else
+        {
+            map[key] = key * 3;
+            reference[key] = key * 3;
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& [key, value] : reference)
+    {
+        ASSERT_NE(map.find(key), nullptr) << key;
+        EXPECT_EQ(*map.find(key), value);
+    }
+    size_t iterated = 0;
+    for (const auto& [key, value] : map)
+    {
+        EXPECT_EQ(reference.at(key), value);
+        ++iterated;
+    }
+    EXPECT_EQ(iterated, reference.size());
+}
+
+TEST(FlatHashMap, ReserveAvoidsRehash)
+{
+    FlatHashMap<eeng::Guid, eeng::Handle<int>> map;
+    map.reserve(1000);
+    const size_t capacity = map.capacity();
+    EXPECT_GE(capacity * 7, 1000u * 8);
+    for (uint32_t i = 0; i < 1000; ++i)
+        map[eeng::Guid::generate()] = eeng::Handle<int>{ i };
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_EQ(map.size(), 1000u);
+}
+
+// GUID -> handle at 1M entries: node-based std::unordered_map vs FlatHashMap
+TEST(FlatHashMapBenchmark, DISABLED_GuidToHandle1M)
+{
+    constexpr size_t N = 1'000'000;
+
+    std::vector<eeng::Guid> guids(N);
+    for (auto& g : guids) g = eeng::Guid::generate();
+    std::vector<eeng::Guid> lookups = guids;
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(1));
+
+    auto ms_since = [](auto t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        };
+
+    // Returns insert and lookup times in ms
+    auto run = [&](auto& map, auto&& contains) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < N; ++i)
+            map[guids[i]] = eeng::Handle<int>{ i };
+        const double insert_ms = ms_since(t0);
+
+        size_t found = 0;
+        t0 = std::chrono::steady_clock::now();
+        for (const auto& g : lookups)
+            found += contains(map, g) ? 1 : 0;
+        const double lookup_ms = ms_since(t0);
+        EXPECT_EQ(found, N);
+        return std::pair{ insert_ms, lookup_ms };
+        };
+
+    std::unordered_map<eeng::Guid, eeng::Handle<int>> node_map;
+    const auto [node_insert, node_lookup] = run(node_map,
+        [](const auto& map, const eeng::Guid& g) { return map.find(g) != map.end(); });
+
+    FlatHashMap<eeng::Guid, eeng::Handle<int>> flat_map;
+    const auto [flat_insert, flat_lookup] = run(flat_map,
+        [](const auto& map, const eeng::Guid& g) { return map.find(g) != nullptr; });
+
+    std::cout << "[FlatHashMapBenchmark] " << N << " GUIDs, ms (insert / random lookup)\n"
+        << std::fixed << std::setprecision(1)
+        << "  std::unordered_map : " << node_insert << " / " << node_lookup << "\n"
+        << "  FlatHashMap        : " << flat_insert << " / " << flat_lookup << "\n";
+}
@@ -0,0 +1,170 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "FrameArena.hpp"
+#include "EventQueue.h"
+
+namespace {
+
+    struct Tick { int value; };
+
+} // namespace
+
+TEST(LinearArena, BumpsAlignsAndResets)
+{
+    LinearArena arena(4096);
+    EXPECT_EQ(arena.capacity(), 0u); // Nothing allocated until first use
+
+    void* a = arena.allocate(10, 1);
+    void* b = arena.allocate(8, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    EXPECT_GT(static_cast<char*>(b), static_cast<char*>(a));
+    EXPECT_GE(arena.used(), 18u);
+    EXPECT_EQ(arena.upstream_allocations(), 1u);
+
+    arena.deallocate(a, 10, 1); // No-op
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.allocate(10, 1), a); // Same block, from the start
+}
+
+TEST(LinearArena, GrowsThenMergesBlocksOnReset)
+{
+    LinearArena arena(1024);
+    for (int i = 0; i < 100; ++i)
+        (void)arena.allocate(500, 8);
+    EXPECT_GT(arena.upstream_allocations(), 1u);
+    const size_t peak = arena.high_water();
+    EXPECT_GE(peak, 50000u);
+
+    // One block holding the peak: the same workload no longer allocates
+    arena.reset();
+    const uint64_t blocks = arena.upstream_allocations();
+    EXPECT_GE(arena.capacity(), peak);
+    for (int i = 0; i < 100; ++i)
+        (void)arena.allocate(500, 8);
+    EXPECT_EQ(arena.upstream_allocations(), blocks);
+
+    // Larger than a block
+    void* big = arena.allocate(1 << 20, 16);
+    EXPECT_NE(big, nullptr);
+    EXPECT_EQ(arena.high_water(), arena.used());
+}
+
+TEST(LinearArena, BacksPmrContainers)
+{
+    LinearArena arena;
+    std::pmr::vector<std::pmr::string> names{ &arena };
+    for (int i = 0; i < 100; ++i)
+        names.emplace_back("a string long enough to skip the small buffer " + std::to_string(i));
+    EXPECT_EQ(names.back(), "a string long enough to skip the small buffer 99");
+    EXPECT_EQ(names.get_allocator().resource(), &arena);
+    EXPECT_EQ(names.back().get_allocator().resource(), &arena); // Propagated to elements
+    EXPECT_GT(arena.used(), 100u * 48u);
+}
+
+TEST(FrameArena, MemoryLivesThroughTheNextFrame)
+{
+    FrameArena frames(4096);
+
+    std::pmr::vector<int> frame0{ frames.resource() };
+    frame0.assign(100, 7);
+    frames.end_frame();
+
+    // Frame 1 uses the other arena, frame 0's data is intact
+    EXPECT_NE(frames.resource(), frame0.get_allocator().resource());
+    std::pmr::vector<int> frame1{ frames.resource() };
+    frame1.assign(100, 9);
+    EXPECT_EQ(frame0[99], 7);
+
+    // Frame 2 reuses frame 0's arena, reset
+    frames.end_frame();
+    EXPECT_EQ(frames.resource(), frame0.get_allocator().resource());
+    EXPECT_EQ(frames.current().used(), 0u);
+}
+
+TEST(FrameArena, TracksPerFrameStats)
+{
+    FrameArena frames(1024);
+    const size_t sizes[] = { 1000, 20000, 3000 };
+    for (size_t bytes : sizes)
+    {
+        (void)frames.current().allocate(bytes, 8);
+        frames.end_frame();
+    }
+
+    const auto stats = frames.stats();
+    EXPECT_EQ(stats.frames, 3u);
+    EXPECT_GE(stats.last_frame_bytes, 3000u);
+    EXPECT_LT(stats.last_frame_bytes, 20000u);
+    EXPECT_GE(stats.high_water_bytes, 20000u);
+    EXPECT_GE(stats.capacity_bytes, 20000u);
+    EXPECT_GE(stats.upstream_allocations, 2u);
+}
+
+TEST(FrameArena, EventBatchesFromTheArena)
+{
+    EventQueue queue;
+    int sum = 0;
+    queue.register_callback([&](const Tick& t) { sum += t.value; });
+
+    FrameArena frames;
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        for (int i = 1; i <= 10; ++i)
+            queue.enqueue_event(Tick{ i });
+        queue.dispatch_all_events(frames.resource());
+        EXPECT_GT(frames.current().used(), 0u);
+        frames.end_frame();
+    }
+    EXPECT_EQ(sum, 3 * 55);
+    EXPECT_FALSE(queue.has_pending_events());
+}
+
+// A per-frame scratch vector: heap vs frame arena
+TEST(FrameArenaBenchmark, DISABLED_ScratchVectorsPerFrame)
+{
+    constexpr int Frames = 2000;
+    constexpr int VectorsPerFrame = 200;
+    constexpr int Elements = 16;
+
+    auto run = [&](auto&& make_vector, FrameArena* frames)
+        {
+            size_t checksum = 0;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int f = 0; f < Frames; ++f)
+            {
+                for (int v = 0; v < VectorsPerFrame; ++v)
+                {
+                    auto vec = make_vector();
+                    for (int i = 0; i < Elements; ++i)
+                        vec.push_back(i + v);
+                    checksum += vec.back();
+                }
+                if (frames) frames->end_frame();
+            }
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            EXPECT_GT(checksum, 0u);
+            return ns / (double(Frames) * VectorsPerFrame);
+        };
+
+    FrameArena frames;
+    const double heap = run([]() { return std::vector<int>{}; }, nullptr);
+    const double arena = run([&]() { return std::pmr::vector<int>{ frames.resource() }; }, &frames);
+
+    const auto stats = frames.stats();
+    std::cout << "[FrameArenaBenchmark] ns per " << Elements << "-element scratch vector, "
+        << VectorsPerFrame << " per frame\n"
+        << std::fixed << std::setprecision(1)
+        << "  heap        : " << heap << "\n"
+        << "  frame arena : " << arena << "\n"
+        << "  arena peak " << stats.high_water_bytes / 1024.0 << " KB/frame, "
+        << stats.upstream_allocations << " heap blocks over " << stats.frames << " frames\n";
+}
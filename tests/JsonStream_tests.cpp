@@ -0,0 +1,173 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "JsonStream.hpp"
+#include "AllocTracking.hpp"
+
+using namespace eeng;
+
+namespace {
+
+    struct Member
+    {
+        std::string key;
+        nlohmann::json value;
+    };
+
+    struct Collected
+    {
+        std::vector<Member> members;
+        std::vector<Member> elements;
+    };
+
+    Collected collect(const std::string& text, std::initializer_list<std::string_view> element_keys)
+    {
+        Collected out;
+        std::istringstream in(text);
+        for_each_json_member(in, element_keys,
+            [&](const std::string& key, nlohmann::json&& value) { out.members.push_back({ key, std::move(value) }); },
+            [&](const std::string& key, nlohmann::json&& element) { out.elements.push_back({ key, std::move(element) }); });
+        return out;
+    }
+
+    // Shaped like a batch file: a header and a list of entities with components
+    nlohmann::json make_batch(size_t entities)
+    {
+        nlohmann::json batch;
+        for (size_t i = 0; i < 200; ++i)
+            batch["header"]["asset_closure"].push_back("asset-" + std::to_string(i));
+        batch["entities"] = nlohmann::json::array();
+        for (size_t i = 0; i < entities; ++i)
+        {
+            const float f = static_cast<float>(i);
+            nlohmann::json e;
+            e["entity_guid"] = 1000 + i;
+            e["components"]["HeaderComponent"] = { { "name", "entity_" + std::to_string(i) }, { "chunk_tag", "default" }, { "parent_entity", 0 } };
+            e["components"]["Transform"] = { { "position", { f, 0.0f, -f } }, { "rotation", { 1.0f, 0.0f, 0.0f, 0.0f } }, { "scale", { 1.0f, 1.0f, 1.0f } } };
+            e["components"]["MeshComponent"] = { { "model", 4242 }, { "visible", true } };
+            batch["entities"].push_back(std::move(e));
+        }
+        return batch;
+    }
+
+} // namespace
+
+TEST(JsonStream, MembersAndElementsMatchDom)
+{
+    const nlohmann::json doc = {
+        { "header", { { "version", 2 }, { "asset_closure", { "a", "b" } } } },
+        { "entities", { { { "id", 1 }, { "tags", { 1, 2, { { "deep", nullptr } } } } }, 7, "s", { 1.5, true } } },
+        { "name", "batch" },
+        { "other", { 1, 2, 3 } },
+        { "empty", nlohmann::json::object() }
+    };
+    const auto got = collect(doc.dump(), { "entities" });
+
+    ASSERT_EQ(got.elements.size(), doc["entities"].size());
+    for (size_t i = 0; i < got.elements.size(); ++i)
+    {
+        EXPECT_EQ(got.elements[i].key, "entities");
+        EXPECT_EQ(got.elements[i].value, doc["entities"][i]);
+    }
+
+    ASSERT_EQ(got.members.size(), doc.size() - 1);
+    for (const auto& m : got.members)
+        EXPECT_EQ(m.value, doc.at(m.key)) << m.key;
+}
+
+TEST(JsonStream, UnlistedArraysAreMembers)
+{
+    const auto got = collect(R"({"entities": [1, 2], "list": [[1], {"a": [2]}]})", {});
+    EXPECT_TRUE(got.elements.empty());
+    ASSERT_EQ(got.members.size(), 2u);
+    EXPECT_EQ(got.members[0].value, nlohmann::json::parse("[1, 2]"));
+    EXPECT_EQ(got.members[1].value, nlohmann::json::parse(R"([[1], {"a": [2]}])"));
+}
+
+TEST(JsonStream, ListedKeyThatIsNotAnArray)
+{
+    const auto got = collect(R"({"entities": {"a": 1}, "batches": null})", { "entities", "batches" });
+    EXPECT_TRUE(got.elements.empty());
+    ASSERT_EQ(got.members.size(), 2u);
+    EXPECT_EQ(got.members[0].value, nlohmann::json::parse(R"({"a": 1})"));
+    EXPECT_TRUE(got.members[1].value.is_null());
+}
+
+TEST(JsonStream, RejectsBadInput)
+{
+    EXPECT_THROW(collect("[1, 2]", {}), std::runtime_error);
+    EXPECT_THROW(collect("42", {}), std::runtime_error);
+    EXPECT_THROW(collect(R"({"a": [1, )", { "a" }), nlohmann::json::parse_error);
+    EXPECT_THROW(collect(R"({"a": 1} {)", {}), nlohmann::json::parse_error);
+    EXPECT_THROW(collect("", {}), nlohmann::json::parse_error);
+}
+
+// Reading a batch file into per-entity component data: the whole document as
+// a DOM, copied per entity (the former BatchRegistry::do_load), vs streamed
+// one entity at a time and moved
+TEST(JsonStreamBenchmark, DISABLED_BatchFileDomVsStream)
+{
+    constexpr size_t N = 50'000;
+    const auto path = std::filesystem::temp_directory_path() / "eeng_json_stream_bench.json";
+    {
+        std::ofstream out(path);
+        out << make_batch(N).dump(4);
+    }
+
+    auto ms_since = [](auto t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        };
+
+    double dom_ms, stream_ms;
+    int64_t dom_peak, stream_peak;
+    size_t dom_count, stream_count;
+    {
+        alloc_tracking::reset_peak();
+        const int64_t base = alloc_tracking::live_bytes();
+        const auto t0 = std::chrono::steady_clock::now();
+
+        std::ifstream in(path);
+        nlohmann::json doc;
+        in >> doc;
+        std::vector<nlohmann::json> components;
+        for (auto& e : doc["entities"])
+            components.push_back(e["components"]);
+
+        dom_ms = ms_since(t0);
+        dom_peak = alloc_tracking::peak_bytes() - base;
+        dom_count = components.size();
+    }
+    {
+        alloc_tracking::reset_peak();
+        const int64_t base = alloc_tracking::live_bytes();
+        const auto t0 = std::chrono::steady_clock::now();
+
+        std::ifstream in(path);
+        std::vector<nlohmann::json> components;
+        for_each_json_member(in, { "entities" }, {},
+            [&](const std::string&, nlohmann::json&& e) { components.push_back(std::move(e["components"])); });
+
+        stream_ms = ms_since(t0);
+        stream_peak = alloc_tracking::peak_bytes() - base;
+        stream_count = components.size();
+    }
+    EXPECT_EQ(dom_count, N);
+    EXPECT_EQ(stream_count, N);
+
+    std::cout << "[JsonStreamBenchmark] batch file, " << N << " entities, "
+        << std::fixed << std::setprecision(1) << std::filesystem::file_size(path) / 1e6 << " MB\n"
+        << "  DOM    : peak " << dom_peak / 1e6 << " MB, " << dom_ms << " ms\n"
+        << "  stream : peak " << stream_peak / 1e6 << " MB, " << stream_ms << " ms\n";
+
+    std::filesystem::remove(path);
+}
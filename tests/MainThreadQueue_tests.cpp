@@ -0,0 +1,149 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "MainThreadQueue.hpp"
+
+TEST(MainThreadQueue, ExecuteAllRunsInOrder)
+{
+    MainThreadQueue q;
+    std::vector<int> order;
+    for (int i = 0; i < 1000; ++i)
+        q.push([&order, i]() { order.push_back(i); });
+
+    EXPECT_EQ(q.size(), 1000u);
+    EXPECT_EQ(q.execute_all(), 1000u);
+    ASSERT_EQ(order.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(order[i], i);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MainThreadQueue, TasksPushedDuringExecuteRunNextCall)
+{
+    MainThreadQueue q;
+    int runs = 0;
+    std::function<void()> repost = [&]() { ++runs; q.push(repost); };
+    q.push(repost);
+
+    EXPECT_EQ(q.execute_all(), 1u);
+    EXPECT_EQ(runs, 1);
+    EXPECT_EQ(q.execute_all(), 1u);
+    EXPECT_EQ(runs, 2);
+    EXPECT_EQ(q.size(), 1u);
+}
+
+TEST(MainThreadQueue, LargeCallablesAndExceptions)
+{
+    MainThreadQueue q;
+    std::array<int, 64> big{};
+    big.fill(1);
+    int sum = 0;
+    q.push([&sum, big]() { for (int v : big) sum += v; });
+    q.push([]() { throw std::runtime_error("ignored"); });
+    q.push([&sum]() { sum += 1; });
+
+    EXPECT_EQ(q.execute_all(), 3u);
+    EXPECT_EQ(sum, 65);
+}
+
+TEST(MainThreadQueue, ExecuteForDefersRemainingWork)
+{
+    MainThreadQueue q;
+    constexpr int N = 20;
+    int runs = 0;
+    for (int i = 0; i < N; ++i)
+        q.push([&runs]()
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++runs;
+            });
+
+    // Budget covers only a few tasks; the first one always runs
+    const size_t first = q.execute_for(std::chrono::microseconds(2500));
+    EXPECT_GE(first, 1u);
+    EXPECT_LT(first, static_cast<size_t>(N));
+    EXPECT_EQ(q.size(), N - first);
+
+    auto stats = q.stats();
+    EXPECT_EQ(stats.queued, static_cast<uint64_t>(N));
+    EXPECT_EQ(stats.executed, first);
+    EXPECT_EQ(stats.deferred, N - first);
+
+    // Remaining work carries over, in order
+    size_t total = first;
+    while (!q.empty())
+        total += q.execute_for(std::chrono::microseconds(2500));
+    EXPECT_EQ(total, static_cast<size_t>(N));
+    EXPECT_EQ(runs, N);
+    EXPECT_EQ(q.stats().executed, static_cast<uint64_t>(N));
+}
+
+TEST(MainThreadQueue, ManyProducersKeepPerProducerOrder)
+{
+    MainThreadQueue q;
+    constexpr int Producers = 8;
+    constexpr int PerProducer = 20000;
+
+    std::array<int, Producers> last{};
+    last.fill(-1);
+    bool in_order = true;
+
+    std::atomic<int> done{ 0 };
+    std::vector<std::thread> producers;
+    for (int p = 0; p < Producers; ++p)
+    {
+        producers.emplace_back([&, p]()
+            {
+                for (int i = 0; i < PerProducer; ++i)
+                {
+                    q.push([&, p, i]()
+                        {
+                            if (last[p] + 1 != i) in_order = false;
+                            last[p] = i;
+                        });
+                }
+                done.fetch_add(1);
+            });
+    }
+
+    // Consume on this (the owning) thread while producers are running
+    size_t executed = 0;
+    while (done.load() < Producers || !q.empty())
+        executed += q.execute_for(std::chrono::microseconds(200));
+
+    for (auto& t : producers) t.join();
+    executed += q.execute_all();
+
+    EXPECT_EQ(executed, static_cast<size_t>(Producers * PerProducer));
+    EXPECT_TRUE(in_order);
+    for (int p = 0; p < Producers; ++p)
+        EXPECT_EQ(last[p], PerProducer - 1);
+}
+
+TEST(MainThreadQueue, PushAndWaitFromWorker)
+{
+    MainThreadQueue q;
+    std::atomic<bool> stop{ false };
+
+    std::thread worker([&]()
+        {
+            const int v = q.push_and_wait([]() { return 42; });
+            EXPECT_EQ(v, 42);
+            EXPECT_THROW(q.push_and_wait([]() -> int { throw std::runtime_error("boom"); }), std::runtime_error);
+            stop = true;
+        });
+
+    while (!stop.load())
+        q.execute_for(std::chrono::microseconds(100));
+    worker.join();
+
+    // Inline on the owning thread
+    EXPECT_EQ(q.push_and_wait([]() { return 7; }), 7);
+}
@@ -8,6 +8,11 @@
 #include <thread>
 #include <atomic>
 #include <optional>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include "entt/entt.hpp"
 #include "hash_combine.h"
 #include "MetaInfo.h"
@@ -15,6 +20,7 @@
 #include "MetaLiterals.h"
 #include "MetaAux.h"
 #include "EngineContext.hpp"
+#include "AllocTracking.hpp"
 
 using namespace eeng;
 
@@ -502,6 +508,12 @@ namespace
         // Compare
         EXPECT_EQ(t, deserialized_ref);
 
+        // Same again, streamed from JSON text
+        std::istringstream in(j.dump());
+        entt::meta_any streamed_any = T{};
+        meta::deserialize_any(in, streamed_any, ecs::Entity{}, ctx);
+        EXPECT_EQ(t, streamed_any.cast<T&>());
+
         return { j, deserialized_ref };
     }
 }
@@ -607,6 +619,30 @@ TEST_F(MetaSerializationTest, SerializeMockType2)
     test_type(t, ctx);
 }
 
+TEST_F(MetaSerializationTest, StreamedDeserializeSkipsUnknownMembers)
+{
+    std::istringstream in(R"({"X": 7, "unknown": {"a": [1, {"b": 2}]}, "AnEnum": "Bye", "more": [3]})");
+    entt::meta_any any = MockType2{};
+    meta::deserialize_any(in, any, ecs::Entity{}, ctx);
+
+    const auto& t = any.cast<const MockType2&>();
+    EXPECT_EQ(t.x, 7);
+    EXPECT_EQ(t.y, MockType2{}.y); // Not in the JSON: keeps its value
+    EXPECT_EQ(t.an_enum, MockType2::AnEnum::Bye);
+}
+
+TEST_F(MetaSerializationTest, StreamedDeserializeReplacesSequence)
+{
+    std::istringstream in("[[1, 2], [], [3]]");
+    entt::meta_any any = std::vector<std::vector<int>>{ { 9, 9, 9 }, { 9 }, { 9 }, { 9 } };
+    meta::deserialize_any(in, any, ecs::Entity{}, ctx);
+    EXPECT_EQ(any.cast<const std::vector<std::vector<int>>&>(), (std::vector<std::vector<int>>{ { 1, 2 }, {}, { 3 } }));
+
+    std::istringstream malformed("[1, 2");
+    entt::meta_any ints = std::vector<int>{};
+    EXPECT_THROW(meta::deserialize_any(malformed, ints, ecs::Entity{}, ctx), nlohmann::json::parse_error);
+}
+
 TEST_F(MetaSerializationTest, SerializePurposeFiltersFields)
 {
     register_purpose_meta_types();
@@ -853,3 +889,66 @@ TEST_F(MetaSerializationTest, SerializeDeserialize_EntityRoundTrip)
     EXPECT_FLOAT_EQ(m.y, 3.14f);
     EXPECT_EQ(m.an_enum, MockType2::AnEnum::Hola);
 }
+
+// Deserializing a large reflected sequence from a file: parsed into a DOM and
+// then deserialized, vs streamed
+using MetaSerializeBenchmark = MetaSerializationTest;
+
+TEST_F(MetaSerializeBenchmark, DISABLED_DomVsStream)
+{
+    constexpr size_t N = 200'000;
+    std::vector<MockType2> source(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        source[i].x = static_cast<int>(i);
+        source[i].y = static_cast<float>(i) * 0.5f;
+        source[i].an_enum = i % 2 ? MockType2::AnEnum::Bye : MockType2::AnEnum::Hola;
+    }
+    const auto path = std::filesystem::temp_directory_path() / "eeng_meta_stream_bench.json";
+    {
+        std::ofstream out(path);
+        out << meta::serialize_any(source).dump(4);
+    }
+
+    auto ms_since = [](auto t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        };
+
+    double dom_ms, stream_ms;
+    int64_t dom_peak, stream_peak;
+    {
+        alloc_tracking::reset_peak();
+        const int64_t base = alloc_tracking::live_bytes();
+        const auto t0 = std::chrono::steady_clock::now();
+
+        std::ifstream in(path);
+        nlohmann::json j;
+        in >> j;
+        entt::meta_any any = std::vector<MockType2>{};
+        meta::deserialize_any(j, any, ecs::Entity{}, ctx);
+
+        dom_ms = ms_since(t0);
+        dom_peak = alloc_tracking::peak_bytes() - base;
+        EXPECT_EQ(any.cast<const std::vector<MockType2>&>(), source);
+    }
+    {
+        alloc_tracking::reset_peak();
+        const int64_t base = alloc_tracking::live_bytes();
+        const auto t0 = std::chrono::steady_clock::now();
+
+        std::ifstream in(path);
+        entt::meta_any any = std::vector<MockType2>{};
+        meta::deserialize_any(in, any, ecs::Entity{}, ctx);
+
+        stream_ms = ms_since(t0);
+        stream_peak = alloc_tracking::peak_bytes() - base;
+        EXPECT_EQ(any.cast<const std::vector<MockType2>&>(), source);
+    }
+
+    std::cout << "[MetaSerializeBenchmark] std::vector<MockType2>, " << N << " elements, "
+        << std::fixed << std::setprecision(1) << std::filesystem::file_size(path) / 1e6 << " MB\n"
+        << "  DOM    : peak " << dom_peak / 1e6 << " MB, " << dom_ms << " ms\n"
+        << "  stream : peak " << stream_peak / 1e6 << " MB, " << stream_ms << " ms\n";
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,291 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <nlohmann/json.hpp>
+
+#include "assets/types/ModelAssets.hpp"
+#include "serializers/ModelDataAssetSerialization.hpp"
+
+using namespace eeng;
+
+namespace {
+
+    // A skinned model: vertex streams, two submeshes, a three-node skeleton
+    // and one clip with a track per node
+    assets::ModelDataAsset make_model(size_t vertices, size_t keys)
+    {
+        assets::ModelDataAsset model;
+        for (size_t i = 0; i < vertices; ++i)
+        {
+            const float f = static_cast<float>(i);
+            model.positions.push_back({ f, f * 0.5f, -f });
+            model.normals.push_back({ 0.0f, 1.0f, 0.0f });
+            model.tangents.push_back({ 1.0f, 0.0f, 0.0f });
+            model.binormals.push_back({ 0.0f, 0.0f, 1.0f });
+            model.texcoords.push_back({ f * 0.25f, 1.0f - f * 0.25f });
+            assets::SkinData skin;
+            skin.bone_indices = { assets::u32(i % 2), 1, 0, 0 };
+            skin.bone_weights = { 0.75f, 0.25f, 0.0f, 0.0f };
+            model.skin.push_back(skin);
+        }
+        for (size_t i = 0; i + 2 < vertices; ++i)
+            model.indices.insert(model.indices.end(), { assets::u32(i), assets::u32(i + 1), assets::u32(i + 2) });
+
+        assets::SubMesh sm;
+        sm.nbr_indices = static_cast<assets::u32>(model.indices.size() / 2);
+        sm.nbr_vertices = static_cast<assets::u32>(vertices);
+        sm.material = AssetRef<assets::MaterialAsset>{ Guid{ 1234 } };
+        sm.node_index = 1;
+        sm.is_skinned = true;
+        model.submeshes.push_back(sm);
+        sm.base_index = sm.nbr_indices;
+        sm.material = AssetRef<assets::MaterialAsset>{ Guid{ 5678 } };
+        sm.is_skinned = false;
+        model.submeshes.push_back(sm);
+
+        assets::SkeletonNode root, hip, knee;
+        root.name = "root";
+        hip.name = "hip";
+        hip.bone_index = 0;
+        hip.local_bind_tfm[3] = { 0.0f, 1.0f, 0.0f, 1.0f };
+        knee.name = "knee";
+        knee.bone_index = 1;
+        knee.nbr_meshes = 1;
+        model.nodetree.insert_as_root(root);
+        model.nodetree.insert(hip, root);
+        model.nodetree.insert(knee, hip);
+
+        assets::Bone bone;
+        bone.name = "hip";
+        bone.node_index = 1;
+        model.bones.push_back(bone);
+        bone.name = "knee";
+        bone.node_index = 2;
+        bone.inverse_bind_tfm[3] = { 0.0f, -1.0f, 0.0f, 1.0f };
+        model.bones.push_back(bone);
+
+        assets::AnimClip clip;
+        clip.name = "walk";
+        clip.duration_ticks = static_cast<float>(keys);
+        clip.ticks_per_second = 30.0f;
+        clip.node_animations.resize(model.nodetree.size());
+        for (size_t n = 1; n < clip.node_animations.size(); ++n)
+        {
+            auto& track = clip.node_animations[n];
+            track.is_used = true;
+            for (size_t k = 0; k < keys; ++k)
+            {
+                const float t = static_cast<float>(k);
+                track.pos_keys.push_back({ t, 0.0f, 0.0f });
+                track.scale_keys.push_back({ 1.0f, 1.0f, 1.0f });
+                track.rot_keys.push_back(glm::quat(1.0f, 0.0f, t * 0.01f, 0.0f));
+            }
+        }
+        model.animations.push_back(clip);
+        return model;
+    }
+
+    void expect_same_model(const assets::ModelDataAsset& a, const assets::ModelDataAsset& b)
+    {
+        EXPECT_EQ(a.positions, b.positions);
+        EXPECT_EQ(a.normals, b.normals);
+        EXPECT_EQ(a.tangents, b.tangents);
+        EXPECT_EQ(a.binormals, b.binormals);
+        EXPECT_EQ(a.texcoords, b.texcoords);
+        ASSERT_EQ(a.skin.size(), b.skin.size());
+        for (size_t i = 0; i < a.skin.size(); ++i)
+        {
+            EXPECT_EQ(a.skin[i].bone_indices, b.skin[i].bone_indices);
+            EXPECT_EQ(a.skin[i].bone_weights, b.skin[i].bone_weights);
+        }
+        EXPECT_EQ(a.indices, b.indices);
+
+        ASSERT_EQ(a.submeshes.size(), b.submeshes.size());
+        for (size_t i = 0; i < a.submeshes.size(); ++i)
+        {
+            EXPECT_EQ(a.submeshes[i].base_index, b.submeshes[i].base_index);
+            EXPECT_EQ(a.submeshes[i].nbr_indices, b.submeshes[i].nbr_indices);
+            EXPECT_EQ(a.submeshes[i].nbr_vertices, b.submeshes[i].nbr_vertices);
+            EXPECT_EQ(a.submeshes[i].material.guid, b.submeshes[i].material.guid);
+            EXPECT_EQ(a.submeshes[i].node_index, b.submeshes[i].node_index);
+            EXPECT_EQ(a.submeshes[i].is_skinned, b.submeshes[i].is_skinned);
+        }
+
+        ASSERT_EQ(a.nodetree.size(), b.nodetree.size());
+        for (size_t i = 0; i < a.nodetree.size(); ++i)
+        {
+            const auto& na = a.nodetree.get_payload_at(i);
+            const auto& nb = b.nodetree.get_payload_at(i);
+            EXPECT_EQ(na.name, nb.name);
+            EXPECT_EQ(na.local_bind_tfm, nb.local_bind_tfm);
+            EXPECT_EQ(na.bone_index, nb.bone_index);
+            EXPECT_EQ(na.nbr_meshes, nb.nbr_meshes);
+            EXPECT_EQ(std::get<3>(a.nodetree.get_node_info_at(i)), std::get<3>(b.nodetree.get_node_info_at(i))); // Parent offset
+        }
+
+        ASSERT_EQ(a.bones.size(), b.bones.size());
+        for (size_t i = 0; i < a.bones.size(); ++i)
+        {
+            EXPECT_EQ(a.bones[i].name, b.bones[i].name);
+            EXPECT_EQ(a.bones[i].node_index, b.bones[i].node_index);
+            EXPECT_EQ(a.bones[i].inverse_bind_tfm, b.bones[i].inverse_bind_tfm);
+        }
+
+        ASSERT_EQ(a.animations.size(), b.animations.size());
+        for (size_t c = 0; c < a.animations.size(); ++c)
+        {
+            const auto& ca = a.animations[c];
+            const auto& cb = b.animations[c];
+            EXPECT_EQ(ca.name, cb.name);
+            EXPECT_EQ(ca.duration_ticks, cb.duration_ticks);
+            EXPECT_EQ(ca.ticks_per_second, cb.ticks_per_second);
+            ASSERT_EQ(ca.node_animations.size(), cb.node_animations.size());
+            for (size_t t = 0; t < ca.node_animations.size(); ++t)
+            {
+                EXPECT_EQ(ca.node_animations[t].is_used, cb.node_animations[t].is_used);
+                EXPECT_EQ(ca.node_animations[t].pos_keys, cb.node_animations[t].pos_keys);
+                EXPECT_EQ(ca.node_animations[t].scale_keys, cb.node_animations[t].scale_keys);
+                EXPECT_EQ(ca.node_animations[t].rot_keys, cb.node_animations[t].rot_keys);
+            }
+        }
+    }
+
+    std::filesystem::path temp_file(const char* name)
+    {
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+} // namespace
+
+TEST(ModelDataCooked, RoundTripsInMemory)
+{
+    const auto model = make_model(64, 8);
+    const auto bytes = serializers::cook_model_data(model);
+    EXPECT_EQ(bytes.size() % 16, 0u);
+
+    assets::ModelDataAsset loaded;
+    loaded.positions.push_back({ 9.0f, 9.0f, 9.0f }); // Replaced, not appended to
+    serializers::read_cooked_model_data(bytes, loaded);
+    expect_same_model(model, loaded);
+}
+
+TEST(ModelDataCooked, RoundTripsThroughMappedFile)
+{
+    const auto model = make_model(1000, 30);
+    const auto path = temp_file("eeng_model_cooked_test.cooked");
+    serializers::write_cooked_model_data_file(model, path);
+
+    assets::ModelDataAsset loaded;
+    serializers::read_cooked_model_data_file(path, loaded);
+    expect_same_model(model, loaded);
+    std::filesystem::remove(path);
+}
+
+TEST(ModelDataCooked, EmptyModel)
+{
+    const assets::ModelDataAsset model;
+    assets::ModelDataAsset loaded;
+    serializers::read_cooked_model_data(serializers::cook_model_data(model), loaded);
+    expect_same_model(model, loaded);
+}
+
+TEST(ModelDataCooked, RejectsBadInput)
+{
+    const auto bytes = serializers::cook_model_data(make_model(16, 4));
+    assets::ModelDataAsset loaded;
+
+    auto bad_magic = bytes;
+    bad_magic[0] = std::byte{ 'X' };
+    EXPECT_THROW(serializers::read_cooked_model_data(bad_magic, loaded), std::runtime_error);
+
+    auto bad_version = bytes;
+    const uint32_t version = serializers::model_data_cooked_version + 1;
+    std::memcpy(bad_version.data() + 4, &version, sizeof(version));
+    EXPECT_THROW(serializers::read_cooked_model_data(bad_version, loaded), std::runtime_error);
+
+    const std::span<const std::byte> truncated{ bytes.data(), bytes.size() / 2 };
+    EXPECT_THROW(serializers::read_cooked_model_data(truncated, loaded), std::runtime_error);
+    EXPECT_THROW(serializers::read_cooked_model_data({}, loaded), std::runtime_error);
+}
+
+TEST(ModelDataCooked, RejectsStaleSource)
+{
+    const auto model = make_model(16, 4);
+    const auto json_path = temp_file("eeng_model_stale_test.json");
+    const auto cooked_path = temp_file("eeng_model_stale_test.cooked");
+    std::ofstream(json_path) << "{}";
+    serializers::write_cooked_model_data_file(model, cooked_path, serializers::cooked_source_stamp(json_path));
+
+    assets::ModelDataAsset loaded;
+    serializers::read_cooked_model_data_file(cooked_path, loaded, serializers::cooked_source_stamp(json_path));
+    expect_same_model(model, loaded);
+
+    // Same size, restored to an older time: a newer cooked file is still stale
+    std::ofstream(json_path) << "[]";
+    std::filesystem::last_write_time(json_path, std::filesystem::last_write_time(json_path) - std::chrono::hours(1));
+    EXPECT_THROW(serializers::read_cooked_model_data_file(cooked_path, loaded, serializers::cooked_source_stamp(json_path)), std::runtime_error);
+
+    // Different size
+    std::ofstream(json_path) << "{ }";
+    EXPECT_THROW(serializers::read_cooked_model_data_file(cooked_path, loaded, serializers::cooked_source_stamp(json_path)), std::runtime_error);
+
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(cooked_path);
+}
+
+// Load time of the same model from pretty-printed JSON and from the cooked file
+TEST(ModelDataCookedBenchmark, DISABLED_LoadJsonVsCooked)
+{
+    const auto model = make_model(100'000, 500);
+    const auto json_path = temp_file("eeng_model_bench.json");
+    const auto cooked_path = temp_file("eeng_model_bench.cooked");
+
+    {
+        nlohmann::json j;
+        serializers::serialize_ModelDataAsset(j, entt::forward_as_meta(model));
+        std::ofstream out(json_path);
+        out << j.dump(4);
+    }
+    serializers::write_cooked_model_data_file(model, cooked_path);
+
+    auto ms_since = [](auto t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        };
+
+    auto t0 = std::chrono::steady_clock::now();
+    entt::meta_any from_json = assets::ModelDataAsset{};
+    {
+        std::ifstream in(json_path);
+        nlohmann::json j;
+        in >> j;
+        serializers::deserialize_ModelDataAsset(j, from_json);
+    }
+    const double json_ms = ms_since(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    assets::ModelDataAsset from_cooked;
+    serializers::read_cooked_model_data_file(cooked_path, from_cooked);
+    const double cooked_ms = ms_since(t0);
+
+    EXPECT_EQ(from_json.cast<const assets::ModelDataAsset&>().positions, from_cooked.positions);
+    EXPECT_EQ(from_cooked.indices, model.indices);
+
+    std::cout << "[ModelDataCookedBenchmark] " << model.positions.size() << " vertices, "
+        << model.animations[0].node_animations.size() << " tracks x 500 keys\n"
+        << std::fixed << std::setprecision(1)
+        << "  JSON   : " << std::filesystem::file_size(json_path) / 1e6 << " MB, " << json_ms << " ms\n"
+        << "  cooked : " << std::filesystem::file_size(cooked_path) / 1e6 << " MB, " << cooked_ms << " ms\n";
+
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(cooked_path);
+}
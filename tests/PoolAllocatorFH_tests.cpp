@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <atomic>
+#include <vector>
 
 #include "PoolAllocatorFH.h"
 #include "Handle.h"
@@ -245,4 +246,104 @@ TEST_F(PoolAllocatorFHTest, RespectsForced256Alignment)
     EXPECT_TRUE(is_aligned(p, 256))
         << "pointer " << p
         << " must be aligned to 256 bytes";
-}
\ No newline at end of file
+}
+
+TEST_F(PoolAllocatorFHTest, ChunkedGrowthKeepsAddresses)
+{
+    PoolAllocatorFH chunked(type_info, 16, PoolGrowth::Chunked, 16);
+    EXPECT_EQ(chunked.growth(), PoolGrowth::Chunked);
+
+    std::vector<Handle<MoveTest>> handles;
+    std::vector<MoveTest*> addresses;
+    for (int i = 0; i < 100; ++i)
+    {
+        handles.push_back(chunked.create<MoveTest>(i));
+        addresses.push_back(&chunked.get<MoveTest>(handles.back()));
+        if (i % 16 == 0)
+        {
+            EXPECT_TRUE(is_aligned(addresses.back(), 16)); // Chunk base
+        }
+    }
+
+    // Grown one chunk at a time, nothing moved
+    EXPECT_EQ(chunked.capacity(), 112 * sizeof(MoveTest));
+    EXPECT_EQ(MoveTest::constructions.load(), 100);
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        EXPECT_EQ(&chunked.get<MoveTest>(handles[i]), addresses[i]);
+        EXPECT_EQ(chunked.get<MoveTest>(handles[i]).value, int(i));
+    }
+
+    chunked.destroy(handles[40]);
+    auto reused = chunked.create<MoveTest>(7);
+    EXPECT_EQ(reused.idx, handles[40].idx);
+    EXPECT_EQ(chunked.count_free(), 12u);
+
+    for (auto h : handles)
+        if (h.idx != reused.idx) chunked.destroy(h);
+    chunked.destroy(reused);
+    EXPECT_EQ(MoveTest::constructions.load(), MoveTest::destructions.load());
+}
+
+TEST_F(PoolAllocatorFHTest, OccupancyTracksLiveSlots)
+{
+    std::vector<Handle<MoveTest>> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(pool.create<MoveTest>(i));
+    for (size_t i = 0; i < handles.size(); i += 2)
+        pool.destroy(handles[i]);
+
+    EXPECT_EQ(pool.count_used(), 50u);
+    EXPECT_EQ(pool.count_free(), pool.capacity() / sizeof(MoveTest) - 50u);
+    EXPECT_FALSE(pool.is_used(handles[0]));
+    EXPECT_TRUE(pool.is_used(handles[1]));
+
+    int sum = 0, count = 0;
+    pool.used_visitor<MoveTest>([&](MoveTest& m) { sum += m.value; ++count; });
+    EXPECT_EQ(count, 50);
+    EXPECT_EQ(sum, 2500); // 1 + 3 + ... + 99
+
+    const std::string s = pool.to_string();
+    EXPECT_NE(s.find("[F][U][F][U]"), std::string::npos);
+}
+
+TEST_F(PoolAllocatorFHTest, CompactMovesLiveElementsDown)
+{
+    std::vector<Handle<MoveTest>> handles;
+    for (int i = 0; i < 100; ++i)
+        handles.push_back(pool.create<MoveTest>(i));
+    for (size_t i = 0; i < 60; ++i)
+        pool.destroy(handles[i]);
+
+    // Live elements 60..99 move into slots 0..39
+    const auto moves = pool.compact<MoveTest>();
+    EXPECT_EQ(moves.size(), 40u);
+    int sum = 0;
+    for (const auto& move : moves)
+    {
+        EXPECT_LT(move.to, 40u);
+        sum += pool.get<MoveTest>(Handle<MoveTest>{ move.to }).value;
+    }
+    EXPECT_EQ(sum, (60 + 99) * 40 / 2);
+    EXPECT_EQ(pool.capacity(), 40 * sizeof(MoveTest));
+    EXPECT_EQ(pool.count_free(), 0u);
+    EXPECT_TRUE(is_aligned(&pool.get<MoveTest>(Handle<MoveTest>{ 0 }), 16));
+
+    // Chunked: trailing chunks are released, the kept chunk's tail is reused
+    PoolAllocatorFH chunked(type_info, 16, PoolGrowth::Chunked, 16);
+    for (int i = 0; i < 40; ++i)
+        chunked.create<MoveTest>(i);
+    for (size_t i = 0; i < 30; ++i)
+        chunked.destroy(Handle<MoveTest>{ i });
+    EXPECT_EQ(chunked.compact<MoveTest>().size(), 10u);
+    EXPECT_EQ(chunked.capacity(), 16 * sizeof(MoveTest));
+    EXPECT_EQ(chunked.count_free(), 6u);
+    EXPECT_EQ(chunked.create<MoveTest>(0).idx, 10u);
+    EXPECT_EQ(chunked.count_used(), 11u);
+
+    for (size_t i = 0; i < 11; ++i)
+        chunked.destroy(Handle<MoveTest>{ i });
+    for (size_t i = 0; i < 40; ++i)
+        pool.destroy(Handle<MoveTest>{ i });
+    EXPECT_EQ(MoveTest::constructions.load(), MoveTest::destructions.load());
+}
@@ -2,8 +2,12 @@
 // Licensed under the MIT License. See LICENSE file for details.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <vector>
 
 #include "PoolAllocatorTFH.h"
 #include "Handle.h"
@@ -236,4 +240,408 @@ TEST_F(PoolAllocatorTFHTest, RespectsForced256Alignment)
 
     EXPECT_TRUE(is_aligned(p, 256))
         << "pointer " << p << " must be aligned to 256 bytes";
-}
\ No newline at end of file
+}
+
+TEST_F(PoolAllocatorTFHTest, ChunkedGrowthKeepsAddresses)
+{
+    PoolAllocatorTFH<MoveTest> chunked(0, PoolGrowth::Chunked, 16);
+    EXPECT_EQ(chunked.growth(), PoolGrowth::Chunked);
+    EXPECT_EQ(chunked.capacity(), 0u);
+
+    std::vector<Handle<MoveTest>> handles;
+    std::vector<MoveTest*> addresses;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        handles.push_back(chunked.create(i));
+        addresses.push_back(&chunked.get(handles.back()));
+    }
+
+    // Grown one chunk at a time, nothing moved
+    EXPECT_EQ(chunked.capacity(), 112u);
+    EXPECT_EQ(MoveTest::constructions.load(), 100);
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        EXPECT_EQ(&chunked.get(handles[i]), addresses[i]);
+        EXPECT_EQ(chunked.get(handles[i]).value, i);
+    }
+}
+
+TEST_F(PoolAllocatorTFHTest, ChunkedReuseVisitAndMove)
+{
+    PoolAllocatorTFH<MoveTest> chunked(20, PoolGrowth::Chunked, 8);
+    EXPECT_EQ(chunked.capacity(), 24u);
+    EXPECT_EQ(chunked.count_free(), 24u);
+
+    std::vector<Handle<MoveTest>> handles;
+    for (size_t i = 0; i < 24; ++i)
+        handles.push_back(chunked.create(i));
+    chunked.destroy(handles[9]);
+    auto reused = chunked.create(99);
+    EXPECT_EQ(reused.idx, handles[9].idx);
+
+    size_t sum = 0;
+    chunked.used_visitor([&](MoveTest& m) { sum += m.value; });
+    EXPECT_EQ(sum, 24 * 23 / 2 - 9 + 99);
+
+    // Moving the allocator moves the chunks, not the elements
+    MoveTest* address = &chunked.get(handles[20]);
+    PoolAllocatorTFH<MoveTest> moved(std::move(chunked));
+    EXPECT_EQ(&moved.get(handles[20]), address);
+    EXPECT_EQ(moved.capacity(), 24u);
+    EXPECT_EQ(chunked.capacity(), 0u);
+
+    moved.clear();
+    EXPECT_EQ(moved.capacity(), 0u);
+    EXPECT_EQ(MoveTest::constructions.load(), MoveTest::destructions.load());
+}
+
+TEST_F(PoolAllocatorTFHTest, ChunkedRespectsAlignment)
+{
+    struct alignas(64) Aligned64 { size_t x; };
+    PoolAllocatorTFH<Aligned64> chunked(0, PoolGrowth::Chunked, 4);
+    for (size_t i = 0; i < 10; ++i)
+    {
+        auto h = chunked.create(Aligned64{ i });
+        EXPECT_TRUE(is_aligned(&chunked.get(h), 64));
+    }
+}
+
+// Fill a pool one element at a time and report the mean cost per create and the
+// worst single create (which includes a growth step)
+TEST(PoolAllocatorTFHBenchmark, DISABLED_ChunkedVsRelocatingGrowth)
+{
+    struct Payload { size_t values[8]; };
+    constexpr size_t N = 1 << 18;
+
+    auto fill = [](PoolAllocatorTFH<Payload>& pool)
+        {
+            using clock = std::chrono::steady_clock;
+            double worst = 0.0;
+            const auto t0 = clock::now();
+            for (size_t i = 0; i < N; ++i)
+            {
+                const auto c0 = clock::now();
+                (void)pool.create(Payload{ { i } });
+                worst = std::max(worst, std::chrono::duration<double, std::micro>(clock::now() - c0).count());
+            }
+            const double mean = std::chrono::duration<double, std::nano>(clock::now() - t0).count() / N;
+            return std::pair{ mean, worst };
+        };
+
+    PoolAllocatorTFH<Payload> relocating;
+    PoolAllocatorTFH<Payload> chunked(0, PoolGrowth::Chunked, 4096);
+    const auto [relocating_mean, relocating_worst] = fill(relocating);
+    const auto [chunked_mean, chunked_worst] = fill(chunked);
+
+    std::cout << "[PoolAllocatorTFHBenchmark] " << N << " creates of " << sizeof(Payload) << "-byte elements\n"
+        << std::fixed << std::setprecision(1)
+        << "  relocating : " << relocating_mean << " ns mean, worst create " << relocating_worst << " us\n"
+        << "  chunked    : " << chunked_mean << " ns mean, worst create " << chunked_worst << " us\n";
+    EXPECT_EQ(relocating.capacity(), N);
+    EXPECT_EQ(chunked.capacity(), N);
+}
+
+TEST_F(PoolAllocatorTFHTest, OccupancyTracksLiveSlots)
+{
+    std::vector<Handle<MoveTest>> handles;
+    for (size_t i = 0; i < 200; ++i)
+        handles.push_back(pool.create(i));
+    for (size_t i = 0; i < handles.size(); i += 3)
+        pool.destroy(handles[i]);
+
+    EXPECT_EQ(pool.count_used(), 133u);
+    EXPECT_EQ(pool.count_free(), pool.capacity() - 133u);
+    EXPECT_FALSE(pool.is_used(handles[0]));
+    EXPECT_TRUE(pool.is_used(handles[1]));
+    EXPECT_FALSE(pool.is_used(Handle<MoveTest>{}));
+
+    // Visited in slot order, skipping destroyed elements
+    std::vector<size_t> visited;
+    pool.used_visitor([&](MoveTest& m) { visited.push_back(m.value); });
+    ASSERT_EQ(visited.size(), 133u);
+    for (size_t i = 1; i < visited.size(); ++i)
+    {
+        EXPECT_LT(visited[i - 1], visited[i]);
+        EXPECT_NE(visited[i] % 3, 0u);
+    }
+
+    // Growing with a non-empty free-list keeps elements and occupancy
+    for (size_t i = 0; i < 300; ++i)
+        handles.push_back(pool.create(1000 + i));
+    EXPECT_EQ(pool.count_used(), 433u);
+    EXPECT_EQ(pool.get(handles[1]).value, 1u);
+    EXPECT_EQ(pool.get(handles.back()).value, 1299u);
+}
+
+// Visiting a sparse pool: occupancy bitmap vs the previous free-list walk into a vector<bool>
+TEST_F(PoolAllocatorTFHTest, CompactMovesLiveElementsDown)
+{
+    std::vector<Handle<MoveTest>> handles;
+    for (size_t i = 0; i < 100; ++i)
+        handles.push_back(pool.create(i));
+    for (size_t i = 0; i < handles.size(); i += 2)
+        pool.destroy(handles[i]);
+    ASSERT_EQ(pool.capacity(), 128u);
+
+    // The highest live elements fill the lowest holes
+    const auto moves = pool.compact();
+    EXPECT_EQ(moves.size(), 25u);
+    for (const auto& move : moves)
+    {
+        EXPECT_LT(move.to, 50u);
+        EXPECT_GE(move.from, 50u);
+    }
+    EXPECT_EQ(moves.front().from, handles[99].idx);
+    EXPECT_EQ(moves.front().to, handles[0].idx);
+
+    // The free tail is released and the rest is still usable
+    EXPECT_EQ(pool.capacity(), 50u);
+    EXPECT_EQ(pool.count_used(), 50u);
+    EXPECT_EQ(pool.count_free(), 0u);
+    std::vector<size_t> values;
+    pool.used_visitor([&](MoveTest& m) { values.push_back(m.value); });
+    std::sort(values.begin(), values.end());
+    for (size_t i = 0; i < values.size(); ++i)
+        EXPECT_EQ(values[i], 2 * i + 1);
+
+    auto h = pool.create(500);
+    EXPECT_EQ(h.idx, 50u);
+    EXPECT_EQ(pool.get(h).value, 500u);
+
+    // Already compact: nothing moves
+    pool.destroy(h);
+    EXPECT_TRUE(pool.compact().empty());
+    pool.clear();
+    EXPECT_EQ(MoveTest::constructions.load(), MoveTest::destructions.load());
+}
+
+TEST_F(PoolAllocatorTFHTest, CompactChunkedReleasesTrailingChunks)
+{
+    PoolAllocatorTFH<MoveTest> chunked(0, PoolGrowth::Chunked, 16);
+    std::vector<Handle<MoveTest>> handles;
+    for (size_t i = 0; i < 64; ++i)
+        handles.push_back(chunked.create(i));
+    for (size_t i = 10; i < 64; ++i)
+        if (i != 60) chunked.destroy(handles[i]);
+    ASSERT_EQ(chunked.capacity(), 64u);
+
+    const auto moves = chunked.compact();
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].from, 60u);
+    EXPECT_EQ(moves[0].to, 10u);
+    EXPECT_EQ(chunked.get(Handle<MoveTest>{ 10 }).value, 60u);
+
+    // One chunk covers the 11 live elements; its free slots are reused
+    EXPECT_EQ(chunked.capacity(), 16u);
+    EXPECT_EQ(chunked.count_free(), 5u);
+    for (size_t i = 0; i < 5; ++i)
+        EXPECT_LT(chunked.create(100 + i).idx, 16u);
+    EXPECT_EQ(chunked.capacity(), 16u);
+
+    // Everything freed: all chunks are released
+    for (size_t i = 0; i < 16; ++i)
+        chunked.destroy(Handle<MoveTest>{ i, 0 });
+    chunked.compact();
+    EXPECT_EQ(chunked.capacity(), 0u);
+    EXPECT_EQ(MoveTest::constructions.load(), MoveTest::destructions.load());
+}
+
+TEST_F(PoolAllocatorTFHTest, ChunkedSlotGenerations)
+{
+    PoolAllocatorTFH<MoveTest> chunked(0, PoolGrowth::Chunked, 16);
+    const auto first = chunked.create(0);
+    EXPECT_TRUE(chunked.is_current(first));
+
+    // Destroying bumps the slot's generation; the reused slot hands out the new one
+    chunked.destroy(first);
+    EXPECT_FALSE(chunked.is_current(first));
+    const auto second = chunked.create(0);
+    EXPECT_EQ(second.idx, first.idx);
+    EXPECT_EQ(second.ver, first.ver + 1);
+    EXPECT_TRUE(chunked.is_current(second));
+    EXPECT_FALSE(chunked.is_current(Handle<MoveTest>{ second.idx }));
+    EXPECT_FALSE(chunked.is_current(Handle<MoveTest>{ 1000, 0 })); // Past capacity
+
+    // Slots 1-20, over two chunks; free 1-10
+    std::vector<Handle<MoveTest>> handles;
+    for (size_t i = 1; i <= 20; ++i)
+        handles.push_back(chunked.create(i));
+    for (size_t i = 0; i < 10; ++i)
+        chunked.destroy(handles[i]);
+
+    // Moved elements: the old handle goes stale, the new one is current
+    const auto moves = chunked.compact();
+    ASSERT_EQ(moves.size(), 10u);
+    for (const auto& move : moves)
+    {
+        const Handle<MoveTest> old_handle{ move.from, move.from_ver };
+        const Handle<MoveTest> new_handle{ move.to, move.to_ver };
+        EXPECT_EQ(old_handle, handles[move.from - 1]);
+        EXPECT_FALSE(chunked.is_current(old_handle));
+        ASSERT_TRUE(chunked.is_current(new_handle));
+        EXPECT_EQ(chunked.get(new_handle).value, move.from);
+    }
+
+    // The second chunk was released. Slots of a chunk added again start past
+    // every generation they had, so handles into the old chunk stay stale.
+    ASSERT_EQ(chunked.capacity(), 16u);
+    const auto stale = handles.back();
+    ASSERT_EQ(stale.idx, 20u);
+    std::vector<Handle<MoveTest>> regrown;
+    while (chunked.capacity() < 32 || regrown.size() < 16)
+        regrown.push_back(chunked.create(0));
+    EXPECT_FALSE(chunked.is_current(stale));
+    for (const auto& h : regrown)
+    {
+        EXPECT_TRUE(chunked.is_current(h));
+        if (h.idx == stale.idx)
+        {
+            EXPECT_GT(h.ver, stale.ver);
+        }
+    }
+}
+
+TEST(PoolAllocatorTFHBenchmark, DISABLED_SparseUsedVisitor)
+{
+    struct Payload { size_t value; size_t padding[3]; };
+    constexpr size_t N = 1 << 18;
+    constexpr int Rounds = 20;
+
+    PoolAllocatorTFH<Payload> pool(N);
+    std::vector<Handle<Payload>> handles;
+    for (size_t i = 0; i < N; ++i)
+        handles.push_back(pool.create(Payload{ i, {} }));
+    for (size_t i = 0; i < N; ++i)
+        if (i % 64 != 0) pool.destroy(handles[i]); // 1 in 64 live
+
+    using clock = std::chrono::steady_clock;
+    size_t sum = 0;
+    auto t0 = clock::now();
+    for (int r = 0; r < Rounds; ++r)
+        pool.used_visitor([&](const Payload& p) { sum += p.value; });
+    const double bitmap_us = std::chrono::duration<double, std::micro>(clock::now() - t0).count() / Rounds;
+
+    // Baseline: a vector<bool> with free slots cleared (standing in for the
+    // free-list walk, minus its pointer chasing), then a scan of every slot
+    size_t baseline_sum = 0;
+    t0 = clock::now();
+    for (int r = 0; r < Rounds; ++r)
+    {
+        std::vector<bool> used(pool.capacity(), true);
+        for (size_t i = 0; i < N; ++i)
+            if (i % 64 != 0) used[i] = false;
+        for (size_t i = 0; i < used.size(); ++i)
+            if (used[i]) baseline_sum += pool.get(handles[i]).value;
+    }
+    const double baseline_us = std::chrono::duration<double, std::micro>(clock::now() - t0).count() / Rounds;
+
+    std::cout << "[PoolAllocatorTFHBenchmark] used_visitor over " << N << " slots, "
+        << pool.count_used() << " live\n"
+        << std::fixed << std::setprecision(1)
+        << "  per-slot scan  : " << baseline_us << " us\n"
+        << "  bitmap scan    : " << bitmap_us << " us\n";
+    EXPECT_EQ(sum, baseline_sum);
+}
+
+// Chunked: create / destroy / get from many threads without the pool lock
+TEST_F(PoolAllocatorTFHTest, ChunkedLockFreeCreateDestroyGet)
+{
+    constexpr int Threads = 8;
+    constexpr size_t PerThread = 2000;
+    PoolAllocatorTFH<MoveTest> chunked(0, PoolGrowth::Chunked, 64);
+
+    std::atomic<bool> corrupted{ false };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < Threads; ++t)
+        threads.emplace_back([&, t]()
+            {
+                std::vector<Handle<MoveTest>> handles;
+                for (size_t round = 0; round < 4; ++round)
+                {
+                    for (size_t i = 0; i < PerThread; ++i)
+                        handles.push_back(chunked.create(t * PerThread + i));
+                    for (size_t i = 0; i < handles.size(); ++i)
+                        if (chunked.get(handles[i]).value != t * PerThread + i) corrupted = true;
+                    // Free every other element, keep the rest until the end
+                    for (size_t i = 0; i < handles.size(); i += 2)
+                        chunked.destroy(handles[i]);
+                    for (size_t i = 1; i < handles.size(); i += 2)
+                        chunked.destroy(handles[i]);
+                    handles.clear();
+                }
+            });
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_FALSE(corrupted.load());
+    EXPECT_EQ(chunked.count_used(), 0u);
+    EXPECT_EQ(chunked.count_free(), chunked.capacity());
+    EXPECT_LE(chunked.capacity(), Threads * PerThread + Threads * 64u);
+    EXPECT_EQ(MoveTest::constructions.load(), MoveTest::destructions.load());
+
+    // Every slot is on the free-list exactly once
+    std::vector<Handle<MoveTest>> handles;
+    const size_t capacity = chunked.capacity();
+    for (size_t i = 0; i < capacity; ++i)
+        handles.push_back(chunked.create(i));
+    EXPECT_EQ(chunked.capacity(), capacity);
+    std::vector<bool> seen(capacity, false);
+    for (auto h : handles)
+    {
+        ASSERT_LT(h.idx, capacity);
+        EXPECT_FALSE(seen[h.idx]);
+        seen[h.idx] = true;
+    }
+}
+
+// Threads hammering create / get / destroy: locked (Relocate) vs lock-free (Chunked).
+// A reference from get() on a Relocate pool is only valid while the pool does not
+// grow, so both pools are sized up front for the at most 64 live handles per thread.
+TEST(PoolAllocatorTFHBenchmark, DISABLED_MultithreadedStress)
+{
+    struct Payload { size_t values[4]; };
+    constexpr size_t PerThread = 1 << 15;
+    const int thread_counts[] = { 1, 2, 4, 8 };
+
+    auto run = [&](PoolGrowth growth, int thread_count)
+        {
+            PoolAllocatorTFH<Payload> pool(thread_count * 64, growth, 1024);
+            const size_t capacity = pool.capacity();
+            std::atomic<size_t> checksum{ 0 };
+            const auto t0 = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads;
+            for (int t = 0; t < thread_count; ++t)
+                threads.emplace_back([&]()
+                    {
+                        std::vector<Handle<Payload>> handles;
+                        handles.reserve(64);
+                        size_t sum = 0;
+                        for (size_t i = 0; i < PerThread; ++i)
+                        {
+                            handles.push_back(pool.create(Payload{ { i } }));
+                            sum += pool.get(handles[i % handles.size()]).values[0];
+                            if (handles.size() == 64)
+                            {
+                                for (auto h : handles) pool.destroy(h);
+                                handles.clear();
+                            }
+                        }
+                        for (auto h : handles) pool.destroy(h);
+                        checksum += sum;
+                    });
+            for (auto& thread : threads) thread.join();
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            EXPECT_EQ(pool.count_used(), 0u);
+            EXPECT_EQ(pool.capacity(), capacity); // Never grew while references were held
+            return ns / (double(PerThread) * thread_count);
+        };
+
+    std::cout << "[PoolAllocatorTFHBenchmark] ns per create+get+destroy, " << PerThread << " per thread, "
+        << std::thread::hardware_concurrency() << " hardware threads\n"
+        << std::fixed << std::setprecision(1);
+    for (int thread_count : thread_counts)
+    {
+        const double locked = run(PoolGrowth::Relocate, thread_count);
+        const double lock_free = run(PoolGrowth::Chunked, thread_count);
+        std::cout << "  " << thread_count << " threads: locked " << locked << ", lock-free " << lock_free << "\n";
+    }
+}
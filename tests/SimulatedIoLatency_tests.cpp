@@ -0,0 +1,92 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "SimulatedIoLatency.hpp"
+
+using namespace eeng;
+using namespace std::chrono_literals;
+
+TEST(SimulatedIoLatency, OffByDefault)
+{
+    SimulatedIoLatency io;
+    EXPECT_FALSE(io.enabled());
+    EXPECT_EQ(io.model_for("any").kind, IoLatencyModel::Kind::Off);
+    EXPECT_EQ(io.delay_for("any", 1'000'000), 0us);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    io.simulate("any", 1'000'000);
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, 50ms);
+}
+
+TEST(SimulatedIoLatency, Fixed)
+{
+    SimulatedIoLatency io;
+    io.set_default(IoLatencyModel::fixed(25.0f));
+    EXPECT_TRUE(io.enabled());
+    EXPECT_EQ(io.delay_for("a", 0), 25ms);
+    EXPECT_EQ(io.delay_for("b", 100'000'000), 25ms);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    io.simulate("a", 0);
+    EXPECT_GE(std::chrono::steady_clock::now() - t0, 25ms);
+}
+
+TEST(SimulatedIoLatency, JitteredStaysInRange)
+{
+    SimulatedIoLatency io;
+    io.set_default(IoLatencyModel::jittered(10.0f, 5.0f));
+
+    auto lo = std::chrono::microseconds::max(), hi = std::chrono::microseconds::min();
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto d = io.delay_for("a", 0);
+        lo = std::min(lo, d);
+        hi = std::max(hi, d);
+    }
+    EXPECT_GE(lo, 10ms);
+    EXPECT_LE(hi, 15ms);
+    EXPECT_LT(lo, hi);
+}
+
+TEST(SimulatedIoLatency, BandwidthScalesWithSize)
+{
+    SimulatedIoLatency io;
+    io.set_default(IoLatencyModel::bandwidth(100.0f, 2.0f)); // 100 MB/s
+
+    EXPECT_EQ(io.delay_for("a", 0), 2ms);
+    EXPECT_EQ(io.delay_for("a", 10'000'000), 102ms);
+    EXPECT_EQ(io.delay_for("a", 50'000), 2500us);
+}
+
+TEST(SimulatedIoLatency, PerTypeOverridesDefault)
+{
+    SimulatedIoLatency io;
+    io.set_for_type("eeng.Texture", IoLatencyModel::fixed(40.0f));
+    EXPECT_TRUE(io.enabled());
+    EXPECT_EQ(io.delay_for("eeng.Texture", 0), 40ms);
+    EXPECT_EQ(io.delay_for("eeng.Mesh", 0), 0us);
+
+    io.set_default(IoLatencyModel::fixed(5.0f));
+    EXPECT_EQ(io.delay_for("eeng.Texture", 0), 40ms);
+    EXPECT_EQ(io.delay_for("eeng.Mesh", 0), 5ms);
+
+    // An explicit Off model exempts a type from the default
+    io.set_for_type("eeng.Mesh", IoLatencyModel{});
+    EXPECT_EQ(io.delay_for("eeng.Mesh", 0), 0us);
+}
+
+TEST(SimulatedIoLatency, ClearTurnsOff)
+{
+    SimulatedIoLatency io;
+    io.set_default(IoLatencyModel::fixed(5.0f));
+    io.set_for_type("eeng.Texture", IoLatencyModel::fixed(40.0f));
+    io.clear();
+    EXPECT_FALSE(io.enabled());
+    EXPECT_EQ(io.delay_for("eeng.Texture", 0), 0us);
+
+    io.set_for_type("eeng.Texture", IoLatencyModel{});
+    EXPECT_FALSE(io.enabled());
+}
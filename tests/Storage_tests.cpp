@@ -4,10 +4,14 @@
 #include <gtest/gtest.h>
 #include <entt/meta/factory.hpp>
 #include <entt/meta/meta.hpp>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <vector>
 #include <thread>
 #include "Storage.hpp"
 #include "Guid.h"
+#include "AssetRef.hpp"
 
 struct MockResource1 {
     size_t x = 0;
@@ -50,6 +54,11 @@ void assure_storage(eeng::Storage& storage) {
     storage.assure_storage<T>();
 }
 
+// Heap bytes owned by a MockResource1, for Storage memory accounting
+size_t mock_memory_usage(const MockResource1& mr) {
+    return mr.data.capacity() * sizeof(int);
+}
+
 // Static registration of MockResource1 & MockResource2 with EnTT meta using meta_factory
 // static bool meta_registered = []() {
 //     entt::meta_factory<MockResource1>{}
@@ -70,7 +79,8 @@ protected:
     {
         entt::meta_factory<MockResource1>{}
         .type("MockResource1"_hs)
-            .template func<&assure_storage<MockResource1>>("assure_storage"_hs);
+            .template func<&assure_storage<MockResource1>>("assure_storage"_hs)
+            .template func<&mock_memory_usage>(eeng::literals::memory_usage_hs);
 
         entt::meta_factory<MockResource2>{}
         .type("MockResource2"_hs)
@@ -204,6 +214,26 @@ TEST_F(StorageTest, VersionInvalidAfterRemoval)
     EXPECT_FALSE(storage.validate(handle));
 }
 
+TEST_F(StorageTest, PackedHandleReusesSlotWithNewGeneration)
+{
+    static_assert(sizeof(eeng::Handle<MockResource1>) == 8);
+    static_assert(sizeof(eeng::AssetRef<MockResource1>) == 16);
+
+    auto first = storage.add(MockResource1{}, eeng::Guid::generate());
+    storage.release(first);
+    ASSERT_FALSE(storage.validate(first));
+
+    // Same slot, next generation: the stale handle stays invalid
+    auto second = storage.add(MockResource1{}, eeng::Guid::generate());
+    EXPECT_EQ(second.idx, first.idx);
+    EXPECT_EQ(second.ver, first.ver + 1);
+    EXPECT_TRUE(storage.validate(second));
+    EXPECT_FALSE(storage.validate(first));
+
+    EXPECT_EQ(eeng::Handle<MockResource1>::from_packed(second.packed()), second);
+    EXPECT_NE(second.packed(), first.packed());
+}
+
 TEST_F(StorageTest, MultiTypeStorage) {
     MockResource1 mr1; mr1.x = 100;
     entt::meta_any any1 = mr1;
@@ -390,6 +420,35 @@ TEST_F(StorageTest, ConcurrencySafety) {
 }
 #endif
 
+// get_ref takes no lock: it must stay safe while another thread adds objects of
+// the same type and the pool grows by chunks (run under TSan to check)
+TEST_F(StorageTest, GetRefWhileAdding) {
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < 16; ++i) {
+        MockResource1 mr; mr.x = i;
+        handles.push_back(storage.add(mr, eeng::Guid::generate()));
+    }
+
+    std::atomic<bool> done{ false };
+    std::thread adder([&] {
+        for (size_t i = 0; i < 4096; ++i) {
+            MockResource1 mr; mr.x = 1000 + i;
+            storage.add(mr, eeng::Guid::generate());
+        }
+        done = true;
+        });
+
+    size_t reads = 0, mismatches = 0;
+    while (!done.load() || reads < 10'000) {
+        const size_t i = reads++ % handles.size();
+        mismatches += storage.get_ref(handles[i]).x != i;
+    }
+    adder.join();
+
+    EXPECT_EQ(mismatches, 0u);
+    EXPECT_GE(storage.capacity(entt::resolve<MockResource1>().id()), 4096u + 16u);
+}
+
 TEST_F(StorageTest, HandleForGuid_Valid) {
     // Add a resource and lookup its handle by GUID
     MockResource1 mr; mr.x = 123;
@@ -430,6 +489,361 @@ TEST_F(StorageTest, GuidForHandle_Invalid) {
     EXPECT_FALSE(lookup.has_value());
 }
 
+TEST_F(StorageTest, CompactRemapsHandles) {
+    // Fill, remove the first half, then compact
+    std::vector<eeng::Guid> guids;
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < 20; ++i) {
+        MockResource1 mr; mr.x = i;
+        guids.push_back(eeng::Guid::generate());
+        handles.push_back(storage.add(mr, guids.back()));
+    }
+    for (size_t i = 0; i < 10; ++i)
+        storage.remove_now(handles[i]);
+    storage.retain(handles[19]);
+
+    auto remap = storage.compact<MockResource1>();
+    EXPECT_EQ(remap.size(), 10u);
+    for (const auto& [old_handle, new_handle] : remap) {
+        // Old handles forward to the moved object; GUIDs, values and ref-counts follow the move
+        EXPECT_TRUE(storage.validate(old_handle));
+        ASSERT_TRUE(storage.validate(new_handle));
+        EXPECT_LT(new_handle.idx, 10u);
+        const auto x = storage.get_val(new_handle).x;
+        EXPECT_EQ(storage.get_val(old_handle).x, x);
+        EXPECT_EQ(old_handle.idx, handles[x].idx);
+        EXPECT_EQ(storage.handle_for_guid<MockResource1>(guids[x]), new_handle);
+    }
+    const auto moved19 = *storage.handle_for_guid<MockResource1>(guids[19]);
+    EXPECT_EQ(storage.release(moved19), 1u);
+
+    // Runtime-typed: every pool, nothing left to move
+    EXPECT_TRUE(storage.compact().empty());
+}
+
+TEST_F(StorageTest, CompactKeepsAssetRefsResolving) {
+    std::vector<eeng::Guid> guids;
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < 8; ++i) {
+        MockResource1 mr; mr.x = i;
+        guids.push_back(eeng::Guid::generate());
+        handles.push_back(storage.add(mr, guids.back()));
+    }
+
+    // Bound before any compaction, to objects in the upper half
+    eeng::AssetRef<MockResource1> ref6{ guids[6], handles[6] };
+    eeng::AssetRef<MockResource1> ref7{ guids[7], handles[7] };
+
+    for (size_t i = 0; i < 4; ++i)
+        storage.remove_now(handles[i]);
+    ASSERT_EQ(storage.compact<MockResource1>().size(), 4u);
+    ASSERT_NE(storage.handle_for_guid<MockResource1>(ref6.guid), ref6.handle);
+    EXPECT_EQ(storage.get_ref(ref6.handle).x, 6u);
+    EXPECT_EQ(storage.get_ref(ref7.handle).x, 7u);
+
+    // A second compaction moves ref6's object again: the forward follows it
+    storage.remove_now(*storage.handle_for_guid<MockResource1>(guids[4]));
+    storage.remove_now(*storage.handle_for_guid<MockResource1>(guids[5]));
+    storage.compact<MockResource1>();
+    EXPECT_TRUE(storage.validate(ref6.handle));
+    EXPECT_EQ(storage.get_ref(ref6.handle).x, 6u);
+    EXPECT_EQ(storage.get_ref(ref7.handle).x, 7u);
+
+    // Removing the moved object invalidates the old handle too, also once its slot is reused
+    storage.remove_now(ref7.handle);
+    EXPECT_FALSE(storage.validate(ref7.handle));
+    storage.add(MockResource1{}, eeng::Guid::generate());
+    EXPECT_FALSE(storage.validate(ref7.handle));
+    EXPECT_EQ(storage.get_ref(ref6.handle).x, 6u);
+
+    storage.clear();
+    EXPECT_FALSE(storage.validate(ref6.handle));
+}
+
+TEST_F(StorageTest, MemoryUsageAndBudget) {
+    std::vector<eeng::MemoryBudgetExceededEvent> events;
+    storage.set_memory_budget_listener([&](const eeng::MemoryBudgetExceededEvent& e) {
+        events.push_back(e);
+        });
+
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < 10; ++i)
+        handles.push_back(storage.add(MockResource1{}, eeng::Guid::generate()));
+
+    // Inline bytes cover every slot, heap bytes come from the meta hook
+    auto usage = storage.memory_usage<MockResource1>();
+    EXPECT_EQ(usage.count, 10u);
+    EXPECT_EQ(usage.inline_bytes, storage.capacity(usage.type_id) * sizeof(MockResource1));
+    const size_t heap_per_object = MockResource1{}.data.capacity() * sizeof(int);
+    EXPECT_EQ(usage.heap_bytes, 10 * heap_per_object);
+    EXPECT_EQ(usage.peak_bytes, usage.total_bytes());
+    EXPECT_EQ(usage.budget_bytes, 0u);
+
+    // Growth through modify() is measured
+    storage.modify(handles[0], [](MockResource1& mr) { mr.data.resize(1000); });
+    usage = storage.memory_usage<MockResource1>();
+    EXPECT_GE(usage.heap_bytes, 9 * heap_per_object + 1000 * sizeof(int));
+
+    // Going over the budget raises one event per crossing
+    storage.set_memory_budget<MockResource1>(usage.total_bytes() + 1);
+    EXPECT_TRUE(events.empty());
+    storage.modify(handles[1], [](MockResource1& mr) { mr.data.resize(1000); });
+    storage.modify(handles[2], [](MockResource1& mr) { mr.data.resize(1000); });
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type_id, usage.type_id);
+    EXPECT_GT(events[0].total_bytes, events[0].budget_bytes);
+    EXPECT_EQ(storage.memory_usage<MockResource1>().budget_bytes, usage.total_bytes() + 1);
+
+    // Back under the budget re-arms it; the peak is kept
+    for (auto& h : handles)
+        storage.remove_now(h);
+    usage = storage.memory_usage<MockResource1>();
+    EXPECT_EQ(usage.count, 0u);
+    EXPECT_EQ(usage.heap_bytes, 0u);
+    EXPECT_GT(usage.peak_bytes, usage.total_bytes());
+    auto h = storage.add(MockResource1{}, eeng::Guid::generate());
+    storage.modify(h, [](MockResource1& mr) { mr.data.resize(10000); });
+    EXPECT_EQ(events.size(), 2u);
+
+    // Changes made through get_ref() are seen after a refresh
+    storage.set_memory_budget<MockResource1>(0);
+    storage.get_ref(h).data.clear();
+    storage.get_ref(h).data.shrink_to_fit();
+    storage.refresh_memory_usage();
+    EXPECT_EQ(storage.memory_usage<MockResource1>().heap_bytes, 0u);
+}
+
+TEST_F(StorageTest, BudgetListenerMayQueryStorage) {
+    // Called with no storage lock held: querying the storage from it must not deadlock
+    std::vector<eeng::PoolMemoryUsage> seen;
+    storage.set_memory_budget_listener([&](const eeng::MemoryBudgetExceededEvent& e) {
+        seen.push_back(storage.memory_usage(e.type_id));
+        });
+
+    storage.add(MockResource1{}, eeng::Guid::generate());
+    storage.set_memory_budget<MockResource1>(1);
+    ASSERT_EQ(seen.size(), 1u);
+    EXPECT_EQ(seen[0].count, 1u);
+    EXPECT_EQ(seen[0].budget_bytes, 1u);
+}
+
+TEST_F(StorageTest, ReadManyAndReadSession) {
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < 8; ++i) {
+        MockResource1 mr; mr.x = i;
+        handles.push_back(storage.add(mr, eeng::Guid::generate()));
+    }
+    MockResource2 mr2; mr2.y = 99;
+    auto h2 = storage.add(mr2, eeng::Guid::generate());
+    storage.remove_now(handles[3]);
+
+    // read_many skips the stale handle
+    std::vector<size_t> seen;
+    const size_t visited = storage.read_many(std::span<const eeng::Handle<MockResource1>>(handles),
+        [&](size_t i, const MockResource1& mr) {
+            EXPECT_EQ(mr.x, i);
+            seen.push_back(i);
+        });
+    EXPECT_EQ(visited, 7u);
+    EXPECT_EQ(seen, (std::vector<size_t>{ 0, 1, 2, 4, 5, 6, 7 }));
+
+    std::atomic<bool> modified{ false };
+    std::thread writer;
+    {
+        auto session = storage.read_session<MockResource1, MockResource2>();
+        const MockResource1* first = session.get(handles[0]);
+        ASSERT_NE(first, nullptr);
+        EXPECT_EQ(first->x, 0u);
+        EXPECT_EQ(session.get(handles[3]), nullptr);
+        EXPECT_EQ(session.get(eeng::Handle<MockResource1>{}), nullptr);
+        ASSERT_TRUE(session.valid(h2));
+        EXPECT_EQ(session.get(h2)->y, 99u);
+
+        // Other threads may read, writers wait for the session to end
+        writer = std::thread([&] {
+            EXPECT_EQ(storage.read(handles[1], [](const MockResource1& mr) { return mr.x; }), 1u);
+            storage.modify(handles[1], [](MockResource1& mr) { mr.x = 100; });
+            modified = true;
+            });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_FALSE(modified);
+        EXPECT_EQ(session.get(handles[1])->x, 1u);
+        EXPECT_EQ(session.get(handles[0]), first); // Stable
+
+        auto moved = std::move(session); // Locks move along
+        EXPECT_EQ(moved.get(handles[0]), first);
+        EXPECT_FALSE(modified);
+    }
+    writer.join();
+    EXPECT_TRUE(modified);
+    EXPECT_EQ(storage.read(handles[1], [](const MockResource1& mr) { return mr.x; }), 100u);
+
+    // Types without a pool yield nullptr
+    eeng::Storage empty;
+    EXPECT_EQ(empty.read_session<MockResource1>().get(handles[0]), nullptr);
+    EXPECT_EQ(empty.read_many(std::span<const eeng::Handle<MockResource1>>(handles), [](size_t, const MockResource1&) {}), 0u);
+}
+
+TEST_F(StorageTest, PoolLockReentryAsserts) {
+    auto h1 = storage.add(MockResource1{}, eeng::Guid::generate());
+    auto h2 = storage.add(MockResource2{}, eeng::Guid::generate());
+
+    // Other types may be read from inside read()
+    EXPECT_EQ(storage.read(h1, [&](const MockResource1&) {
+        return storage.read(h2, [](const MockResource2& mr) { return mr.y; });
+        }), MockResource2{}.y);
+
+#ifndef NDEBUG
+    // The pool lock is not recursive, also not for reads
+    ASSERT_DEATH(storage.read(h1, [&](const MockResource1&) {
+        storage.read(h1, [](const MockResource1&) {});
+        }), "");
+    ASSERT_DEATH({
+        auto session = storage.read_session<MockResource1>();
+        storage.read(h1, [](const MockResource1&) {});
+        }, "");
+#endif
+}
+
+class StorageBenchmark : public StorageTest {};
+
+// Readers of one pool share its lock: throughput should grow with threads
+// (up to the core count) while a writer modifies objects now and then
+TEST_F(StorageBenchmark, DISABLED_ReaderScaling) {
+    constexpr size_t Objects = 1024;
+    constexpr size_t ReadsPerThread = 200000;
+
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < Objects; ++i) {
+        MockResource1 mr; mr.x = i;
+        handles.push_back(storage.add(mr, eeng::Guid::generate()));
+    }
+
+    std::cout << "[StorageBenchmark] concurrent read() of " << Objects
+        << " objects, one writer (" << std::thread::hardware_concurrency() << " cores)\n";
+    for (size_t thread_count : { 1u, 2u, 4u, 8u })
+    {
+        std::atomic<bool> done{ false };
+        std::thread writer([&] {
+            for (size_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+                storage.modify(handles[i % Objects], [](MockResource1& mr) { mr.data[0] += 1; });
+                std::this_thread::yield();
+            }
+            });
+
+        std::vector<size_t> sums(thread_count, 0);
+        std::vector<std::thread> readers;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < thread_count; ++t) {
+            readers.emplace_back([&, t] {
+                size_t sum = 0;
+                for (size_t i = 0; i < ReadsPerThread; ++i)
+                    sum += storage.read(handles[(i * 7 + t) % Objects], [](const MockResource1& mr) { return mr.x; });
+                sums[t] = sum;
+                });
+        }
+        for (auto& r : readers) r.join();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        done = true;
+        writer.join();
+
+        for (size_t sum : sums) EXPECT_GT(sum, 0u);
+        std::cout << "  " << thread_count << " reader(s): " << std::fixed << std::setprecision(2)
+            << (thread_count * ReadsPerThread) / seconds / 1e6 << " M reads/s\n";
+    }
+}
+
+// A frame-like pass over many handles: one read() per object vs one
+// read_many() call vs lookups through a read session
+TEST_F(StorageBenchmark, DISABLED_BatchedReads) {
+    constexpr size_t Objects = 4096;
+    constexpr int Passes = 200;
+
+    std::vector<eeng::Handle<MockResource1>> handles;
+    for (size_t i = 0; i < Objects; ++i) {
+        MockResource1 mr; mr.x = i;
+        handles.push_back(storage.add(mr, eeng::Guid::generate()));
+    }
+    const size_t expected = Passes * (Objects * (Objects - 1) / 2);
+
+    auto time_ns = [&](auto&& pass) {
+        size_t sum = 0;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int p = 0; p < Passes; ++p)
+            sum += pass();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        EXPECT_EQ(sum, expected);
+        return ns / (double(Passes) * Objects);
+        };
+
+    const double per_read = time_ns([&] {
+        size_t sum = 0;
+        for (const auto& h : handles)
+            sum += storage.read(h, [](const MockResource1& mr) { return mr.x; });
+        return sum;
+        });
+    const double many = time_ns([&] {
+        size_t sum = 0;
+        storage.read_many(std::span<const eeng::Handle<MockResource1>>(handles),
+            [&](size_t, const MockResource1& mr) { sum += mr.x; });
+        return sum;
+        });
+    const double session = time_ns([&] {
+        size_t sum = 0;
+        auto s = storage.read_session<MockResource1>();
+        for (const auto& h : handles)
+            sum += s.get(h)->x;
+        return sum;
+        });
+
+    std::cout << "[StorageBenchmark] ns per object, " << Objects << " objects per pass\n"
+        << std::fixed << std::setprecision(1)
+        << "  read() each   : " << per_read << "\n"
+        << "  read_many()   : " << many << "\n"
+        << "  read session  : " << session << "\n";
+}
+
+// GUID <-> handle lookups at 1M objects
+TEST_F(StorageBenchmark, DISABLED_GuidLookups1M) {
+    constexpr size_t N = 1'000'000;
+
+    std::vector<eeng::Guid> guids(N);
+    for (auto& g : guids) g = eeng::Guid::generate();
+    std::vector<eeng::Handle<MockResource1>> handles;
+    handles.reserve(N);
+
+    auto ms_since = [](auto t0) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        };
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto& g : guids)
+        handles.push_back(storage.add(MockResource1{}, g));
+    const double add_ms = ms_since(t0);
+
+    std::vector<size_t> order(N);
+    for (size_t i = 0; i < N; ++i) order[i] = (i * 7919) % N; // Scattered
+    size_t found = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i : order)
+        found += storage.handle_for_guid<MockResource1>(guids[i]) == handles[i];
+    const double guid_to_handle_ms = ms_since(t0);
+    EXPECT_EQ(found, N);
+
+    found = 0;
+    t0 = std::chrono::steady_clock::now();
+    for (size_t i : order)
+        found += storage.guid_for_handle(handles[i]) == guids[i];
+    const double handle_to_guid_ms = ms_since(t0);
+    EXPECT_EQ(found, N);
+
+    std::cout << "[StorageBenchmark] " << N << " objects, ms\n"
+        << std::fixed << std::setprecision(1)
+        << "  add            : " << add_ms << "\n"
+        << "  GUID -> handle : " << guid_to_handle_ms << "\n"
+        << "  handle -> GUID : " << handle_to_guid_ms << "\n";
+}
+
 // Not needed since we link with gtest_main 
 // int main(int argc, char **argv) {
 //     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,104 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "ThreadPool.hpp"
+#include "TaskGraph.hpp"
+
+TEST(TaskGraph, EmptyGraphIsReady)
+{
+    ThreadPool pool(2);
+    TaskGraph graph;
+    auto f = graph.run(pool);
+    EXPECT_EQ(f.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+}
+
+TEST(TaskGraph, RunsInDependencyOrder)
+{
+    ThreadPool pool(4);
+    TaskGraph graph;
+
+    std::mutex m;
+    std::vector<char> order;
+    auto record = [&](char c) { std::lock_guard lk(m); order.push_back(c); };
+
+    // a -> {b, c} -> d
+    auto a = graph.emplace([&] { record('a'); });
+    auto b = graph.emplace([&] { record('b'); });
+    auto c = graph.emplace([&] { record('c'); });
+    auto d = graph.emplace([&] { record('d'); });
+    a.precede(b, c);
+    d.succeed(b, c);
+
+    for (int run = 0; run < 50; ++run)
+    {
+        order.clear();
+        graph.run(pool).get();
+
+        ASSERT_EQ(order.size(), 4u);
+        EXPECT_EQ(order.front(), 'a');
+        EXPECT_EQ(order.back(), 'd');
+    }
+}
+
+TEST(TaskGraph, WideFanInCompletes)
+{
+    ThreadPool pool(4);
+    TaskGraph graph;
+
+    std::atomic<int> sum{ 0 };
+    int seen_by_sink = 0;
+    auto sink = graph.emplace([&] { seen_by_sink = sum.load(); });
+    for (int i = 1; i <= 1000; ++i)
+        graph.emplace([&, i] { sum.fetch_add(i); }).precede(sink);
+
+    graph.run(pool).get();
+    EXPECT_EQ(seen_by_sink, 500500);
+}
+
+TEST(TaskGraph, CycleThrows)
+{
+    ThreadPool pool(1);
+    TaskGraph graph;
+    auto a = graph.emplace([] {});
+    auto b = graph.emplace([] {});
+    a.precede(b);
+    b.precede(a);
+    EXPECT_THROW(graph.run(pool), std::logic_error);
+}
+
+TEST(TaskGraph, ExceptionSkipsSuccessors)
+{
+    ThreadPool pool(2);
+    TaskGraph graph;
+    bool ran_after = false;
+    auto a = graph.emplace([] { throw std::runtime_error("boom"); });
+    auto b = graph.emplace([&] { ran_after = true; });
+    a.precede(b);
+
+    auto f = graph.run(pool);
+    EXPECT_THROW(f.get(), std::runtime_error);
+    EXPECT_FALSE(ran_after);
+}
+
+TEST(TaskGraph, RunFromWorkerWithGet)
+{
+    // Single worker: waiting on the graph from inside the pool must help
+    ThreadPool pool(1);
+    std::atomic<int> count{ 0 };
+    auto f = pool.queue_task([&]()
+        {
+            TaskGraph graph;
+            auto a = graph.emplace([&] { count++; });
+            auto b = graph.emplace([&] { count++; });
+            auto c = graph.emplace([&] { count++; });
+            a.precede(b, c);
+            pool.get(graph.run(pool));
+            return count.load();
+        });
+    EXPECT_EQ(f.get(), 3);
+}
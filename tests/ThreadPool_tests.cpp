@@ -0,0 +1,638 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iomanip>
+
+#if defined(__linux__)
+#include <pthread.h>
+#endif
+
+#include "ThreadPool.hpp"
+#include "SerialExecutor.hpp"
+
+namespace {
+
+    // The previous single-queue pool (one mutex + condvar), kept as a baseline
+    // for the contention benchmark below.
+    class MutexQueuePool
+    {
+    public:
+        explicit MutexQueuePool(size_t thread_count)
+        {
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                workers.emplace_back([this]()
+                    {
+                        while (true)
+                        {
+                            std::function<void()> task;
+                            {
+                                std::unique_lock<std::mutex> lock(queue_mutex);
+                                cv.wait(lock, [this]() { return !task_queue.empty() || stop; });
+                                if (stop && task_queue.empty()) return;
+                                task = std::move(task_queue.front());
+                                task_queue.pop();
+                            }
+                            task();
+                        }
+                    });
+            }
+        }
+
+        ~MutexQueuePool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                stop = true;
+            }
+            cv.notify_all();
+            for (auto& w : workers) w.join();
+        }
+
+        void post(std::function<void()> fn)
+        {
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                task_queue.emplace(std::move(fn));
+            }
+            cv.notify_one();
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::condition_variable cv;
+        std::queue<std::function<void()>> task_queue;
+        std::mutex queue_mutex;
+        bool stop = false;
+    };
+
+    // Counts down and wakes a waiter when reaching zero
+    struct Latch
+    {
+        std::atomic<size_t> remaining;
+        std::mutex m;
+        std::condition_variable cv;
+        bool released = false; // Set under m, so the waiter cannot return (and destroy us) mid-notify
+
+        explicit Latch(size_t n) : remaining(n) {}
+
+        void count_down()
+        {
+            if (remaining.fetch_sub(1) == 1)
+            {
+                std::lock_guard lk(m);
+                released = true;
+                cv.notify_all();
+            }
+        }
+
+        void wait()
+        {
+            std::unique_lock lk(m);
+            cv.wait(lk, [&] { return released; });
+        }
+    };
+
+    // Small amount of work per task, so scheduling overhead dominates
+    void spin_work(std::atomic<uint64_t>& sink)
+    {
+        uint64_t x = 0;
+        for (int i = 0; i < 64; ++i) x += static_cast<uint64_t>(i) * 2654435761u;
+        sink.fetch_add(x & 1, std::memory_order_relaxed);
+    }
+
+    // Fan-out: a few root tasks each post many small child tasks from inside the pool
+    template<class Pool>
+    double run_fanout(Pool& pool, size_t roots, size_t children_per_root)
+    {
+        std::atomic<uint64_t> sink{ 0 };
+        Latch latch(roots * children_per_root);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < roots; ++r)
+        {
+            pool.post([&pool, &latch, &sink, children_per_root]()
+                {
+                    for (size_t c = 0; c < children_per_root; ++c)
+                    {
+                        pool.post([&latch, &sink]()
+                            {
+                                spin_work(sink);
+                                latch.count_down();
+                            });
+                    }
+                });
+        }
+        latch.wait();
+        const auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+}
+
+TEST(ThreadPool, QueueTaskReturnsValue)
+{
+    ThreadPool pool(4);
+    auto f = pool.queue_task([]() { return 42; });
+    EXPECT_EQ(f.get(), 42);
+}
+
+TEST(ThreadPool, QueueTaskPropagatesException)
+{
+    ThreadPool pool(2);
+    auto f = pool.queue_task([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, PostRunsAllTasks)
+{
+    constexpr size_t N = 10000;
+    std::atomic<size_t> count{ 0 };
+    {
+        ThreadPool pool(4);
+        for (size_t i = 0; i < N; ++i)
+            pool.post([&]() { count.fetch_add(1); });
+    } // Destructor drains the queues
+    EXPECT_EQ(count.load(), N);
+}
+
+TEST(ThreadPool, NestedFanOutFromWorkers)
+{
+    constexpr size_t Roots = 16;
+    constexpr size_t Children = 500;
+    std::atomic<size_t> count{ 0 };
+    {
+        ThreadPool pool(4);
+        for (size_t r = 0; r < Roots; ++r)
+        {
+            pool.post([&]()
+                {
+                    for (size_t c = 0; c < Children; ++c)
+                        pool.post([&]() { count.fetch_add(1); });
+                });
+        }
+    }
+    EXPECT_EQ(count.load(), Roots * Children);
+}
+
+TEST(ThreadPool, SingleThreadRunsNestedTasks)
+{
+    ThreadPool pool(1);
+    std::atomic<int> count{ 0 };
+    auto f = pool.queue_task([&]()
+        {
+            for (int i = 0; i < 100; ++i)
+                pool.post([&]() { count.fetch_add(1); });
+        });
+    f.get();
+
+    while (!pool.is_task_queue_empty() || pool.nbr_working_threads() > 0)
+        std::this_thread::yield();
+    EXPECT_EQ(count.load(), 100);
+}
+
+TEST(ThreadPool, QueueSizeDrainsToZero)
+{
+    ThreadPool pool(2);
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 1000; ++i)
+        futures.push_back(pool.queue_task([]() {}));
+    for (auto& f : futures) f.get();
+
+    EXPECT_TRUE(pool.is_task_queue_empty());
+    EXPECT_EQ(pool.task_queue_size(), 0u);
+}
+
+TEST(ThreadPool, GetFromWorkerRunsSubTasks)
+{
+    // With a single worker, blocking on the sub-task's future would deadlock
+    ThreadPool pool(1);
+    auto f = pool.queue_task([&]()
+        {
+            auto sub = pool.queue_task([]() { return 21; });
+            return pool.get(sub) * 2;
+        });
+    EXPECT_EQ(f.get(), 42);
+}
+
+TEST(ThreadPool, GetFromWorkerRunsNestedSubTasks)
+{
+    ThreadPool pool(2);
+    std::function<int(int)> fib = [&](int n) -> int
+        {
+            if (n < 2) return n;
+            auto a = pool.queue_task([&, n]() { return fib(n - 1); });
+            auto b = pool.queue_task([&, n]() { return fib(n - 2); });
+            return pool.get(a) + pool.get(b);
+        };
+    auto f = pool.queue_task([&]() { return fib(12); });
+    EXPECT_EQ(pool.get(f), 144);
+}
+
+TEST(ThreadPool, GetFromWorkerDrainsStrands)
+{
+    // Mirrors BatchRegistry -> ResourceManager: a strand task waits on
+    // another strand, both running on a single-worker pool
+    ThreadPool pool(1);
+    eeng::SerialExecutor outer(pool);
+    eeng::SerialExecutor inner(pool);
+
+    auto f = outer.submit([&]()
+        {
+            auto a = inner.submit([]() { return 1; });
+            auto b = inner.submit([]() { return 2; });
+            return pool.get(a) + pool.get(b);
+        });
+    EXPECT_EQ(pool.get(f), 3);
+
+    outer.wait_idle();
+    inner.wait_idle();
+}
+
+TEST(ThreadPool, GetPropagatesException)
+{
+    ThreadPool pool(1);
+    auto f = pool.queue_task([&]()
+        {
+            auto sub = pool.queue_task([]() -> int { throw std::runtime_error("boom"); });
+            return pool.get(sub);
+        });
+    EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, ParallelForVisitsEachIndexOnce)
+{
+    ThreadPool pool(4);
+    for (size_t n : { 0u, 1u, 7u, 1000u, 100000u })
+    {
+        std::vector<std::atomic<int>> hits(n);
+        pool.parallel_for(size_t{ 0 }, n, 0, [&](size_t i) { hits[i].fetch_add(1); });
+        for (size_t i = 0; i < n; ++i)
+            ASSERT_EQ(hits[i].load(), 1) << "n=" << n << " i=" << i;
+    }
+}
+
+TEST(ThreadPool, ParallelForRangeBodyAndGrain)
+{
+    ThreadPool pool(4);
+    constexpr int N = 10000;
+    constexpr size_t Grain = 64;
+    std::atomic<int> sum{ 0 };
+    std::atomic<bool> small_chunk{ false };
+    pool.parallel_for(-N, N, Grain, [&](int first, int last)
+        {
+            if (last - first < static_cast<int>(Grain) && last != N) small_chunk = true;
+            int s = 0;
+            for (int i = first; i < last; ++i) s += i;
+            sum.fetch_add(s);
+        });
+    EXPECT_EQ(sum.load(), -N);
+    EXPECT_FALSE(small_chunk.load());
+}
+
+TEST(ThreadPool, ParallelForRethrows)
+{
+    ThreadPool pool(4);
+    EXPECT_THROW(
+        pool.parallel_for(0, 10000, 1, [](int i) { if (i == 5000) throw std::runtime_error("boom"); }),
+        std::runtime_error);
+}
+
+TEST(ThreadPool, ParallelForNestedInWorker)
+{
+    ThreadPool pool(2);
+    std::atomic<int> count{ 0 };
+    auto f = pool.queue_task([&]()
+        {
+            pool.parallel_for(0, 64, 1, [&](int)
+                {
+                    pool.parallel_for(0, 64, 1, [&](int) { count.fetch_add(1); });
+                });
+        });
+    pool.get(f);
+    EXPECT_EQ(count.load(), 64 * 64);
+}
+
+TEST(ThreadPool, HigherLanesRunFirst)
+{
+    ThreadPool pool(1);
+
+    // Park the single worker so the lanes fill up
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+    pool.post([gate_future]() { gate_future.wait(); });
+    while (pool.nbr_working_threads() == 0)
+        std::this_thread::yield();
+
+    std::mutex m;
+    std::vector<TaskPriority> order;
+    auto record = [&](TaskPriority p) { return [&, p]() { std::lock_guard lk(m); order.push_back(p); }; };
+    pool.post(record(TaskPriority::Background), TaskPriority::Background);
+    pool.post(record(TaskPriority::Interactive), TaskPriority::Interactive);
+    pool.post(record(TaskPriority::FrameCritical), TaskPriority::FrameCritical);
+
+    EXPECT_EQ(pool.task_queue_size(TaskPriority::FrameCritical), 1u);
+    EXPECT_EQ(pool.task_queue_size(TaskPriority::Interactive), 1u);
+    EXPECT_EQ(pool.task_queue_size(TaskPriority::Background), 1u);
+
+    gate.set_value();
+    while (!pool.is_task_queue_empty() || pool.nbr_working_threads() > 0)
+        std::this_thread::yield();
+
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], TaskPriority::FrameCritical);
+    EXPECT_EQ(order[1], TaskPriority::Interactive);
+    EXPECT_EQ(order[2], TaskPriority::Background);
+}
+
+TEST(ThreadPool, BackgroundLaneIsNotStarved)
+{
+    ThreadPool pool(1);
+
+    // A steady stream of frame-critical work that re-posts itself
+    std::atomic<bool> done{ false };
+    std::atomic<size_t> critical_runs{ 0 };
+    std::function<void()> critical = [&]()
+        {
+            critical_runs.fetch_add(1);
+            if (!done.load())
+                pool.post(critical, TaskPriority::FrameCritical);
+        };
+    for (int i = 0; i < 4; ++i)
+        pool.post(critical, TaskPriority::FrameCritical);
+
+    auto background = pool.queue_task([&]() { done = true; }, TaskPriority::Background);
+    EXPECT_EQ(background.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    done = true;
+
+    while (!pool.is_task_queue_empty() || pool.nbr_working_threads() > 0)
+        std::this_thread::yield();
+    EXPECT_GT(critical_runs.load(), 0u);
+}
+
+TEST(ThreadPool, SerialExecutorDrainUsesItsPriority)
+{
+    ThreadPool pool(1);
+
+    std::promise<void> gate;
+    auto gate_future = gate.get_future().share();
+    pool.post([gate_future]() { gate_future.wait(); });
+    while (pool.nbr_working_threads() == 0)
+        std::this_thread::yield();
+
+    eeng::SerialExecutor background_strand(pool, TaskPriority::Background);
+    eeng::SerialExecutor critical_strand(pool);
+    auto b = background_strand.submit([]() { return 1; });
+    auto c = critical_strand.submit([]() { return 2; }, TaskPriority::FrameCritical);
+
+    EXPECT_EQ(pool.task_queue_size(TaskPriority::Background), 1u);
+    EXPECT_EQ(pool.task_queue_size(TaskPriority::FrameCritical), 1u);
+
+    gate.set_value();
+    EXPECT_EQ(b.get() + c.get(), 3);
+    background_strand.wait_idle();
+    critical_strand.wait_idle();
+}
+
+TEST(ThreadPool, ConfigNamesWorkersAndCountsWork)
+{
+    ThreadPoolConfig config;
+    config.thread_count = 3;
+    config.name = "tp-test";
+    config.numa_aware = true;
+    ThreadPool pool(config);
+
+    ASSERT_EQ(pool.nbr_threads(), 3u);
+    EXPECT_GE(pool.nbr_numa_nodes(), 1u);
+    for (size_t i = 0; i < pool.nbr_threads(); ++i)
+    {
+        EXPECT_EQ(pool.worker_name(i), "tp-test-" + std::to_string(i));
+        EXPECT_EQ(pool.worker_cpu(i), -1);
+        EXPECT_LT(pool.worker_numa_node(i), pool.nbr_numa_nodes());
+    }
+
+    size_t submitted = 0;
+#if defined(__linux__)
+    ++submitted;
+    auto name = pool.queue_task([]()
+        {
+            char buffer[16] = {};
+            pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+            return std::string(buffer);
+        });
+    EXPECT_EQ(name.get().rfind("tp-test-", 0), 0u);
+#endif
+
+    constexpr int N = 200;
+    std::atomic<int> counter{ 0 };
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < N; ++i)
+    {
+        ++submitted;
+        futures.push_back(pool.queue_task([&counter]()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                counter++;
+            }));
+    }
+    for (auto& f : futures) f.get();
+    EXPECT_EQ(counter.load(), N);
+
+    // Counters are bumped after the task body; wait for the last ones to land
+    while (pool.nbr_executed_tasks() < submitted)
+        std::this_thread::yield();
+
+    size_t sum = 0;
+    std::chrono::nanoseconds busy{ 0 };
+    for (size_t i = 0; i < pool.nbr_threads(); ++i)
+    {
+        sum += pool.nbr_executed_tasks(i);
+        busy += pool.busy_time(i);
+    }
+    EXPECT_EQ(sum, pool.nbr_executed_tasks());
+    // The last task per worker may not have added its busy time yet
+    EXPECT_GE(busy, std::chrono::microseconds(50) * (N - pool.nbr_threads()));
+}
+
+TEST(ThreadPool, PinnedWorkersRunTasks)
+{
+    ThreadPoolConfig config;
+    config.thread_count = 2;
+    config.pin_threads = true;
+    ThreadPool pool(config);
+
+    for (size_t i = 0; i < pool.nbr_threads(); ++i)
+        EXPECT_GE(pool.worker_cpu(i), 0);
+
+    auto f = pool.queue_task([]() { return 7; });
+    EXPECT_EQ(pool.get(f), 7);
+}
+
+TEST(ThreadPool, QueueBulkRunsEveryElement)
+{
+    ThreadPool pool(4);
+    std::vector<int> values(1000);
+    for (int i = 0; i < 1000; ++i) values[i] = i;
+
+    auto futures = pool.queue_bulk(values, [](int v) { return v * 2; });
+    ASSERT_EQ(futures.size(), values.size());
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(futures[i].get(), 2 * i);
+
+    // From a worker: tasks go to its own deque, and get() helps run them
+    auto nested = pool.queue_task([&pool]()
+        {
+            auto inner = pool.queue_bulk(std::vector<int>{ 1, 2, 3, 4 }, [](int v) { return v; });
+            int sum = 0;
+            for (auto& f : inner) sum += pool.get(f);
+            return sum;
+        });
+    EXPECT_EQ(pool.get(nested), 10);
+
+    auto none = pool.queue_bulk(std::vector<int>{}, [](int v) { return v; });
+    EXPECT_TRUE(none.empty());
+}
+
+TEST(ThreadPool, QueueBulkWakesSleepingWorkers)
+{
+    ThreadPool pool(4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Let the workers go to sleep
+
+    std::atomic<int> running{ 0 };
+    std::atomic<int> peak{ 0 };
+    auto futures = pool.queue_bulk(std::vector<int>(4), [&](int)
+        {
+            const int now = ++running;
+            int prev = peak.load();
+            while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            --running;
+        });
+    for (auto& f : futures) f.get();
+    EXPECT_GT(peak.load(), 1);
+}
+
+TEST(ThreadPool, SerialExecutorBulkKeepsOrder)
+{
+    ThreadPool pool(4);
+    eeng::SerialExecutor strand(pool);
+
+    std::vector<int> order;
+    std::vector<int> values{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    strand.post_bulk(values, [&order](int v) { order.push_back(v); });
+    auto futures = strand.submit_bulk(values, [&order](int v) { order.push_back(v + 8); return v; });
+
+    for (size_t i = 0; i < futures.size(); ++i)
+        EXPECT_EQ(futures[i].get(), int(i));
+    strand.wait_idle();
+
+    ASSERT_EQ(order.size(), 16u);
+    for (int i = 0; i < 16; ++i)
+        EXPECT_EQ(order[i], i);
+}
+
+// Contention benchmark: work-stealing pool vs the single mutex/condvar queue.
+// Prints timings only; no assertions on speed since results depend on the host.
+TEST(ThreadPoolBenchmark, DISABLED_ContentionWorkStealingVsMutexQueue)
+{
+    constexpr size_t Roots = 64;
+    constexpr size_t Children = 256;
+    const size_t thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+    std::cout << "[ThreadPoolBenchmark] fan-out " << Roots << "x" << Children << " tasks\n";
+    std::cout << "  threads | mutex-queue (ms) | work-stealing (ms)\n";
+    for (size_t n : thread_counts)
+    {
+        double ms_mutex = 0.0, ms_ws = 0.0;
+        {
+            MutexQueuePool pool(n);
+            ms_mutex = run_fanout(pool, Roots, Children);
+        }
+        {
+            ThreadPool pool(n);
+            ms_ws = run_fanout(pool, Roots, Children);
+        }
+        std::cout << "  " << std::setw(7) << n
+            << " | " << std::setw(16) << std::fixed << std::setprecision(2) << ms_mutex
+            << " | " << std::setw(18) << ms_ws << "\n";
+    }
+}
+
+// Per-task cost of fanning out 10k tasks from a non-worker thread, one at a
+// time vs in bulk. Prints timings only.
+TEST(ThreadPoolBenchmark, DISABLED_BulkSubmission)
+{
+    constexpr int N = 10000;
+    constexpr int Rounds = 5;
+    std::vector<int> items(N);
+    for (int i = 0; i < N; ++i) items[i] = i;
+
+    using Clock = std::chrono::steady_clock;
+    auto ns_per_task = [](Clock::duration d)
+        {
+            return std::chrono::duration<double, std::nano>(d).count() / (double(N) * Rounds);
+        };
+
+    ThreadPool pool(4);
+    eeng::SerialExecutor strand(pool);
+    std::atomic<int> counter{ 0 };
+
+    Clock::duration loop_enqueue{}, loop_total{}, bulk_enqueue{}, bulk_total{};
+    Clock::duration strand_loop{}, strand_bulk{};
+    for (int round = 0; round < Rounds; ++round)
+    {
+        // queue_task in a loop
+        {
+            const auto t0 = Clock::now();
+            std::vector<std::future<int>> futures;
+            futures.reserve(N);
+            for (int v : items)
+                futures.push_back(pool.queue_task([v]() { return v; }));
+            const auto t1 = Clock::now();
+            for (auto& f : futures) f.get();
+            loop_enqueue += t1 - t0;
+            loop_total += Clock::now() - t0;
+        }
+        // queue_bulk
+        {
+            const auto t0 = Clock::now();
+            auto futures = pool.queue_bulk(items, [](int v) { return v; });
+            const auto t1 = Clock::now();
+            for (auto& f : futures) f.get();
+            bulk_enqueue += t1 - t0;
+            bulk_total += Clock::now() - t0;
+        }
+        // SerialExecutor::post in a loop vs post_bulk
+        {
+            const auto t0 = Clock::now();
+            for (int v : items)
+                strand.post([&counter, v]() { counter += v & 1; });
+            strand.wait_idle();
+            strand_loop += Clock::now() - t0;
+        }
+        {
+            const auto t0 = Clock::now();
+            strand.post_bulk(items, [&counter](int v) { counter += v & 1; });
+            strand.wait_idle();
+            strand_bulk += Clock::now() - t0;
+        }
+    }
+
+    std::cout << "[ThreadPoolBenchmark] " << N << " tasks, ns per task (mean of " << Rounds << " rounds)\n";
+    std::cout << std::fixed << std::setprecision(1)
+        << "  queue_task loop : enqueue " << std::setw(7) << ns_per_task(loop_enqueue)
+        << " | total " << std::setw(7) << ns_per_task(loop_total) << "\n"
+        << "  queue_bulk      : enqueue " << std::setw(7) << ns_per_task(bulk_enqueue)
+        << " | total " << std::setw(7) << ns_per_task(bulk_total) << "\n"
+        << "  strand post loop: total " << std::setw(7) << ns_per_task(strand_loop) << "\n"
+        << "  strand post_bulk: total " << std::setw(7) << ns_per_task(strand_bulk) << "\n";
+    EXPECT_EQ(counter.load(), Rounds * N);
+}
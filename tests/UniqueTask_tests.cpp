@@ -0,0 +1,219 @@
+// Licensed under the MIT License. See LICENSE file for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "UniqueTask.hpp"
+#include "ThreadPool.hpp"
+#include "SerialExecutor.hpp"
+#include "MainThreadQueue.hpp"
+#include "AllocTracking.hpp"
+
+namespace {
+
+    // Allocations made by the calling thread while running fn
+    template <typename F>
+    size_t count_allocations(F&& fn)
+    {
+        const size_t before = alloc_tracking::allocations();
+        fn();
+        return alloc_tracking::allocations() - before;
+    }
+
+    // Spin until `counter` reaches `target`
+    void wait_for_count(const std::atomic<int>& counter, int target)
+    {
+        while (counter.load() < target)
+            std::this_thread::yield();
+    }
+
+    // Typical hot-path capture: a few pointers, too big for std::function's small buffer
+    struct Capture
+    {
+        std::atomic<int>* counter;
+        void* a;
+        void* b;
+    };
+
+} // namespace
+
+TEST(UniqueTask, SmallCallablesAreStoredInline)
+{
+    Capture c{};
+    auto small = [c]() { c.counter->fetch_add(1); };
+    struct Big { char bytes[UniqueTask::inline_size + 1]; void operator()() {} };
+
+    EXPECT_TRUE(UniqueTask::stores_inline<decltype(small)>());
+    EXPECT_TRUE(UniqueTask::stores_inline<std::packaged_task<int()>>());
+    EXPECT_TRUE(UniqueTask::stores_inline<std::function<void()>>());
+    EXPECT_FALSE(UniqueTask::stores_inline<Big>());
+
+    std::atomic<int> counter{ 0 };
+    Capture capture{ &counter, nullptr, nullptr };
+    size_t allocations = count_allocations([&]()
+        {
+            UniqueTask task([capture]() { capture.counter->fetch_add(1); });
+            UniqueTask moved = std::move(task);
+            moved();
+        });
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(UniqueTask, LargeCallablesGoToTheHeap)
+{
+    std::atomic<int> counter{ 0 };
+    struct Big
+    {
+        std::atomic<int>* counter;
+        char padding[UniqueTask::inline_size];
+        void operator()() { counter->fetch_add(1); }
+    };
+
+    size_t allocations = count_allocations([&]()
+        {
+            UniqueTask task(Big{ &counter, {} });
+            UniqueTask moved = std::move(task); // Moves the pointer, not the target
+            moved();
+        });
+    EXPECT_EQ(allocations, 1u);
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(UniqueTask, MoveOnlyCapturesAndDestruction)
+{
+    auto value = std::make_shared<int>(7);
+    std::weak_ptr<int> weak = value;
+    int seen = 0;
+    {
+        UniqueTask task([p = std::make_unique<int>(3), v = std::move(value), &seen]() { seen = *p + *v; });
+        UniqueTask other;
+        other = std::move(task);
+        EXPECT_FALSE(task);
+        EXPECT_TRUE(other);
+        other();
+        EXPECT_FALSE(weak.expired());
+    }
+    EXPECT_EQ(seen, 10);
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(UniqueTask, EmptyTargetsStayEmpty)
+{
+    UniqueTask empty;
+    EXPECT_FALSE(empty);
+    EXPECT_THROW(empty(), std::bad_function_call);
+
+    UniqueTask from_function{ std::function<void()>() };
+    EXPECT_FALSE(from_function);
+
+    void (*null_fn)() = nullptr;
+    UniqueTask from_pointer{ null_fn };
+    EXPECT_FALSE(from_pointer);
+
+    UniqueTask task([]() {});
+    task = nullptr;
+    EXPECT_FALSE(task);
+}
+
+TEST(UniqueTask, QueueTaskAcceptsMoveOnlyCallables)
+{
+    ThreadPool pool(2);
+    auto future = pool.queue_task([p = std::make_unique<int>(42)]() { return *p; });
+    EXPECT_EQ(pool.get(future), 42);
+}
+
+// Allocations per task on the producer side, after a warm-up round has sized
+// the node pools and rings. The baseline is the previous design: a
+// std::function in a mutex-guarded std::deque.
+TEST(UniqueTaskBenchmark, DISABLED_HotPathAllocations)
+{
+    constexpr int N = 1000;
+
+    std::atomic<int> counter{ 0 };
+    Capture capture{ &counter, nullptr, nullptr };
+    auto task = [capture]() { capture.counter->fetch_add(1); };
+
+    // Baseline
+    std::mutex mutex;
+    std::deque<std::function<void()>> baseline_queue;
+    auto baseline_round = [&]()
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                baseline_queue.push_back(task);
+            }
+            while (!baseline_queue.empty())
+            {
+                baseline_queue.front()();
+                baseline_queue.pop_front();
+            }
+        };
+    counter = 0;
+    baseline_round();
+    const size_t baseline = count_allocations([&]()
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                baseline_queue.push_back(task);
+            }
+        });
+    while (!baseline_queue.empty()) baseline_queue.pop_front();
+
+    // ThreadPool::post
+    ThreadPool pool(2);
+    auto pool_round = [&]()
+        {
+            counter = 0;
+            for (int i = 0; i < N; ++i) pool.post(task);
+            wait_for_count(counter, N);
+        };
+    pool_round();
+    const size_t pool_allocations = count_allocations(pool_round);
+
+    // SerialExecutor::post
+    eeng::SerialExecutor strand(pool);
+    auto strand_round = [&]()
+        {
+            counter = 0;
+            for (int i = 0; i < N; ++i) strand.post(task);
+            strand.wait_idle();
+        };
+    strand_round();
+    const size_t strand_allocations = count_allocations(strand_round);
+
+    // MainThreadQueue::push, run by this thread
+    MainThreadQueue mtq;
+    auto mtq_round = [&]()
+        {
+            counter = 0;
+            for (int i = 0; i < N; ++i) mtq.push(task);
+            mtq.execute_all();
+        };
+    mtq_round();
+    const size_t mtq_allocations = count_allocations(mtq_round);
+    EXPECT_EQ(counter.load(), N);
+
+    auto per_task = [](size_t allocations) { return double(allocations) / N; };
+    std::cout << "[UniqueTaskBenchmark] allocations per task, " << N << " tasks of "
+        << sizeof(Capture) << "-byte captures (steady state)\n";
+    std::cout << std::fixed << std::setprecision(3)
+        << "  std::function + deque : " << per_task(baseline) << "\n"
+        << "  ThreadPool::post      : " << per_task(pool_allocations) << "\n"
+        << "  SerialExecutor::post  : " << per_task(strand_allocations) << "\n"
+        << "  MainThreadQueue::push : " << per_task(mtq_allocations) << "\n";
+
+    EXPECT_EQ(pool_allocations, 0u);
+    EXPECT_EQ(strand_allocations, 0u);
+    EXPECT_EQ(mtq_allocations, 0u);
+}